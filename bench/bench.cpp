@@ -0,0 +1,464 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <getopt.h>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <aff3ct-core.hpp>
+using namespace aff3ct;
+
+// one benchmark result: the samples are the measured durations per operation (in nanoseconds), one per repetition
+struct Result
+{
+    std::string suite;
+    std::string name;
+    std::vector<std::pair<std::string, size_t>> params;
+    size_t n_ops;
+    std::vector<double> samples;
+    std::vector<std::vector<double>> latencies; // per-frame latency percentiles of each repetition (optional)
+};
+
+// percentiles of the per-frame latencies, they are the upper bounds of the power of 2 buckets of the histogram
+const std::vector<std::pair<std::string, float>> latency_percentiles = { { "p50", 50.f },
+                                                                         { "p99", 99.f },
+                                                                         { "p99.9", 99.9f },
+                                                                         { "max", 100.f } };
+
+// run 'fn' one time to warm up the caches, then 'n_reps' times and return the duration per operation of each run
+std::vector<double>
+measure(const size_t n_reps, const size_t n_ops, std::function<void()> fn)
+{
+    fn();
+    std::vector<double> samples;
+    for (size_t r = 0; r < n_reps; r++)
+    {
+        auto t_start = std::chrono::steady_clock::now();
+        fn();
+        std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+        samples.push_back((double)duration.count() / (double)n_ops);
+    }
+    return samples;
+}
+
+void
+write_json(std::ostream& stream, const std::vector<Result>& results, const size_t n_exec, const size_t n_reps)
+{
+    stream << "{" << std::endl;
+    stream << "  \"config\": {" << std::endl;
+    stream << "    \"n_exec\": " << n_exec << "," << std::endl;
+    stream << "    \"n_reps\": " << n_reps << "," << std::endl;
+    stream << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << "," << std::endl;
+#ifdef AFF3CT_CORE_FAST
+    stream << "    \"fast\": true" << std::endl;
+#else
+    stream << "    \"fast\": false" << std::endl;
+#endif
+    stream << "  }," << std::endl;
+    stream << "  \"results\": [" << std::endl;
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const auto& res = results[i];
+        auto sorted = res.samples;
+        std::sort(sorted.begin(), sorted.end());
+        const double mean = std::accumulate(sorted.begin(), sorted.end(), 0.) / (double)sorted.size();
+        const double median = sorted.size() % 2 ? sorted[sorted.size() / 2]
+                                                : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2.;
+
+        stream << "    {" << std::endl;
+        stream << "      \"suite\": \"" << res.suite << "\"," << std::endl;
+        stream << "      \"name\": \"" << res.name << "\"," << std::endl;
+        stream << "      \"params\": {";
+        for (size_t p = 0; p < res.params.size(); p++)
+            stream << (p ? ", " : " ") << "\"" << res.params[p].first << "\": " << res.params[p].second
+                   << (p == res.params.size() - 1 ? " " : "");
+        stream << "}," << std::endl;
+        stream << "      \"n_ops\": " << res.n_ops << "," << std::endl;
+        stream << "      \"ns_per_op\": { \"min\": " << sorted.front() << ", \"median\": " << median
+               << ", \"mean\": " << mean << ", \"max\": " << sorted.back() << " }," << std::endl;
+        stream << "      \"ops_per_sec\": " << (median > 0. ? 1e9 / median : 0.) << (res.latencies.empty() ? "" : ",")
+               << std::endl;
+        if (!res.latencies.empty())
+        {
+            // median of the repetitions for each percentile
+            stream << "      \"latency_ns\": {";
+            for (size_t p = 0; p < latency_percentiles.size(); p++)
+            {
+                std::vector<double> values;
+                for (auto& l : res.latencies)
+                    values.push_back(l[p]);
+                std::sort(values.begin(), values.end());
+                stream << (p ? ", " : " ") << "\"" << latency_percentiles[p].first
+                       << "\": " << values[values.size() / 2];
+            }
+            stream << " }" << std::endl;
+        }
+        stream << "    }" << (i == results.size() - 1 ? "" : ",") << std::endl;
+    }
+    stream << "  ]" << std::endl;
+    stream << "}" << std::endl;
+}
+
+// per-task dispatch overhead: a task with a trivial codelet is executed 'n_exec' times
+void
+bench_task(std::vector<Result>& results, const size_t n_exec, const size_t n_reps)
+{
+    for (auto data_length : { (size_t)1, (size_t)1024 })
+        for (auto stats : { false, true })
+        {
+            module::Incrementer<uint8_t> incr(data_length);
+            std::vector<uint8_t> in(data_length, 0);
+            incr[module::inc::sck::increment::in] = in;
+            auto& task = incr[module::inc::tsk::increment];
+            task.set_fast(true);
+            task.set_stats(stats);
+
+            results.push_back({ "task",
+                                "dispatch",
+                                { { "data_length", data_length }, { "stats", (size_t)stats } },
+                                n_exec,
+                                measure(n_reps,
+                                        n_exec,
+                                        [&task, n_exec]()
+                                        {
+                                            for (size_t e = 0; e < n_exec; e++)
+                                                task.exec();
+                                        }) });
+        }
+}
+
+// 'Socket' binding cost: socket to socket bind + unbind, and socket to user data (re)bind
+void
+bench_socket(std::vector<Result>& results, const size_t n_exec, const size_t n_reps)
+{
+    module::Relayer<uint8_t> rly1(1), rly2(1);
+    auto& sck_out = rly1[module::rly::sck::relay::out];
+    auto& sck_in = rly2[module::rly::sck::relay::in];
+    results.push_back({ "socket",
+                        "bind_unbind",
+                        {},
+                        n_exec,
+                        measure(n_reps,
+                                n_exec,
+                                [&sck_in, &sck_out, n_exec]()
+                                {
+                                    for (size_t e = 0; e < n_exec; e++)
+                                    {
+                                        sck_in = sck_out;
+                                        sck_in.unbind(sck_out);
+                                    }
+                                }) });
+
+    std::vector<uint8_t> data1(1), data2(1);
+    results.push_back({ "socket",
+                        "rebind_data",
+                        {},
+                        n_exec,
+                        measure(n_reps,
+                                n_exec,
+                                [&sck_in, &data1, &data2, n_exec]()
+                                {
+                                    for (size_t e = 0; e < n_exec; e++)
+                                        sck_in = (e & 1) ? data1 : data2;
+                                }) });
+}
+
+// execute a pipeline made of an initializer, 'n_stages - 2' incrementers and a finalizer (one per stage), the stage 0
+// stops after 'n_exec' frames, the per-frame latency percentiles are written in 'latency' if not null (the latency
+// tracking reads the clock on each push and pull, so the returned duration per frame is not representative then)
+double
+run_pipeline(const size_t n_stages,
+             const size_t data_length,
+             const size_t n_exec,
+             const size_t buffer_size,
+             const bool active_waiting,
+             std::vector<double>* latency = nullptr)
+{
+    module::Initializer<uint8_t> initializer(data_length);
+    module::Finalizer<uint8_t> finalizer(data_length);
+    std::vector<std::shared_ptr<module::Incrementer<uint8_t>>> incs(n_stages - 2);
+    for (auto& inc : incs)
+        inc.reset(new module::Incrementer<uint8_t>(data_length));
+
+    std::vector<runtime::Task*> tasks;
+    tasks.push_back(&initializer[module::ini::tsk::initialize]);
+    for (auto& inc : incs)
+        tasks.push_back(&(*inc)[module::inc::tsk::increment]);
+    tasks.push_back(&finalizer[module::fin::tsk::finalize]);
+    for (size_t t = 1; t < tasks.size(); t++)
+        (*tasks[t])[0] = (*tasks[t - 1])[tasks[t - 1]->sockets.size() - 2];
+
+    std::vector<std::pair<std::vector<runtime::Task*>, std::vector<runtime::Task*>>> sep_stages;
+    for (size_t t = 0; t < tasks.size(); t++)
+        sep_stages.push_back({ { tasks[t] }, { tasks[t] } });
+
+    runtime::Pipeline pipeline(*tasks.front(),
+                               sep_stages,
+                               std::vector<size_t>(n_stages, 1),
+                               std::vector<size_t>(n_stages - 1, buffer_size),
+                               std::vector<bool>(n_stages - 1, active_waiting));
+    for (auto& mod : pipeline.get_modules<module::Module>(false))
+        for (auto& tsk : mod->tasks)
+            tsk->set_fast(true);
+
+    size_t n_frames = 0;
+    std::vector<std::function<bool()>> stop_conditions(n_stages, []() { return false; });
+    stop_conditions[0] = [&n_frames, n_exec]() { return ++n_frames >= n_exec; };
+
+    pipeline.set_latency_tracking(latency != nullptr);
+
+    auto t_start = std::chrono::steady_clock::now();
+    pipeline.exec(stop_conditions);
+    std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+
+    if (latency != nullptr)
+    {
+        latency->clear();
+        for (auto& p : latency_percentiles)
+            latency->push_back((double)pipeline.get_latency().get_percentile(p.second).count());
+    }
+
+    pipeline.unbind_adaptors();
+    for (size_t t = 1; t < tasks.size(); t++)
+        (*tasks[t])[0].unbind((*tasks[t - 1])[tasks[t - 1]->sockets.size() - 2]);
+
+    return (double)duration.count() / (double)n_exec;
+}
+
+// adaptor push/pull cost per frame between two stages depending on the buffer size and on the waiting mode, the
+// per-frame latency from the push to the end of the pull stage is measured in separate runs
+void
+bench_adaptor(std::vector<Result>& results, const size_t n_exec, const size_t n_reps)
+{
+    std::vector<bool> waitings = { false };
+    if (std::thread::hardware_concurrency() > 1) waitings.push_back(true); // active waiting requires 2 cores at least
+    for (auto active_waiting : waitings)
+        for (auto buffer_size : { (size_t)1, (size_t)4, (size_t)16, (size_t)64 })
+        {
+            std::vector<double> samples;
+            for (size_t r = 0; r < n_reps; r++)
+                samples.push_back(run_pipeline(2, 1, n_exec, buffer_size, active_waiting));
+            std::vector<std::vector<double>> latencies(n_reps);
+            for (size_t r = 0; r < n_reps; r++)
+                run_pipeline(2, 1, n_exec, buffer_size, active_waiting, &latencies[r]);
+            results.push_back({ "adaptor",
+                                "push_pull",
+                                { { "buffer_size", buffer_size }, { "active_waiting", (size_t)active_waiting } },
+                                n_exec,
+                                samples,
+                                latencies });
+        }
+}
+
+// pipeline throughput depending on the number of stages (one thread per stage)
+void
+bench_pipeline(std::vector<Result>& results, const size_t n_exec, const size_t n_reps, const size_t max_stages)
+{
+    for (size_t n_stages = 2; n_stages <= max_stages; n_stages++)
+    {
+        std::vector<double> samples;
+        for (size_t r = 0; r < n_reps; r++)
+            samples.push_back(run_pipeline(n_stages, 1024, n_exec, 16, false));
+        results.push_back({ "pipeline", "stages", { { "n_stages", n_stages } }, n_exec, samples });
+    }
+}
+
+// sequence throughput depending on the number of threads
+void
+bench_sequence(std::vector<Result>& results, const size_t n_exec, const size_t n_reps, const size_t max_threads)
+{
+    const size_t data_length = 1024;
+    module::Initializer<uint8_t> initializer(data_length);
+    module::Incrementer<uint8_t> incr(data_length);
+    module::Finalizer<uint8_t> finalizer(data_length);
+    incr[module::inc::sck::increment::in] = initializer[module::ini::sck::initialize::out];
+    finalizer[module::fin::sck::finalize::in] = incr[module::inc::sck::increment::out];
+
+    for (size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2)
+    {
+        runtime::Sequence sequence(initializer[module::ini::tsk::initialize], n_threads);
+        for (auto& mod : sequence.get_modules<module::Module>(false))
+            for (auto& tsk : mod->tasks)
+                tsk->set_fast(true);
+
+        std::atomic<size_t> n_frames(0);
+        results.push_back({ "sequence",
+                            "threads",
+                            { { "n_threads", n_threads } },
+                            n_exec,
+                            measure(n_reps,
+                                    n_exec,
+                                    [&sequence, &n_frames, n_exec]()
+                                    {
+                                        n_frames = 0;
+                                        sequence.exec([&n_frames, n_exec]() { return ++n_frames >= n_exec; });
+                                    }) });
+    }
+}
+
+// cost of the reallocation of the sockets and of the re-generation of the processes when 'n_frames' changes
+void
+bench_n_frames(std::vector<Result>& results, const size_t n_exec, const size_t n_reps)
+{
+    const size_t data_length = 1024;
+    module::Initializer<uint8_t> initializer(data_length);
+    module::Incrementer<uint8_t> incr(data_length);
+    module::Finalizer<uint8_t> finalizer(data_length);
+    incr[module::inc::sck::increment::in] = initializer[module::ini::sck::initialize::out];
+    finalizer[module::fin::sck::finalize::in] = incr[module::inc::sck::increment::out];
+    runtime::Sequence sequence(initializer[module::ini::tsk::initialize]);
+
+    const size_t n_calls = std::max((size_t)1, n_exec / 100);
+    results.push_back({ "sequence",
+                        "set_n_frames",
+                        { { "n_frames", 8 } },
+                        n_calls,
+                        measure(n_reps,
+                                n_calls,
+                                [&sequence, n_calls]()
+                                {
+                                    for (size_t c = 0; c < n_calls; c++)
+                                        sequence.set_n_frames(c & 1 ? 1 : 8);
+                                }) });
+    sequence.set_n_frames(1);
+}
+
+int
+main(int argc, char** argv)
+{
+    option longopts[] = { { "n-exec", required_argument, NULL, 'e' },
+                          { "n-reps", required_argument, NULL, 'r' },
+                          { "max-threads", required_argument, NULL, 't' },
+                          { "max-stages", required_argument, NULL, 'n' },
+                          { "suites", required_argument, NULL, 's' },
+                          { "json-filepath", required_argument, NULL, 'o' },
+                          { "help", no_argument, NULL, 'h' },
+                          { 0 } };
+
+    size_t n_exec = 100000;
+    size_t n_reps = 5;
+    size_t max_threads = std::max((unsigned)1, std::thread::hardware_concurrency());
+    size_t max_stages = 4;
+    std::string suites = "task,socket,adaptor,sequence,pipeline,n_frames";
+    std::string json_filepath = "bench.json";
+
+    while (1)
+    {
+        const int opt = getopt_long(argc, argv, "e:r:t:n:s:o:h", longopts, 0);
+        if (opt == -1) break;
+        switch (opt)
+        {
+            case 'e':
+                n_exec = atoi(optarg);
+                break;
+            case 'r':
+                n_reps = atoi(optarg);
+                break;
+            case 't':
+                max_threads = atoi(optarg);
+                break;
+            case 'n':
+                max_stages = atoi(optarg);
+                break;
+            case 's':
+                suites = std::string(optarg);
+                break;
+            case 'o':
+                json_filepath = std::string(optarg);
+                break;
+            case 'h':
+                std::cout << "usage: " << argv[0] << " [options]" << std::endl;
+                std::cout << std::endl;
+                std::cout << "  -e, --n-exec          "
+                          << "Number of executions (or frames) per measure                          "
+                          << "[" << n_exec << "]" << std::endl;
+                std::cout << "  -r, --n-reps          "
+                          << "Number of repetitions of each measure (after one warm-up run)         "
+                          << "[" << n_reps << "]" << std::endl;
+                std::cout << "  -t, --max-threads     "
+                          << "Maximum number of threads in the sequence scaling suite               "
+                          << "[" << max_threads << "]" << std::endl;
+                std::cout << "  -n, --max-stages      "
+                          << "Maximum number of stages in the pipeline scaling suite                "
+                          << "[" << max_stages << "]" << std::endl;
+                std::cout << "  -s, --suites          "
+                          << "Comma separated list of the suites to run                             "
+                          << "[\"" << suites << "\"]" << std::endl;
+                std::cout << "  -o, --json-filepath   "
+                          << "Path to the JSON output file                                          "
+                          << "[\"" << json_filepath << "\"]" << std::endl;
+                std::cout << "  -h, --help            "
+                          << "This help                                                             "
+                          << "[false]" << std::endl;
+                exit(0);
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::cout << "################################" << std::endl;
+    std::cout << "# Benchmark suite: aff3ct-core #" << std::endl;
+    std::cout << "################################" << std::endl;
+    std::cout << "#" << std::endl;
+
+    std::cout << "# Command line arguments:" << std::endl;
+    std::cout << "#   - n_exec        = " << n_exec << std::endl;
+    std::cout << "#   - n_reps        = " << n_reps << std::endl;
+    std::cout << "#   - max_threads   = " << max_threads << std::endl;
+    std::cout << "#   - max_stages    = " << max_stages << std::endl;
+    std::cout << "#   - suites        = " << suites << std::endl;
+    std::cout << "#   - json_filepath = " << json_filepath << std::endl;
+    std::cout << "#" << std::endl;
+
+    if (n_exec == 0 || n_reps == 0 || max_threads == 0 || max_stages < 2)
+    {
+        std::cerr << rang::tag::error << "'n_exec', 'n_reps' and 'max_threads' have to be greater than 0 and "
+                  << "'max_stages' has to be greater than 1." << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> suites_list;
+    std::stringstream ss(suites);
+    std::string suite;
+    while (std::getline(ss, suite, ','))
+        suites_list.push_back(suite);
+
+    std::vector<Result> results;
+    for (auto& s : suites_list)
+    {
+        std::cout << "# Running the '" << s << "' suite..." << std::endl;
+        if (s == "task")
+            bench_task(results, n_exec, n_reps);
+        else if (s == "socket")
+            bench_socket(results, n_exec, n_reps);
+        else if (s == "adaptor")
+            bench_adaptor(results, n_exec, n_reps);
+        else if (s == "sequence")
+            bench_sequence(results, n_exec, n_reps, max_threads);
+        else if (s == "pipeline")
+            bench_pipeline(results, n_exec, n_reps, max_stages);
+        else if (s == "n_frames")
+            bench_n_frames(results, n_exec, n_reps);
+        else
+        {
+            std::cerr << rang::tag::error << "Unknown suite '" << s << "'." << std::endl;
+            return 1;
+        }
+    }
+
+    std::ofstream file(json_filepath);
+    write_json(file, results, n_exec, n_reps);
+    std::cout << "# Results written in '" << json_filepath << "' (" << results.size() << " measures)." << std::endl;
+
+    return 0;
+}
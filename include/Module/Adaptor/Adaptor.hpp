@@ -6,6 +6,7 @@
 #define ADAPTOR_HPP_
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -16,10 +17,16 @@
 #include "Runtime/Sequence/Sequence.hpp"
 #include "Runtime/Socket/Socket.hpp"
 #include "Runtime/Task/Task.hpp"
+#include "Tools/Algo/Histogram/Latency_histogram.hpp"
+#include "Tools/Algo/Relaxed_atomic/Relaxed_atomic.hpp"
 #include "Tools/Interface/Interface_waiting.hpp"
 
 namespace aff3ct
 {
+namespace runtime
+{
+class Pipeline;
+}
 namespace module
 {
 namespace adp
@@ -75,8 +82,31 @@ class Adaptor
   , public tools::Interface_waiting
 {
     friend runtime::Sequence; // Sequence is friend to enable the no copy mode (0 copy)
+    friend runtime::Pipeline; // Pipeline is friend to share the end-to-end latency histogram
+
+  public:
+    // telemetry of one side (push or pull) of a replica, only written by the thread executing this side and read
+    // concurrently by the metrics exporters
+    struct telemetry_t
+    {
+        tools::Relaxed_atomic<uint64_t> n_calls;   // number of push (or pull) calls
+        tools::Relaxed_atomic<uint64_t> n_blocked; // number of calls that had to wait for a slot
+        tools::Relaxed_atomic<uint64_t> n_spins;   // number of iterations in the active waiting loop
+        tools::Relaxed_atomic<uint64_t> n_sleeps;  // number of sleeps on the condition variable (passive waiting)
+        tools::Relaxed_atomic<std::chrono::nanoseconds> wait_duration; // time spent to wait for a slot
+        tools::Relaxed_atomic<uint64_t> occupancy_sum; // sum of the numbers of filled slots seen at the calls
+        tools::Relaxed_atomic<uint64_t> occupancy_max; // max number of filled slots seen at the calls
+    };
 
   protected:
+    // metadata carried by each slot when the latency tracking is enabled (times in nanoseconds of the steady clock)
+    struct frame_meta_t
+    {
+        uint64_t t_ingress; // time at which the frame entered the first stage
+        uint64_t seq;       // sequence number given by the first adaptor crossed by the frame
+        uint64_t t_push;    // time at which the frame has been pushed in the slot
+    };
+
     std::vector<size_t> n_elmts;
     std::vector<size_t> n_bytes;
     const std::vector<std::type_index> datatype;
@@ -91,17 +121,89 @@ class Adaptor
     std::shared_ptr<std::vector<std::atomic<uint64_t>>> first;
     std::shared_ptr<std::vector<std::atomic<uint64_t>>> last;
 
+    std::shared_ptr<std::vector<std::atomic<bool>>> enabled;
     std::shared_ptr<std::atomic<bool>> waiting_canceled;
 
     bool no_copy_pull;
     bool no_copy_push;
 
+    // the slots are pushed/pulled by batches: 'batch_size' consecutive slots are given to the same replica before to
+    // move to the next one in the round-robin, the filled/freed slots are published to the other side when the batch
+    // is complete, when the 'batch_latency' is exceeded or when the current replica would have to wait
+    size_t batch_size;
+    std::chrono::nanoseconds batch_latency;
+    // a producer that stalls outside of the adaptor can't publish its partial batch: it stages the position of its
+    // last filled slot ('staged_last[id]') and the time of its oldest pending slot ('t_staged[id]', in nanoseconds),
+    // and the puller waiting for this replica publishes the staged slots once the 'batch_latency' is exceeded
+    std::shared_ptr<std::vector<std::atomic<uint64_t>>> staged_last;
+    std::shared_ptr<std::vector<std::atomic<uint64_t>>> t_staged;
+    uint64_t push_base; // position of the first pending slot of the push side ('last[id]' seen by the producer)
+    size_t n_pending_push;
+    size_t n_pending_pull;
+    size_t n_batch_push;
+    size_t n_batch_pull;
+    std::chrono::time_point<std::chrono::steady_clock> t_pending_push;
+    std::chrono::time_point<std::chrono::steady_clock> t_pending_pull;
+
+    // adaptors executed by the same replica: their pending slots are published before the replica waits here
+    Adaptor* linked_push;
+    Adaptor* linked_pull;
+
+    // latency tracking: the metadata of the slots follow the buffers ('meta[id][slot]'), the replicas of a stage
+    // forward the metadata of the pulled frame to the linked push adaptor, the time spent in the slots is accumulated
+    // in 'residence' and the adaptors of the last stage accumulate the end-to-end latency in 'latency'
+    bool latency_tracking;
+    std::shared_ptr<std::vector<std::vector<frame_meta_t>>> meta;
+    std::shared_ptr<std::atomic<uint64_t>> n_ingress;
+    std::shared_ptr<tools::Latency_histogram> residence;
+    std::shared_ptr<tools::Latency_histogram> latency;
+    frame_meta_t cur_meta; // metadata of the last pulled frame (pull side)
+    bool cur_meta_valid;
+    uint64_t t_ingress; // ingress time of the next frame pushed by a first stage (push side)
+    // ordered merge (see 'Adaptor_n_to_1::set_merge'): the slots carry the sequence numbers of the frames even if the
+    // latency is not tracked, and the adaptor distributing the frames to the merged replicas renumbers them
+    bool seq_tracking;
+    bool seq_restart;
+    // deadline-aware shedding: the slots carry the ingress times of the frames, the pull side drops the frames that
+    // have spent more than 'deadline' in the pipeline (0 = disabled) if 'shedding' is enabled, 'n_dropped' counts the
+    // frames dropped by this replica
+    std::chrono::nanoseconds deadline;
+    bool shedding;
+    uint64_t n_dropped;
+
+    bool telemetry;
+    telemetry_t tlm_push;
+    telemetry_t tlm_pull;
+
   public:
     inline size_t get_n_elmts(const size_t sid = 0) const;
     inline size_t get_n_bytes(const size_t sid = 0) const;
     inline std::type_index get_datatype(const size_t sid = 0) const;
     void send_cancel_signal();
-    void reset();
+    virtual void reset();
+    void set_enabled(const bool enabled);
+    bool is_enabled() const;
+    void set_batch_size(const size_t batch_size);
+    size_t get_batch_size() const;
+    void set_batch_latency(const std::chrono::nanoseconds batch_latency);
+    std::chrono::nanoseconds get_batch_latency() const;
+    void link_push(Adaptor& push_adaptor);
+    void set_latency_tracking(const bool latency_tracking);
+    bool is_latency_tracking() const;
+    const tools::Latency_histogram& get_residence() const;
+    void set_telemetry(const bool telemetry);
+    bool is_telemetry() const;
+    const telemetry_t& get_push_telemetry() const;
+    const telemetry_t& get_pull_telemetry() const;
+    void reset_telemetry();
+    void set_deadline(const std::chrono::nanoseconds deadline);
+    std::chrono::nanoseconds get_deadline() const;
+    void set_shedding(const bool shedding);
+    bool is_shedding() const;
+    uint64_t get_n_dropped() const;
+    void reset_n_dropped();
+    virtual void flush_push() = 0;
+    virtual void flush_pull() = 0;
     virtual ~Adaptor();
     virtual Adaptor* clone() const;
     virtual void set_n_frames(const size_t n_frames);
@@ -117,12 +219,26 @@ class Adaptor
     inline bool is_empty(const size_t id);
     inline size_t n_free_slots(const size_t id);
     inline size_t n_fill_slots(const size_t id);
+    inline size_t get_next_enabled_id(const size_t id) const;
+    inline bool is_batch_latency_exceeded(const std::chrono::time_point<std::chrono::steady_clock>& t_pending) const;
+    inline void stage_push(const size_t id);
+    inline void publish_push(const size_t id);
+    inline bool publish_staged(const size_t id);
+    inline bool is_meta_tracking() const;
+    void alloc_meta();
+    inline void track_push(const size_t id, const size_t slot);
+    inline void track_pull(const size_t id, const size_t slot);
+    inline void track_egress();
+    inline bool is_expired(const frame_meta_t& m) const;
+    inline uint64_t telemetry_begin(telemetry_t& tlm, const size_t n_filled_slots, const bool blocking);
+    inline void telemetry_end(telemetry_t& tlm, const uint64_t t_wait, const uint64_t n_checks, const bool active);
 
     void set_no_copy_push(const bool no_copy_push);
     void set_no_copy_pull(const bool no_copy_pull);
     bool is_no_copy_push();
     bool is_no_copy_pull();
-    void reset_buffer();
+    // the slots get their own buffers back, the sockets must have given back the buffers they borrowed (no copy mode)
+    virtual void reset_buffer();
     virtual void* get_empty_buffer(const size_t sid) = 0;
     virtual void* get_filled_buffer(const size_t sid) = 0;
     virtual void* get_empty_buffer(const size_t sid, void* swap_buffer) = 0;
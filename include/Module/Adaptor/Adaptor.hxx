@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <cmath>
 #include <sstream>
 #include <string>
 
 #include "Module/Adaptor/Adaptor.hpp"
 #include "Tools/Exception/exception.hpp"
+#include "Tools/System/clock.hpp"
 #include "Tools/compute_bytes.h"
 
 namespace aff3ct
@@ -25,9 +27,37 @@ Adaptor::Adaptor(const size_t n_elmts, const std::type_index datatype, const siz
       std::vector<std::vector<int8_t*>>(1, std::vector<int8_t*>(buffer_size))))
   , first(new std::vector<std::atomic<uint64_t>>(1000))
   , last(new std::vector<std::atomic<uint64_t>>(1000))
+  , enabled(new std::vector<std::atomic<bool>>(1000))
   , waiting_canceled(new std::atomic<bool>(false))
   , no_copy_pull(false)
   , no_copy_push(false)
+  , batch_size(1)
+  , batch_latency(0)
+  , staged_last(new std::vector<std::atomic<uint64_t>>(1000))
+  , t_staged(new std::vector<std::atomic<uint64_t>>(1000))
+  , push_base(0)
+  , n_pending_push(0)
+  , n_pending_pull(0)
+  , n_batch_push(0)
+  , n_batch_pull(0)
+  , linked_push(nullptr)
+  , linked_pull(nullptr)
+  , latency_tracking(false)
+  , meta(new std::vector<std::vector<frame_meta_t>>())
+  , n_ingress(new std::atomic<uint64_t>(0))
+  , residence(new tools::Latency_histogram())
+  , latency(nullptr)
+  , cur_meta{ 0, 0, 0 }
+  , cur_meta_valid(false)
+  , t_ingress(0)
+  , seq_tracking(false)
+  , seq_restart(false)
+  , deadline(0)
+  , shedding(false)
+  , n_dropped(0)
+  , telemetry(false)
+  , tlm_push{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 }
+  , tlm_pull{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 }
 {
     const std::string name = "Adaptor";
     this->set_name(name);
@@ -58,6 +88,12 @@ Adaptor::Adaptor(const size_t n_elmts, const std::type_index datatype, const siz
         a = 0;
     for (auto& a : *this->last.get())
         a = 0;
+    for (auto& a : *this->staged_last.get())
+        a = 0;
+    for (auto& t : *this->t_staged.get())
+        t = 0;
+    for (auto& e : *this->enabled.get())
+        e = true;
 
     this->tasks_with_nullptr.resize((size_t)adp::tsk::SIZE);
 }
@@ -78,9 +114,37 @@ Adaptor::Adaptor(const std::vector<size_t>& n_elmts,
       std::vector<std::vector<int8_t*>>(n_sockets, std::vector<int8_t*>(buffer_size))))
   , first(new std::vector<std::atomic<uint64_t>>(1000))
   , last(new std::vector<std::atomic<uint64_t>>(1000))
+  , enabled(new std::vector<std::atomic<bool>>(1000))
   , waiting_canceled(new std::atomic<bool>(false))
   , no_copy_pull(false)
   , no_copy_push(false)
+  , batch_size(1)
+  , batch_latency(0)
+  , staged_last(new std::vector<std::atomic<uint64_t>>(1000))
+  , t_staged(new std::vector<std::atomic<uint64_t>>(1000))
+  , push_base(0)
+  , n_pending_push(0)
+  , n_pending_pull(0)
+  , n_batch_push(0)
+  , n_batch_pull(0)
+  , linked_push(nullptr)
+  , linked_pull(nullptr)
+  , latency_tracking(false)
+  , meta(new std::vector<std::vector<frame_meta_t>>())
+  , n_ingress(new std::atomic<uint64_t>(0))
+  , residence(new tools::Latency_histogram())
+  , latency(nullptr)
+  , cur_meta{ 0, 0, 0 }
+  , cur_meta_valid(false)
+  , t_ingress(0)
+  , seq_tracking(false)
+  , seq_restart(false)
+  , deadline(0)
+  , shedding(false)
+  , n_dropped(0)
+  , telemetry(false)
+  , tlm_push{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 }
+  , tlm_pull{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 }
 {
     const std::string name = "Adaptor";
     this->set_name(name);
@@ -122,6 +186,12 @@ Adaptor::Adaptor(const std::vector<size_t>& n_elmts,
         a = 0;
     for (auto& a : *this->last.get())
         a = 0;
+    for (auto& a : *this->staged_last.get())
+        a = 0;
+    for (auto& t : *this->t_staged.get())
+        t = 0;
+    for (auto& e : *this->enabled.get())
+        e = true;
 
     this->tasks_with_nullptr.resize((size_t)adp::tsk::SIZE);
 }
@@ -169,5 +239,160 @@ Adaptor::n_free_slots(const size_t id)
     return this->buffer_size - this->n_fill_slots(id);
 }
 
+size_t
+Adaptor::get_next_enabled_id(const size_t id) const
+{
+    // the adaptor of id 0 is never disabled, so this loop always ends
+    size_t next_id = id;
+    do
+    {
+        next_id = (next_id + 1) % this->buffer->size();
+    } while ((*this->buffer)[next_id].size() == 0 || !(*this->enabled)[next_id]);
+    return next_id;
+}
+
+bool
+Adaptor::is_batch_latency_exceeded(const std::chrono::time_point<std::chrono::steady_clock>& t_pending) const
+{
+    return this->batch_latency.count() > 0 && std::chrono::steady_clock::now() - t_pending >= this->batch_latency;
+}
+
+void
+Adaptor::stage_push(const size_t id)
+{
+    if (this->batch_latency.count() <= 0) return;
+
+    const uint64_t staged = this->push_base + this->n_pending_push;
+    // the batch (re)starts if the previous pending slots have all been published by the puller
+    if (this->n_pending_push == 1 || (*this->last)[id].load(std::memory_order_relaxed) == staged - 1)
+    {
+        this->t_pending_push = std::chrono::steady_clock::now();
+        (*this->t_staged)[id].store(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(this->t_pending_push.time_since_epoch()).count(),
+          std::memory_order_relaxed);
+    }
+    // the content of the slot is visible to the puller that loads the staged position
+    (*this->staged_last)[id].store(staged, std::memory_order_release);
+}
+
+void
+Adaptor::publish_push(const size_t id)
+{
+    // a part of the pending slots may already have been published by the puller (see 'publish_staged')
+    const uint64_t pushed = this->push_base + this->n_pending_push;
+    uint64_t published = (*this->last)[id];
+    while (published < pushed && !(*this->last)[id].compare_exchange_weak(published, pushed))
+        ;
+    this->push_base = pushed;
+    this->n_pending_push = 0;
+}
+
+bool
+Adaptor::publish_staged(const size_t id)
+{
+    if (this->batch_latency.count() <= 0) return false;
+
+    const uint64_t staged = (*this->staged_last)[id].load(std::memory_order_acquire);
+    uint64_t published = (*this->last)[id];
+    if (staged <= published) return false;
+
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                       std::chrono::steady_clock::now().time_since_epoch())
+                       .count();
+    if ((uint64_t)now - (*this->t_staged)[id].load(std::memory_order_relaxed) < (uint64_t)this->batch_latency.count())
+        return false;
+
+    // fails if the producer has published its slots in the meantime
+    return (*this->last)[id].compare_exchange_strong(published, staged);
+}
+
+bool
+Adaptor::is_meta_tracking() const
+{
+    return this->latency_tracking || this->seq_tracking || this->deadline.count() > 0;
+}
+
+void
+Adaptor::track_push(const size_t id, const size_t slot)
+{
+    // the clock is only read when the times are required (the sequence numbers alone are cheap)
+    const bool timed = this->latency_tracking || this->deadline.count() > 0;
+    const uint64_t now = timed ? tools::clock_now(tools::clock_source_t::STEADY) : 0;
+    frame_meta_t& m = (*this->meta)[id][slot];
+    const bool forward = this->linked_pull != nullptr && this->linked_pull->cur_meta_valid;
+    if (forward)
+    {
+        // the frame comes from a previous stage: forward its metadata
+        m.t_ingress = this->linked_pull->cur_meta.t_ingress;
+        m.seq = this->linked_pull->cur_meta.seq;
+        this->linked_pull->cur_meta_valid = false;
+    }
+    else
+    {
+        // the frame enters the pipeline
+        m.t_ingress = this->t_ingress ? this->t_ingress : now;
+    }
+    // the frames are numbered in the order of this adaptor if they enter the pipeline or if an ordered merge follows
+    if (!forward || this->seq_restart) m.seq = this->n_ingress->fetch_add(1, std::memory_order_relaxed);
+    m.t_push = now;
+    // the next frame of a first stage starts to be processed after this push
+    this->t_ingress = now;
+}
+
+void
+Adaptor::track_pull(const size_t id, const size_t slot)
+{
+    this->cur_meta = (*this->meta)[id][slot];
+    this->cur_meta_valid = true;
+    if (this->latency_tracking)
+    {
+        const uint64_t now = tools::clock_now(tools::clock_source_t::STEADY);
+        this->residence->add(std::chrono::nanoseconds(now - this->cur_meta.t_push));
+    }
+}
+
+uint64_t
+Adaptor::telemetry_begin(telemetry_t& tlm, const size_t n_filled_slots, const bool blocking)
+{
+    tlm.n_calls++;
+    tlm.occupancy_sum += n_filled_slots;
+    tlm.occupancy_max = std::max(tlm.occupancy_max.load(), (uint64_t)n_filled_slots);
+    // the clock is only read when the call is going to wait
+    return blocking ? tools::clock_now(tools::clock_source_t::STEADY) : 0;
+}
+
+void
+Adaptor::telemetry_end(telemetry_t& tlm, const uint64_t t_wait, const uint64_t n_checks, const bool active)
+{
+    if (t_wait == 0) return;
+
+    tlm.n_blocked++;
+    tlm.wait_duration += std::chrono::nanoseconds(tools::clock_now(tools::clock_source_t::STEADY) - t_wait);
+    if (active)
+        tlm.n_spins += n_checks;
+    else if (n_checks) // the predicate of the condition variable is checked once before the first sleep
+        tlm.n_sleeps += n_checks - 1;
+}
+
+void
+Adaptor::track_egress()
+{
+    // called when the replica comes back to pull a new frame: the previous one has been fully processed
+    if (this->cur_meta_valid && this->linked_push == nullptr && this->latency != nullptr)
+    {
+        const uint64_t now = tools::clock_now(tools::clock_source_t::STEADY);
+        this->latency->add(std::chrono::nanoseconds(now - this->cur_meta.t_ingress));
+    }
+    this->cur_meta_valid = false;
+}
+
+bool
+Adaptor::is_expired(const frame_meta_t& m) const
+{
+    if (this->deadline.count() <= 0) return false;
+    const uint64_t now = tools::clock_now(tools::clock_source_t::STEADY);
+    return now > m.t_ingress + (uint64_t)this->deadline.count();
+}
+
 }
 }
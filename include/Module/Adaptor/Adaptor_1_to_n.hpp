@@ -53,6 +53,8 @@ class Adaptor_1_to_n : public Adaptor
 
     void wake_up();
     void cancel_waiting();
+    void flush_push();
+    void flush_pull();
 
   protected:
     virtual void push_1(const std::vector<const int8_t*>& in, const size_t frame_id);
@@ -60,6 +62,8 @@ class Adaptor_1_to_n : public Adaptor
 
     void wait_push();
     void wait_pull();
+    void wait_pull_slot();
+    void release_pull();
     void* get_empty_buffer(const size_t sid);
     void* get_filled_buffer(const size_t sid);
     void* get_empty_buffer(const size_t sid, void* swap_buffer);
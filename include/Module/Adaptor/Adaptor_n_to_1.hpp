@@ -26,6 +26,14 @@ namespace module
 class Adaptor_n_to_1 : public Adaptor
 {
   public:
+    // order in which the frames of the replicas are pulled
+    enum class merge_t : size_t
+    {
+        ROUND_ROBIN, // the replicas are pulled in turn, like the frames have been distributed (default)
+        ORDERED,     // the ready replicas are pulled, a reorder buffer releases the frames in their original order
+        UNORDERED    // the ready replicas are pulled, the frames are released in their completion order
+    };
+
     inline runtime::Task& operator[](const adp::tsk t);
     inline runtime::Socket& operator[](const adp::sck::push_n s);
     inline runtime::Socket& operator[](const adp::sck::pull_1 s);
@@ -37,6 +45,18 @@ class Adaptor_n_to_1 : public Adaptor
     std::shared_ptr<std::condition_variable> cnd_pull;
     std::shared_ptr<std::mutex> mtx_pull;
 
+  protected:
+    merge_t merge;
+    // reorder buffer of the ordered merge (pull side): the frames pulled ahead of their turn are swapped with its
+    // buffers to free the slots of the replicas, the frame 'next_seq' is released first
+    size_t reorder_size;
+    std::vector<std::vector<int8_t*>> reorder_buffer;
+    std::vector<int8_t*> reorder_to_free;
+    std::vector<frame_meta_t> reorder_meta;
+    std::vector<bool> reorder_used;
+    size_t reorder_cur; // entry of the pulled frame, 'reorder_size' if it is pulled from the slot of a replica
+    uint64_t next_seq;
+
   public:
     inline Adaptor_n_to_1(const size_t n_elmts,
                           const std::type_index datatype,
@@ -46,13 +66,24 @@ class Adaptor_n_to_1 : public Adaptor
                           const std::vector<std::type_index>& datatype,
                           const size_t buffer_size = 1,
                           const bool active_waiting = true);
-    virtual ~Adaptor_n_to_1() = default;
+    virtual ~Adaptor_n_to_1();
     virtual Adaptor_n_to_1* clone() const;
 
     inline void init();
 
     void wake_up();
     void cancel_waiting();
+    void flush_push();
+    void flush_pull();
+    void reset();
+    void set_n_frames(const size_t n_frames);
+
+    // the ordered merge requires the sequence numbers of the frames in the slots, they are enabled on the replicas
+    // and on the adaptor distributing the frames by 'runtime::Pipeline::set_synchro_merge', if 'reorder_size' is 0
+    // the reorder buffer has 'buffer_size' entries
+    void set_merge(const merge_t merge, const size_t reorder_size = 0);
+    merge_t get_merge() const;
+    size_t get_reorder_size() const;
 
   protected:
     virtual void push_n(const std::vector<const int8_t*>& in, const size_t frame_id);
@@ -60,6 +91,17 @@ class Adaptor_n_to_1 : public Adaptor
 
     void wait_push();
     void wait_pull();
+    void wait_pull_slot();
+    void wait_pull_any();
+    void publish_staged_all();
+    bool select_ready();
+    bool select_ordered(const bool skip_gap = false);
+    void release_slot(const size_t id);
+    void release_pull();
+    const frame_meta_t& get_pull_meta() const;
+    void reset_buffer();
+    void alloc_reorder_buffer();
+    void free_reorder_buffer();
     void* get_empty_buffer(const size_t sid);
     void* get_filled_buffer(const size_t sid);
     void* get_empty_buffer(const size_t sid, void* swap_buffer);
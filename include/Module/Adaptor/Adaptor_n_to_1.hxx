@@ -37,6 +37,10 @@ Adaptor_n_to_1::Adaptor_n_to_1(const size_t n_elmts,
   , mtx_put(new std::vector<std::mutex>(1000))
   , cnd_pull(new std::condition_variable())
   , mtx_pull(new std::mutex())
+  , merge(merge_t::ROUND_ROBIN)
+  , reorder_size(0)
+  , reorder_cur(0)
+  , next_seq(0)
 {
     this->init();
 }
@@ -51,6 +55,10 @@ Adaptor_n_to_1::Adaptor_n_to_1(const std::vector<size_t>& n_elmts,
   , mtx_put(new std::vector<std::mutex>(1000))
   , cnd_pull(new std::condition_variable())
   , mtx_pull(new std::mutex())
+  , merge(merge_t::ROUND_ROBIN)
+  , reorder_size(0)
+  , reorder_cur(0)
+  , next_seq(0)
 {
     this->init();
 }
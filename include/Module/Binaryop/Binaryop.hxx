@@ -109,6 +109,18 @@ Binaryop<TI, TO, BOP>::Binaryop(const size_t n_in0, const size_t n_in1)
                              });
     }
 
+    if (n_in0 == n_in1)
+        this->create_elmtwise_codelet(
+          p,
+          [ps_in0, ps_in1, ps_out](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+          {
+              auto in0 = static_cast<const TI*>(d[ps_in0]);
+              auto in1 = static_cast<const TI*>(d[ps_in1]);
+              auto out = static_cast<TO*>(d[ps_out]);
+              for (size_t e = 0; e < n_elmts; e++)
+                  out[e] = BOP(in0[e], in1[e]);
+          });
+
     auto& p2 = this->create_task("performf");
     auto p2_in = this->template create_socket_in<TI>(p2, "in", n_in0);
     auto p2_fwd = this->template create_socket_fwd<TI>(p2, "fwd", n_in1);
@@ -135,6 +147,16 @@ Binaryop<TI, TO, BOP>::Binaryop(const size_t n_in0, const size_t n_in1)
               return runtime::status_t::SUCCESS;
           });
     }
+
+    if (n_in0 == n_in1)
+        this->create_elmtwise_codelet(p2,
+                                      [p2_in, p2_fwd](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+                                      {
+                                          auto in = static_cast<const TI*>(d[p2_in]);
+                                          auto fwd = static_cast<TI*>(d[p2_fwd]);
+                                          for (size_t e = 0; e < n_elmts; e++)
+                                              fwd[e] = BOP(fwd[e], in[e]);
+                                      });
 }
 
 template<typename TI, typename TO, tools::proto_bop<TI, TO> BOP>
@@ -71,6 +71,9 @@ class Incrementer : public Module
 
   protected:
     virtual void _increment(const T* in, T* out, const size_t frame_id);
+
+    // element-wise version of '_increment', the simulated latency is proportional to the number of processed elements
+    void _increment_elmts(const T* in, T* out, const size_t n_elmts);
 };
 }
 }
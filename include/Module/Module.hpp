@@ -251,6 +251,14 @@ class Module
     void create_cdl(runtime::Task& task,
                     std::function<int(Module& m, runtime::Task& t, const size_t frame_id)> codelet);
 
+    // optional codelet applied on any range of elements, it allows the 'runtime::Sequence' to fuse consecutive
+    // element-wise tasks (has to be called after 'create_codelet'), the codelet is only used by the modules of the
+    // type that created it: a derived module that overrides the hooks of the regular codelet is not fused unless it
+    // creates its own element-wise codelet
+    void create_elmtwise_codelet(
+      runtime::Task& task,
+      std::function<void(Module& m, runtime::Task& t, void* const* dataptrs, const size_t n_elmts)> codelet);
+
     void register_timer(runtime::Task& task, const std::string& key);
 
     virtual void set_n_frames_per_wave(const size_t n_frames_per_wave);
@@ -71,6 +71,9 @@ class Relayer : public Module
 
   protected:
     virtual void _relay(const T* in, T* out, const size_t frame_id);
+
+    // element-wise version of '_relay', the simulated latency is proportional to the number of processed elements
+    void _relay_elmts(const T* in, T* out, const size_t n_elmts);
 };
 }
 }
@@ -21,6 +21,8 @@ class Source_AZCW : public Source<B>
 
     virtual Source_AZCW<B>* clone() const;
 
+    virtual bool is_notifying_done() const;
+
   protected:
     void _generate(B* out_data, const size_t frame_id);
 };
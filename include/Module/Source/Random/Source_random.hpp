@@ -28,6 +28,8 @@ class Source_random : public Source<B>
 
     virtual Source_random<B>* clone() const;
 
+    virtual bool is_notifying_done() const;
+
     virtual void set_seed(const int seed);
 
   protected:
@@ -33,6 +33,7 @@ class Source_user : public Source<B>
     virtual Source_user<B>* clone() const;
 
     virtual bool is_done() const;
+    virtual bool is_notifying_done() const;
 
     virtual void reset();
 
@@ -32,6 +32,7 @@ class Source_user_binary : public Source<B>
     virtual ~Source_user_binary() = default;
 
     virtual bool is_done() const;
+    virtual bool is_notifying_done() const;
 
     virtual void reset();
 
@@ -53,6 +53,14 @@ Unaryop<TI, TO, UOP>::Unaryop(const size_t n_elmts)
           uop._perform(t[ps_in].template get_dataptr<const TI>(), t[ps_out].template get_dataptr<TO>(), frame_id);
           return runtime::status_t::SUCCESS;
       });
+    this->create_elmtwise_codelet(p,
+                                  [ps_in, ps_out](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+                                  {
+                                      auto in = static_cast<const TI*>(d[ps_in]);
+                                      auto out = static_cast<TO*>(d[ps_out]);
+                                      for (size_t e = 0; e < n_elmts; e++)
+                                          out[e] = UOP(in[e]);
+                                  });
 }
 
 template<typename TI, typename TO, tools::proto_uop<TI, TO> UOP>
@@ -0,0 +1,98 @@
+/*!
+ * \file
+ * \brief Class runtime::Exec_handle.
+ */
+#ifndef EXEC_HANDLE_HPP_
+#define EXEC_HANDLE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace aff3ct
+{
+namespace runtime
+{
+/*!
+ * \class Exec_handle
+ *
+ * \brief Handle of an asynchronous execution of a sequence or of a pipeline (see `Sequence::exec_async` and
+ * `Pipeline::exec_async`).
+ *
+ * The execution runs on a driver thread owned by the handle: this thread replaces the thread that calls `exec` in the
+ * synchronous mode (the first replica of a sequence or the last stage of a pipeline), so the caller is never blocked.
+ * The stop is cooperative: `request_stop` sets the stop token of the sequence (or of the stages of the pipeline), the
+ * threads end at the end of their current frame (or when they are waiting in an adaptor). An exception thrown by the
+ * execution is rethrown by `wait`. If the handle is destroyed while the execution is running, the stop is requested
+ * and the destructor waits for the end of the execution.
+ */
+class Exec_handle
+{
+  protected:
+    struct State
+    {
+        std::atomic<bool> stop_requested;
+        std::mutex mtx;
+        std::condition_variable cv;
+        bool done;
+        std::exception_ptr exception;
+        std::function<void()> stop;
+
+        State();
+    };
+
+    std::shared_ptr<State> state;
+    std::thread driver;
+
+  public:
+    /*!
+     * \brief Constructor of an empty handle (not attached to an execution).
+     */
+    Exec_handle() = default;
+
+    /*!
+     * \brief Constructor, launches 'exec' on the driver thread.
+     *
+     * \param exec: function running the execution.
+     * \param stop: function asking the execution to stop (called by 'request_stop' from any thread).
+     */
+    Exec_handle(std::function<void()> exec, std::function<void()> stop);
+
+    Exec_handle(Exec_handle&&) = default;
+    Exec_handle& operator=(Exec_handle&& other);
+
+    Exec_handle(const Exec_handle&) = delete;
+    Exec_handle& operator=(const Exec_handle&) = delete;
+
+    virtual ~Exec_handle();
+
+    // true if the handle is attached to an execution (until 'wait' returns)
+    bool valid() const;
+
+    // true if the execution is over (the result is ready to be taken by 'wait'), still true after 'wait'
+    bool is_done() const;
+
+    // ask the threads of the execution to stop, returns immediately (nothing is done if the execution is over)
+    void request_stop();
+    bool is_stop_requested() const;
+
+    // wait the end of the execution and rethrow its exception if any, the handle is not valid anymore after (but
+    // 'is_done' and 'is_stop_requested' still give the state of the execution)
+    void wait();
+
+    // wait the end of the execution during 'timeout' at most, returns true if the execution is over ('wait' has
+    // still to be called to get the exception)
+    bool wait_for(const std::chrono::nanoseconds timeout) const;
+
+  protected:
+    static void run(std::shared_ptr<State> state, std::function<void()> exec);
+};
+}
+}
+
+#endif /* EXEC_HANDLE_HPP_ */
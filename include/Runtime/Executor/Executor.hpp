@@ -0,0 +1,106 @@
+/*!
+ * \file
+ * \brief Class runtime::Executor.
+ */
+#ifndef EXECUTOR_HPP_
+#define EXECUTOR_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Runtime/Exec_handle/Exec_handle.hpp"
+#include "Runtime/Sequence/Sequence.hpp"
+#include "Tools/Interface/Interface_is_done.hpp"
+
+namespace aff3ct
+{
+namespace runtime
+{
+/*!
+ * \class Executor
+ *
+ * \brief Pool of worker threads shared by several sequences.
+ *
+ * The sequences submitted to the executor do not spawn their own threads: each worker repeatedly selects a replica
+ * of a submitted sequence that is not already executed and runs one iteration of its chain. The replica with the
+ * highest priority is selected first. Among the sequences of the same priority, the time of the pool is shared in
+ * proportion of their shares (weighted fair share): the sequence that consumed the smallest time divided by its share
+ * is selected first. A low priority sequence only uses the workers that are not required by the higher priorities.
+ * The iterations are not preempted: a new iteration of a high priority sequence waits at most the end of one
+ * iteration of a lower priority sequence. Between two iterations, a worker locks the mutex of the pool to account for
+ * the time of the iteration and to select the next replica (linear in the number of replicas): the cost is negligible
+ * for iterations of some microseconds, but a chain that runs in less than a microsecond with many workers is faster
+ * with 'Sequence::exec' (the workers serialize on the mutex).
+ */
+class Executor
+{
+  protected:
+    // a sequence submitted to the executor
+    struct job_t
+    {
+        Sequence* sequence;
+        std::function<bool()> user_stop_condition;
+        std::vector<tools::Interface_is_done*> polled_donners;
+        bool poll_sigint;
+        std::function<bool()> stop_condition; // user stop condition, polled donners and SIGINT
+        int priority;
+        size_t share;
+        double vtime;           // time consumed by the replicas (in nanoseconds) divided by the share
+        std::vector<bool> busy; // replicas being executed by a worker or finished
+        size_t n_finished;
+    };
+
+    const size_t n_threads;
+    const bool thread_pinning;
+    const std::vector<size_t> puids;
+
+    std::vector<std::thread> workers;
+    std::vector<std::shared_ptr<job_t>> jobs;
+    std::mutex mtx;
+    std::condition_variable cnd_work; // the workers wait for a replica to execute
+    std::condition_variable cnd_done; // the drivers wait for the end of their sequence
+    bool stop_workers;
+
+  public:
+    /*!
+     * \brief Constructor, launches the workers.
+     *
+     * \param n_threads:      number of workers in the pool.
+     * \param thread_pinning: pin the workers (the worker 'w' is pinned to 'puids[w]', or to the PU 'w' if 'puids' is
+     *                        empty).
+     * \param puids:          PU indexes of the workers.
+     */
+    Executor(const size_t n_threads, const bool thread_pinning = false, const std::vector<size_t>& puids = {});
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    // the running sequences are stopped and the workers are joined
+    virtual ~Executor();
+
+    size_t get_n_threads() const;
+
+    // execute the active replicas of 'sequence' on the workers of the pool until the stop condition, the stop token
+    // or the donners of the sequence stop them (see 'Sequence::exec'), the returned handle is the same as the one of
+    // 'Sequence::exec_async', the pinning policy and the real-time priority of the sequence are not used (the workers
+    // are pinned by the executor), a sequence can't be submitted again before the end of its execution, only the
+    // stop conditions without the statuses of the tasks are supported and the stages of a pipeline can't be submitted
+    Exec_handle submit(Sequence& sequence,
+                       const int priority = 0,
+                       const size_t share = 1,
+                       std::function<bool()> stop_condition = std::function<bool()>());
+
+  protected:
+    void run_worker(const size_t wid);
+    void wait_job(std::shared_ptr<job_t> job);
+    bool select(std::shared_ptr<job_t>& job, size_t& tid) const;
+};
+}
+}
+
+#endif /* EXECUTOR_HPP_ */
@@ -5,13 +5,18 @@
 #ifndef PIPELINE_HPP_
 #define PIPELINE_HPP_
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
 
+#include "Module/Adaptor/Adaptor.hpp"
+#include "Module/Adaptor/Adaptor_n_to_1.hpp"
+#include "Runtime/Exec_handle/Exec_handle.hpp"
 #include "Runtime/Sequence/Sequence.hpp"
+#include "Tools/Algo/Histogram/Latency_histogram.hpp"
 #include "Tools/Interface/Interface_get_set_n_frames.hpp"
 
 namespace aff3ct
@@ -20,6 +25,33 @@ namespace runtime
 {
 class Pipeline : public tools::Interface_get_set_n_frames
 {
+    friend Sequence; // a stage gives back the buffers of the adaptors with 'reset_no_copy_mode'
+
+  public:
+    // end-of-run analysis of a stage, built from the statistics of the tasks (the throughputs are in frames per
+    // second and the busy/waiting durations are given per replica)
+    struct stage_analysis_t
+    {
+        size_t n_replicas;                             // number of active replicas
+        uint64_t n_frames;                             // number of frames processed by the stage
+        std::vector<uint64_t> n_frames_per_replica;    // number of frames processed by each replica
+        std::vector<std::chrono::nanoseconds> busy;    // time spent in the tasks of the stage (adaptors excluded)
+        std::vector<std::chrono::nanoseconds> waiting; // time spent in the adaptors (pull and push)
+        double throughput;                             // effective throughput (frames / total execution time)
+        double capacity;                               // throughput if the replicas never wait for the adaptors
+        double capacity_plus_one;                      // capacity of the stage with one more replica
+    };
+
+    struct analysis_t
+    {
+        std::chrono::nanoseconds exec_duration; // total execution time of the pipeline
+        std::vector<stage_analysis_t> stages;
+        size_t bottleneck;         // stage with the smallest capacity
+        double throughput;         // effective throughput of the pipeline (frames processed by the last stage)
+        double throughput_what_if; // estimated throughput if the bottleneck stage had one more replica
+        size_t bottleneck_what_if; // bottleneck stage if the current one had one more replica
+    };
+
   protected:
     Sequence original_sequence;
     std::vector<std::shared_ptr<Sequence>> stages;
@@ -42,6 +74,15 @@ class Pipeline : public tools::Interface_get_set_n_frames
     bool bound_adaptors;
     bool auto_stop;
 
+    bool latency_tracking;
+    std::shared_ptr<tools::Latency_histogram> latency;
+
+    bool synchro_telemetry;
+
+    std::chrono::nanoseconds deadline;
+
+    std::chrono::nanoseconds exec_duration;
+
   public:
     // Pipeline(const runtime::Task &first,
     //          const std::vector<std::pair<std::vector<const runtime::Task*>, std::vector<const runtime::Task*>>>
@@ -168,6 +209,18 @@ class Pipeline : public tools::Interface_get_set_n_frames
     void exec(std::function<bool()> stop_condition);
     void exec();
 
+    // same as 'exec' on a driver thread owned by the returned handle (the caller thread is not blocked), the stop
+    // requested on the handle is requested to all the stages
+    Exec_handle exec_async(const std::vector<std::function<bool(const std::vector<const int*>&)>>& stop_conditions);
+    Exec_handle exec_async(const std::vector<std::function<bool()>>& stop_conditions);
+
+    Exec_handle exec_async(std::function<bool(const std::vector<const int*>&)> stop_condition);
+    Exec_handle exec_async(std::function<bool()> stop_condition);
+    Exec_handle exec_async();
+
+    // ask all the stages of the current 'exec' call to stop (thread safe, see 'Sequence::request_stop')
+    void request_stop();
+
     std::vector<Sequence*> get_stages();
     Sequence& operator[](const size_t stage_id);
 
@@ -192,6 +245,68 @@ class Pipeline : public tools::Interface_get_set_n_frames
     void set_auto_stop(const bool auto_stop);
     bool is_auto_stop() const;
 
+    // grow or shrink the number of replicas of a stage between two 'exec' calls, the replicas are taken in the pool
+    // of the 'n_threads' replicas allocated at the construction of the pipeline
+    void set_n_active_threads(const size_t stage_id, const size_t n_active_threads);
+    size_t get_n_active_threads(const size_t stage_id) const;
+
+    // real-time scheduling (SCHED_FIFO) of the replicas of a stage, 0 disables it (see
+    // 'Sequence::set_realtime_priority')
+    void set_realtime_priority(const size_t stage_id, const int priority);
+    int get_realtime_priority(const size_t stage_id) const;
+
+    // push and pull the adaptor slots by batches of 'batch_size' frames, a partially filled batch is published after
+    // 'batch_latency' (0 = no latency bound, the batch is published when complete or at the end of the stage)
+    void set_synchro_batch(const size_t batch_size,
+                           const std::chrono::nanoseconds batch_latency = std::chrono::nanoseconds(0));
+    size_t get_synchro_batch_size() const;
+
+    // order in which the stage following a multi-threaded stage pulls the frames of the replicas: in turn (default),
+    // as soon as a replica is ready with a reorder buffer of 'reorder_size' slots restoring the original order, or as
+    // soon as a replica is ready in the completion order (see 'module::Adaptor_n_to_1::set_merge'), the first version
+    // applies to all the synchronizations from a multi-threaded stage to a sequential stage
+    void set_synchro_merge(const module::Adaptor_n_to_1::merge_t merge, const size_t reorder_size = 0);
+    void set_synchro_merge(const size_t sync_id,
+                           const module::Adaptor_n_to_1::merge_t merge,
+                           const size_t reorder_size = 0);
+    module::Adaptor_n_to_1::merge_t get_synchro_merge(const size_t sync_id) const;
+
+    // track the frames through the adaptors: each slot carries the ingress time and the sequence number of its frame,
+    // the end-to-end latency (from the first to the last stage) and the time spent in each synchronization buffer
+    // are accumulated in histograms (the values are per slot, a slot contains 'n_frames' frames)
+    void set_latency_tracking(const bool latency_tracking);
+    bool is_latency_tracking() const;
+    const tools::Latency_histogram& get_latency() const;
+    // residence time in the synchronization buffer between the stages 'sync_id' and 'sync_id +1'
+    const tools::Latency_histogram& get_residence(const size_t sync_id) const;
+    void reset_latency();
+
+    // collect the occupancy of the synchronization buffers and the time spent by the replicas to wait for a slot
+    void set_synchro_telemetry(const bool synchro_telemetry);
+    bool is_synchro_telemetry() const;
+    // telemetry of each replica of the stage 'sync_id' (push side) or of the stage 'sync_id +1' (pull side)
+    std::vector<module::Adaptor::telemetry_t> get_synchro_telemetry(const size_t sync_id, const bool push_side) const;
+    void reset_synchro_telemetry();
+
+    // deadline-aware shedding: a frame has to leave the pipeline less than 'deadline' after its entry in the first
+    // stage (0 = disabled), the stages drop the frames that already missed their deadline when they pull them instead
+    // of processing them, the replicated stages followed by a round-robin or an ordered merge can't drop a frame (the
+    // merge expects all the frames), the frame is dropped by the next sequential stage
+    void set_deadline(const std::chrono::nanoseconds deadline);
+    std::chrono::nanoseconds get_deadline() const;
+    // number of frames dropped by the replicas of the stage 'sync_id +1'
+    uint64_t get_n_dropped(const size_t sync_id) const;
+    // number of frames dropped by all the stages
+    uint64_t get_n_dropped() const;
+    void reset_n_dropped();
+
+    // cumulated duration of the 'exec' calls (used by 'analyze')
+    std::chrono::nanoseconds get_exec_duration() const;
+    void reset_exec_duration();
+    // per-stage throughputs, utilization of the replicas and bottleneck stage, the statistics of the tasks have to
+    // be enabled ('set_stats(true)') and they should be reset together with 'reset_exec_duration()'
+    analysis_t analyze() const;
+
     size_t get_n_frames() const;
     void set_n_frames(const size_t n_frames);
 
@@ -202,6 +317,20 @@ class Pipeline : public tools::Interface_get_set_n_frames
     void _bind_adaptors(const bool bind_adaptors = true);
     void _unbind_adaptors(const bool bind_orphans = true);
 
+    // the sockets of all the stages give back the buffers borrowed to the adaptors (no copy mode) and the slots get
+    // their own buffers back, required before to unbind or to reallocate the buffers
+    void reset_no_copy_mode();
+
+    // same as 'exec' without resetting the stop tokens of the stages
+    void _exec(const std::vector<std::function<bool(const std::vector<const int*>&)>>& stop_conditions);
+    void _exec(const std::vector<std::function<bool()>>& stop_conditions);
+
+    void begin_latency_tracking();
+    void end_latency_tracking();
+
+    // enable the shedding on the pull side of the stages that can drop a frame (see 'set_deadline')
+    void update_shedding();
+
   private:
     template <class TA>
     void init(const std::vector<TA*> &firsts,
@@ -14,11 +14,13 @@
 #include <string>
 #include <vector>
 
+#include "Runtime/Exec_handle/Exec_handle.hpp"
 #include "Runtime/Socket/Socket.hpp"
 #include "Tools/Algo/Digraph/Digraph_node.hpp"
 #include "Tools/Interface/Interface_clone.hpp"
 #include "Tools/Interface/Interface_get_set_n_frames.hpp"
 #include "Tools/Interface/Interface_is_done.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
 
 namespace aff3ct
 {
@@ -30,6 +32,7 @@ class Module;
 namespace runtime
 {
 class Pipeline;
+class Executor;
 
 enum class subseq_t : size_t
 {
@@ -69,9 +72,18 @@ class Sequence
   , public tools::Interface_is_done
 {
     friend Pipeline;
+    friend Executor; // Executor is friend to execute the replicas one iteration at a time
 
   protected:
+    // task currently executed by a thread (read by the sampling profiler), padded to avoid the false sharing
+    struct current_task_t
+    {
+        std::atomic<runtime::Task*> task;
+        char padding[128 - sizeof(std::atomic<runtime::Task*>)];
+    };
+
     size_t n_threads;
+    size_t n_active_threads;
     std::vector<tools::Digraph_node<Sub_sequence>*> sequences;
     std::vector<size_t> firsts_tasks_id;
     std::vector<size_t> lasts_tasks_id;
@@ -82,17 +94,31 @@ class Sequence
     std::shared_ptr<std::mutex> mtx_exception;
     std::vector<std::string> prev_exception_messages;
     std::vector<std::string> prev_exception_messages_to_display;
-    std::shared_ptr<std::atomic<bool>> force_exit_loop;
+    // stop token checked by the threads after each execution of the sequence (one relaxed load), set by
+    // 'request_stop', by the donners when they become done, by the SIGINT signal and when an exception is thrown
+    std::shared_ptr<std::atomic<bool>> stop_token;
+    std::shared_ptr<std::vector<current_task_t>> current_tasks;
     size_t n_tasks;
     bool tasks_inplace;
     bool thread_pinning;
     std::vector<size_t> puids;
     bool no_copy_mode;
+    // the processes are generated in no copy mode: the sockets borrow the buffers of the adaptors and of the switchers
+    // during the 'exec' calls (and from one call to the next one for a pipeline stage), the buffers are given back
+    // when the processes are generated again
+    bool no_copy_processes;
     const std::vector<const runtime::Task*> saved_exclusions;
     std::vector<tools::Interface_is_done*> donners;
     std::vector<std::vector<tools::Interface_reset*>> switchers_reset;
     bool auto_stop;
     bool is_part_of_pipeline;
+    // pipeline of the stage (nullptr if the sequence is not a pipeline stage)
+    Pipeline* pipeline;
+    bool sub_waves;
+    size_t n_frames_per_sub_wave;
+    size_t sub_waves_cache_size;
+    bool fusion;
+    size_t fusion_chunk_size;
 
     // internal state for the `exec_step` method
     std::vector<bool> next_round_is_over;
@@ -101,6 +127,12 @@ class Sequence
 
     // extra attribute for pinning v2
     std::vector<std::string> pin_objects_per_thread;
+    // pinning targets of each thread resolved once (from 'puids' or 'pin_objects_per_thread')
+    std::vector<tools::Thread_pinning::cpuset_t> pin_cpusets;
+    // false if the thread calling 'exec' ends after it (ex: the stages of a pipeline except the last one), then it is
+    // not unpinned
+    bool unpin_caller_thread;
+    int realtime_priority;
 
   public:
     Sequence(const std::vector<const runtime::Task*>& firsts,
@@ -221,14 +253,39 @@ class Sequence
     void set_thread_pinning(const bool thread_pinning, const std::string& sequence_pinning_policy);
     bool is_thread_pinning();
 
+    // real-time scheduling (SCHED_FIFO) of the threads during the 'exec' calls, 0 disables it (default), if the
+    // process is not permitted to use it the threads keep their scheduling policy
+    void set_realtime_priority(const int priority);
+    int get_realtime_priority() const;
+
     void exec(std::function<bool(const std::vector<const int*>&)> stop_condition);
     void exec(std::function<bool()> stop_condition);
     void exec();
+
+    // same as 'exec' on a driver thread owned by the returned handle (the caller thread is not blocked), the sequence
+    // has to stay alive and unchanged until the end of the execution ('Exec_handle::wait')
+    Exec_handle exec_async(std::function<bool(const std::vector<const int*>&)> stop_condition);
+    Exec_handle exec_async(std::function<bool()> stop_condition);
+    Exec_handle exec_async();
+
+    // ask the threads of the current 'exec' call to stop at the end of their current frame (thread safe), the stop
+    // token is reset at the beginning of each 'exec' call
+    void request_stop();
+    bool is_stop_requested() const;
+
     void exec_seq(const size_t tid = 0, const int frame_id = -1);
     runtime::Task* exec_step(const size_t tid = 0, const int frame_id = -1);
 
     inline size_t get_n_threads() const;
 
+    // only the 'n_active_threads' first replicas of the sequence are executed, the other replicas are kept to grow
+    // back later without cloning the modules again (has to be called between two 'exec' calls)
+    void set_n_active_threads(const size_t n_active_threads);
+    inline size_t get_n_active_threads() const;
+
+    // task currently executed by the thread 'tid' in 'exec' (nullptr between two executions of the sequence)
+    inline runtime::Task* get_current_task(const size_t tid) const;
+
     template<class C = module::Module>
     std::vector<C*> get_modules(const bool set_modules = true) const;
     template<class C = module::Module>
@@ -251,6 +308,21 @@ class Sequence
     void set_auto_stop(const bool auto_stop);
     bool is_auto_stop() const;
 
+    // interleave the execution of consecutive tasks on sub-waves of 'n_frames_per_sub_wave' frames (0 = size
+    // automatically selected from the socket byte sizes to fit in 'sub_waves_cache_size' bytes)
+    void set_sub_waves(const bool sub_waves, const size_t n_frames_per_sub_wave = 0);
+    bool is_sub_waves() const;
+    size_t get_n_frames_per_sub_wave() const;
+    void set_sub_waves_cache_size(const size_t cache_size);
+    size_t get_sub_waves_cache_size() const;
+
+    // fuse the consecutive element-wise tasks (see 'module::Module::create_elmtwise_codelet') bound one to another:
+    // they are executed together on chunks of 'fusion_chunk_size' elements, and the buffers only read by the next
+    // tasks of the group are replaced by chunk sized buffers
+    void set_fusion(const bool fusion, const size_t fusion_chunk_size = 1024);
+    bool is_fusion() const;
+    size_t get_fusion_chunk_size() const;
+
     inline size_t get_n_frames() const;
     void set_n_frames(const size_t n_frames);
 
@@ -292,6 +364,14 @@ class Sequence
     template<class SS, class MO>
     void duplicate(const tools::Digraph_node<SS>* sequence);
 
+    // same as 'exec' without resetting the stop token
+    void exec_threads(std::function<bool(const std::vector<const int*>&)> stop_condition);
+    void exec_threads(std::function<bool()> stop_condition);
+
+    // the donners that are not notifying and the SIGINT signal (if it cannot be notified) are returned to be polled
+    std::vector<tools::Interface_is_done*> register_stop_token(bool& poll_sigint);
+    void unregister_stop_token();
+
     void _exec(const size_t tid,
                std::function<bool(const std::vector<const int*>&)>& stop_condition,
                tools::Digraph_node<Sub_sequence>* sequence);
@@ -300,8 +380,45 @@ class Sequence
                                 std::function<bool()>& stop_condition,
                                 tools::Digraph_node<Sub_sequence>* sequence);
 
+    // execute the replica 'tid' once, returns false if the replica has to stop (stop token set, stop condition true,
+    // waiting canceled or exception)
+    bool exec_iteration(const size_t tid, std::function<bool()>& stop_condition);
+    // same with the statuses of the tasks given to the stop condition, 'statuses' is filled during the iteration
+    bool exec_iteration(const size_t tid,
+                        std::function<bool(const std::vector<const int*>&)>& stop_condition,
+                        std::vector<const int*>& statuses);
+    template<class SC>
+    bool _exec_iteration(const size_t tid, std::vector<const int*>* statuses, SC&& is_stop_condition);
+    // the statuses of the tasks are stored in 'statuses' (if not null)
+    void exec_subsequences(std::atomic<runtime::Task*>& cur_task,
+                           tools::Digraph_node<Sub_sequence>* cur_ss,
+                           std::vector<const int*>* statuses = nullptr);
+
+    // stop the execution and save the message of the exception, it is rethrown at the end of the execution
+    void save_exception(std::exception const& e);
+
     void gen_processes(const bool no_copy_mode = false);
-    void reset_no_copy_mode();
+    // the sockets give back the borrowed buffers, if 'keep_processes' is true the no copy processes are still valid
+    // after (they borrow the buffers again at the next 'exec' call), otherwise they have to be generated again
+    void reset_no_copy_mode(const bool keep_processes = false);
+    // at the end of an execution, a standalone sequence gives back the borrowed buffers: its sockets point to their
+    // own buffers between the 'exec' calls
+    void give_back_buffers();
+
+    void update_pin_cpusets();
+    void pin_thread(const size_t tid);
+
+    std::vector<runtime::Task*> get_sub_waves_group(
+      const std::vector<runtime::Task*>& tasks,
+      const size_t first_task_id,
+      const std::map<runtime::Task*, std::function<const int*()>>& modified_tasks) const;
+    size_t get_n_waves_per_sub_wave(const std::vector<runtime::Task*>& group) const;
+
+    std::vector<runtime::Task*> get_fusion_group(
+      const std::vector<runtime::Task*>& tasks,
+      const size_t first_task_id,
+      const std::map<runtime::Task*, std::function<const int*()>>& modified_tasks) const;
+    std::function<const int*()> gen_fusion_process(const std::vector<runtime::Task*>& group) const;
 
     template<class SS>
     void check_ctrl_flow(tools::Digraph_node<SS>* root);
@@ -13,6 +13,18 @@ Sequence::get_n_threads() const
     return this->n_threads;
 }
 
+size_t
+Sequence::get_n_active_threads() const
+{
+    return this->n_active_threads;
+}
+
+runtime::Task*
+Sequence::get_current_task(const size_t tid) const
+{
+    return (*this->current_tasks)[tid].task.load(std::memory_order_relaxed);
+}
+
 const std::vector<std::vector<runtime::Task*>>&
 Sequence::get_firsts_tasks() const
 {
@@ -15,9 +15,12 @@
 #include <unordered_map>
 #include <vector>
 
+#include "Tools/Algo/Relaxed_atomic/Relaxed_atomic.hpp"
 #include "Tools/Interface/Interface_clone.hpp"
 #include "Tools/Interface/Interface_reset.hpp"
+#include "Tools/System/clock.hpp"
 #include "Tools/System/memory.hpp"
+#include "Tools/System/perf_counters.hpp"
 
 namespace aff3ct
 {
@@ -59,6 +62,13 @@ enum class datatype_t : uint8_t
     U8
 };
 
+enum class exec_mode_t : uint8_t
+{
+    SINGLE_WAVE,     // one wave covers all the frames, the codelet is called directly
+    MULTI_WAVES,     // all the waves are full, they are processed in place by shifting the sockets dataptr
+    MULTI_WAVES_REST // the last wave is partial and has to be processed through the 'sockets_data' buffers
+};
+
 static std::unordered_map<int, std::string> status_t_to_string = { { 0, "SUCCESS" },
                                                                    { 1, "FAILURE" },
                                                                    { -1, "FAILURE_STOP" },
@@ -80,6 +90,7 @@ class Task
     const std::string name;
     bool autoalloc;
     bool stats;
+    bool perf;
     bool fast;
     bool debug;
     bool debug_hex;
@@ -87,6 +98,12 @@ class Task
     uint8_t debug_precision;
     int32_t debug_frame_max;
     std::function<int(module::Module& m, Task& t, const size_t frame_id)> codelet;
+    // optional codelet processing 'n_elmts' consecutive elements of all the frames, the 'dataptrs' are given in the
+    // 'sockets' order (status excluded) and point to the first element to process
+    std::function<void(module::Module& m, Task& t, void* const* dataptrs, const size_t n_elmts)> elmtwise_codelet;
+    // type of the module that created the element-wise codelet, the codelet is ignored for another type: a derived
+    // module can override the hooks of the regular codelet that the element-wise codelet does not call
+    std::type_index elmtwise_type;
     size_t n_input_sockets;
     size_t n_output_sockets;
     size_t n_fwd_sockets;
@@ -96,10 +113,15 @@ class Task
     std::vector<buffer> out_buffers;
 
     // stats
-    uint32_t n_calls;
-    std::chrono::nanoseconds duration_total;
-    std::chrono::nanoseconds duration_min;
-    std::chrono::nanoseconds duration_max;
+    tools::clock_source_t stats_clock;
+    uint32_t stats_sampling; // only 1 call out of 'stats_sampling' is measured, the totals are extrapolated
+    // written by the thread executing the task and read concurrently by the metrics exporters
+    tools::Relaxed_atomic<uint32_t> n_calls;
+    tools::Relaxed_atomic<uint32_t> n_sampled_calls;
+    tools::Relaxed_atomic<std::chrono::nanoseconds> duration_total;
+    tools::Relaxed_atomic<std::chrono::nanoseconds> duration_min;
+    tools::Relaxed_atomic<std::chrono::nanoseconds> duration_max;
+    std::chrono::nanoseconds duration_partial;
 
     std::vector<std::string> timers_name;
     std::vector<uint32_t> timers_n_calls;
@@ -107,12 +129,20 @@ class Task
     std::vector<std::chrono::nanoseconds> timers_min;
     std::vector<std::chrono::nanoseconds> timers_max;
 
+    // performance counters accumulated over the calls (indexed by 'tools::perf_event_t')
+    std::vector<uint64_t> perf_total;
+
     Socket* last_input_socket;
 
     // precomputed values to speedup the task execution
     std::vector<int8_t*> sockets_dataptr_init;
     std::vector<size_t> sockets_databytes_per_frame;
     std::vector<std::vector<int8_t>> sockets_data;
+    exec_mode_t exec_mode;
+    size_t n_frames;
+    size_t n_frames_per_wave;
+    size_t n_waves;
+    size_t n_frames_per_wave_rest;
 
   public:
     std::vector<std::shared_ptr<Socket>> fake_input_sockets;
@@ -131,6 +161,12 @@ class Task
 
     void set_autoalloc(const bool autoalloc);
     void set_stats(const bool stats);
+    // collect the performance counters of the calling thread during the task execution (requires the statistics)
+    void set_perf(const bool perf);
+    // select the clock used to measure the durations (the TSC falls back on the steady clock when unavailable)
+    void set_stats_clock(const tools::clock_source_t clock);
+    // measure only 1 call every 'n_calls' calls (the others run without timing), the totals are extrapolated
+    void set_stats_sampling(const uint32_t n_calls);
     void set_fast(const bool fast);
     void set_debug(const bool debug);
     void set_debug_hex(const bool debug_hex);
@@ -140,26 +176,36 @@ class Task
 
     inline bool is_autoalloc() const;
     inline bool is_stats() const;
+    inline bool is_perf() const;
     inline bool is_fast() const;
     inline bool is_debug() const;
     inline bool is_debug_hex() const;
     inline bool is_last_input_socket(const Socket& s_in) const;
+    bool is_elmtwise() const;
     bool can_exec() const;
 
     inline module::Module& get_module() const;
     inline std::string get_name() const;
     inline uint32_t get_n_calls() const;
+    inline uint32_t get_n_sampled_calls() const;
+    inline tools::clock_source_t get_stats_clock() const;
+    inline uint32_t get_stats_sampling() const;
 
-    // get stats
+    // get stats (the total durations are extrapolated when the sampling is enabled)
     std::chrono::nanoseconds get_duration_total() const;
     std::chrono::nanoseconds get_duration_avg() const;
     std::chrono::nanoseconds get_duration_min() const;
     std::chrono::nanoseconds get_duration_max() const;
     const std::vector<std::string>& get_timers_name() const;
+    // timers of the measured calls only
     const std::vector<uint32_t>& get_timers_n_calls() const;
     const std::vector<std::chrono::nanoseconds>& get_timers_total() const;
+    // timers extrapolated to all the calls when the sampling is enabled
+    std::vector<uint32_t> get_timers_n_calls_extrapolated() const;
+    std::vector<std::chrono::nanoseconds> get_timers_total_extrapolated() const;
     const std::vector<std::chrono::nanoseconds>& get_timers_min() const;
     const std::vector<std::chrono::nanoseconds>& get_timers_max() const;
+    const std::vector<uint64_t>& get_perf_total() const;
 
     size_t get_n_input_sockets() const;
     size_t get_n_output_sockets() const;
@@ -168,6 +214,18 @@ class Task
 
     const std::vector<int>& exec(const int frame_id = -1, const bool managed_memory = true);
 
+    // execute the waves in the [w_start, w_stop[ range, the full range has to be covered in increasing order over
+    // successive calls before the task statistics are updated, a wave that returns 'FAILURE_STOP' ends the call (the
+    // next waves must not be executed)
+    const std::vector<int>& exec_waves(const size_t w_start, const size_t w_stop);
+
+    // execute the element-wise codelet on the [e_start, e_stop[ range of the elements of all the frames, the
+    // 'dataptrs' replace the sockets dataptr and have to point to the 'e_start' element, the full range has to be
+    // covered in increasing order over successive calls before the task statistics are updated
+    const std::vector<int>& exec_elmts(const size_t e_start, const size_t e_stop, void* const* dataptrs);
+
+    inline size_t get_n_waves() const;
+
     inline Socket& operator[](const size_t id);
     Socket& operator[](const std::string& sck_name);
 
@@ -233,11 +291,31 @@ class Task
 
     void create_codelet(std::function<int(module::Module& m, Task& t, const size_t frame_id)>& codelet);
 
+    void create_elmtwise_codelet(
+      std::function<void(module::Module& m, Task& t, void* const* dataptrs, const size_t n_elmts)>& codelet,
+      const std::type_index& type);
+
     void update_n_frames(const size_t old_n_frames, const size_t new_n_frames);
 
     void update_n_frames_per_wave(const size_t old_n_frames_per_wave, const size_t new_n_frames_per_wave);
 
   private:
+    void update_exec_mode();
+
+    void commit_partial_stats();
+
+    inline bool is_stats_sampled() const;
+
+    double get_stats_extrapolation() const;
+
+    inline void perf_start(uint64_t* perf_values) const;
+
+    inline void perf_stop(const uint64_t* perf_values);
+
+    void _exec_waves(const size_t w_start, const size_t w_stop, int* status);
+
+    void _exec_frame(const int frame_id, int* status);
+
     template<typename T>
     inline Socket& create_2d_socket(const std::string& name,
                                     const size_t n_rows,
@@ -20,6 +20,12 @@ Task::is_stats() const
     return this->stats;
 }
 
+bool
+Task::is_perf() const
+{
+    return this->perf;
+}
+
 bool
 Task::is_fast() const
 {
@@ -66,6 +72,12 @@ Task::get_n_calls() const
     return this->n_calls;
 }
 
+size_t
+Task::get_n_waves() const
+{
+    return this->n_waves;
+}
+
 Socket&
 Task::operator[](const size_t id)
 {
@@ -78,11 +90,11 @@ Task::operator[](const size_t id)
 void
 Task::update_timer(const size_t id, const std::chrono::nanoseconds& duration)
 {
-    if (this->is_stats())
+    if (this->is_stats() && this->is_stats_sampled())
     {
         this->timers_n_calls[id]++;
         this->timers_total[id] += duration;
-        if (this->n_calls)
+        if (this->n_sampled_calls)
         {
             this->timers_max[id] = std::max(this->timers_max[id], duration);
             this->timers_min[id] = std::min(this->timers_min[id], duration);
@@ -95,6 +107,49 @@ Task::update_timer(const size_t id, const std::chrono::nanoseconds& duration)
     }
 }
 
+bool
+Task::is_stats_sampled() const
+{
+    // 'n_calls' is not incremented during a call (even when it is split in several 'exec_waves' or 'exec_elmts')
+    return this->stats_sampling == 1 || (this->n_calls % this->stats_sampling) == 0;
+}
+
+uint32_t
+Task::get_n_sampled_calls() const
+{
+    return this->n_sampled_calls;
+}
+
+tools::clock_source_t
+Task::get_stats_clock() const
+{
+    return this->stats_clock;
+}
+
+uint32_t
+Task::get_stats_sampling() const
+{
+    return this->stats_sampling;
+}
+
+void
+Task::perf_start(uint64_t* perf_values) const
+{
+    if (this->is_perf()) tools::perf_counters_read(perf_values);
+}
+
+void
+Task::perf_stop(const uint64_t* perf_values)
+{
+    if (this->is_perf())
+    {
+        uint64_t perf_values_stop[tools::perf_n_events];
+        tools::perf_counters_read(perf_values_stop);
+        for (size_t e = 0; e < tools::perf_n_events; e++)
+            this->perf_total[e] += perf_values_stop[e] - perf_values[e];
+    }
+}
+
 const std::vector<int>&
 Task::get_status() const
 {
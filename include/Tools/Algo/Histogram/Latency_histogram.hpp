@@ -0,0 +1,55 @@
+/*!
+ * \file
+ * \brief Class tools::Latency_histogram.
+ */
+#ifndef LATENCY_HISTOGRAM_HPP_
+#define LATENCY_HISTOGRAM_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace aff3ct
+{
+namespace tools
+{
+// lock-free histogram of durations with power of two buckets: the bucket 'b' counts the durations in [2^b, 2^(b+1)[
+// nanoseconds (the bucket 0 also counts the null durations), the values can be added concurrently by several threads
+class Latency_histogram
+{
+  public:
+    static constexpr size_t n_buckets = 64;
+
+  protected:
+    std::array<std::atomic<uint64_t>, n_buckets> buckets;
+    std::atomic<uint64_t> n_values;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> min;
+    std::atomic<uint64_t> max;
+
+  public:
+    Latency_histogram();
+    virtual ~Latency_histogram() = default;
+
+    inline void add(const std::chrono::nanoseconds duration);
+    void reset();
+
+    uint64_t get_n_values() const;
+    uint64_t get_bucket(const size_t b) const;
+    std::chrono::nanoseconds get_total() const;
+    std::chrono::nanoseconds get_avg() const;
+    std::chrono::nanoseconds get_min() const;
+    std::chrono::nanoseconds get_max() const;
+    // upper bound of the bucket containing the 'p' percentile ('p' in [0;100]), clamped to the min and max values
+    std::chrono::nanoseconds get_percentile(const float p) const;
+};
+}
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include "Tools/Algo/Histogram/Latency_histogram.hxx"
+#endif
+
+#endif /* LATENCY_HISTOGRAM_HPP_ */
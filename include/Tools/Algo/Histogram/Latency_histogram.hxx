@@ -0,0 +1,30 @@
+#include "Tools/Algo/Histogram/Latency_histogram.hpp"
+
+namespace aff3ct
+{
+namespace tools
+{
+void
+Latency_histogram::add(const std::chrono::nanoseconds duration)
+{
+    const uint64_t ns = duration.count() > 0 ? (uint64_t)duration.count() : 0;
+
+    size_t b = 0;
+    for (uint64_t v = ns >> 1; v; v >>= 1)
+        b++;
+
+    this->buckets[b].fetch_add(1, std::memory_order_relaxed);
+    this->total.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t cur = this->min.load(std::memory_order_relaxed);
+    while (ns < cur && !this->min.compare_exchange_weak(cur, ns, std::memory_order_relaxed))
+        ;
+    cur = this->max.load(std::memory_order_relaxed);
+    while (ns > cur && !this->max.compare_exchange_weak(cur, ns, std::memory_order_relaxed))
+        ;
+
+    // incremented last, this way a reader never sees more values than the sum of the buckets
+    this->n_values.fetch_add(1, std::memory_order_release);
+}
+}
+}
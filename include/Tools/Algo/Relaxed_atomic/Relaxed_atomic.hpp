@@ -0,0 +1,51 @@
+/*!
+ * \file
+ * \brief Class tools::Relaxed_atomic.
+ */
+#ifndef RELAXED_ATOMIC_HPP_
+#define RELAXED_ATOMIC_HPP_
+
+#include <atomic>
+
+namespace aff3ct
+{
+namespace tools
+{
+/*!
+ * \class Relaxed_atomic
+ *
+ * \brief Value written by a single thread and read concurrently by other threads.
+ *
+ * The loads and the stores are relaxed atomic operations: the concurrent reads are not data races and they compile to
+ * plain loads and stores. The increments are not atomic read-modify-write operations, so the value must only be
+ * written by one thread at a time. Contrary to `std::atomic`, the value can be copied (the copy is not atomic).
+ */
+template<typename T>
+class Relaxed_atomic
+{
+  private:
+    std::atomic<T> value;
+
+  public:
+    inline Relaxed_atomic(const T value = T());
+    inline Relaxed_atomic(const Relaxed_atomic<T>& other);
+
+    inline Relaxed_atomic<T>& operator=(const Relaxed_atomic<T>& other);
+    inline Relaxed_atomic<T>& operator=(const T value);
+
+    inline T load() const;
+    inline void store(const T value);
+    inline operator T() const;
+
+    inline Relaxed_atomic<T>& operator+=(const T value);
+    inline Relaxed_atomic<T>& operator++();
+    inline T operator++(int);
+};
+}
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include "Tools/Algo/Relaxed_atomic/Relaxed_atomic.hxx"
+#endif
+
+#endif /* RELAXED_ATOMIC_HPP_ */
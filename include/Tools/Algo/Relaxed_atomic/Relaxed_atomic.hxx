@@ -0,0 +1,81 @@
+#include "Tools/Algo/Relaxed_atomic/Relaxed_atomic.hpp"
+
+namespace aff3ct
+{
+namespace tools
+{
+template<typename T>
+Relaxed_atomic<T>::Relaxed_atomic(const T value)
+  : value(value)
+{
+}
+
+template<typename T>
+Relaxed_atomic<T>::Relaxed_atomic(const Relaxed_atomic<T>& other)
+  : value(other.load())
+{
+}
+
+template<typename T>
+Relaxed_atomic<T>&
+Relaxed_atomic<T>::operator=(const Relaxed_atomic<T>& other)
+{
+    this->store(other.load());
+    return *this;
+}
+
+template<typename T>
+Relaxed_atomic<T>&
+Relaxed_atomic<T>::operator=(const T value)
+{
+    this->store(value);
+    return *this;
+}
+
+template<typename T>
+T
+Relaxed_atomic<T>::load() const
+{
+    return this->value.load(std::memory_order_relaxed);
+}
+
+template<typename T>
+void
+Relaxed_atomic<T>::store(const T value)
+{
+    this->value.store(value, std::memory_order_relaxed);
+}
+
+template<typename T>
+Relaxed_atomic<T>::operator T() const
+{
+    return this->load();
+}
+
+template<typename T>
+Relaxed_atomic<T>&
+Relaxed_atomic<T>::operator+=(const T value)
+{
+    // single writer: the load and the store do not need to be a single atomic operation
+    this->store(this->load() + value);
+    return *this;
+}
+
+template<typename T>
+Relaxed_atomic<T>&
+Relaxed_atomic<T>::operator++()
+{
+    this->store(this->load() + 1);
+    return *this;
+}
+
+template<typename T>
+T
+Relaxed_atomic<T>::operator++(int)
+{
+    const T old = this->load();
+    this->store(old + 1);
+    return old;
+}
+}
+}
@@ -0,0 +1,150 @@
+/*!
+ * \file
+ * \brief Class tools::Exporter_metrics.
+ */
+#ifndef EXPORTER_METRICS_HPP_
+#define EXPORTER_METRICS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Tools/Reporter/Reporter.hpp"
+
+namespace aff3ct
+{
+namespace runtime
+{
+class Task;
+class Sequence;
+class Pipeline;
+}
+namespace tools
+{
+/*!
+ * \class Exporter_metrics
+ *
+ * \brief Serves the current statistics of the tasks, the last values of the probes and the counters of the pipeline
+ * synchronizations in the Prometheus text format.
+ *
+ * The metrics are served by a background thread over a Unix domain socket (address "unix:<path>") or over a TCP
+ * socket bound to the loopback interface (address "tcp:<port>" or "tcp:127.0.0.1:<port>"). Each connection receives
+ * one HTTP response containing the current metrics, then the connection is closed. The counters of the tasks and of
+ * the adaptors are relaxed atomics published by the processing threads (see `Relaxed_atomic`): a scrape never blocks
+ * the processing threads, each value is read atomically but the values of a scrape are not a consistent snapshot (a
+ * total duration can include one more call than the number of calls for instance). The reporters have to support
+ * typed snapshots (see `Reporter::snapshot`), they are drained at each scrape and only the last value of each column
+ * is kept, so they should not be drained by another consumer (like a `Terminal` or an `Exporter_probe`) at the same
+ * time. The columns with more than `max_column_size` elements per value are not served. The sockets are only
+ * available on the Unix-like systems.
+ */
+class Exporter_metrics
+{
+  public:
+    static const size_t max_column_size;
+
+  private:
+    std::thread srv_thread;
+    std::atomic<bool> stop_server;
+    int listen_fd;
+
+  protected:
+    std::string address;
+    std::vector<tools::Reporter*> reporters;
+    std::vector<Reporter::snapshot_t> snapshots;
+    // last value of each element of each column of each group of each reporter
+    std::vector<std::vector<std::vector<std::vector<double>>>> last_values;
+    std::vector<std::pair<std::string, runtime::Sequence*>> sequences;
+    std::vector<std::pair<std::string, runtime::Pipeline*>> pipelines;
+    std::mutex mutex_scrape;
+    std::atomic<size_t> n_scrapes;
+
+  public:
+    /*!
+     * \brief Constructor, the socket is opened by `start`.
+     *
+     * \param address:   "unix:<path>", "tcp:<port>" or "tcp:127.0.0.1:<port>".
+     * \param reporters: the reporters to drain (can be empty).
+     */
+    explicit Exporter_metrics(const std::string& address, const std::vector<tools::Reporter*>& reporters = {});
+
+    /*!
+     * \brief Constructor, the socket is opened by `start`.
+     *
+     * \param address:   "unix:<path>", "tcp:<port>" or "tcp:127.0.0.1:<port>".
+     * \param reporters: the reporters to drain.
+     */
+    Exporter_metrics(const std::string& address, const std::vector<std::unique_ptr<tools::Reporter>>& reporters);
+
+    /*!
+     * \brief Destructor, stops the server and closes the socket.
+     */
+    virtual ~Exporter_metrics();
+
+    /*!
+     * \brief Serves the statistics of the tasks of all the replicas of a sequence (label `sequence="<name>"`).
+     */
+    void register_sequence(runtime::Sequence& sequence, const std::string& name);
+
+    /*!
+     * \brief Serves the statistics of the tasks of all the stages of a pipeline, the counters of its synchronizations
+     * (if `set_synchro_telemetry(true)`) and its end-to-end latency (if `set_latency_tracking(true)`), with the label
+     * `pipeline="<name>"`.
+     */
+    void register_pipeline(runtime::Pipeline& pipeline, const std::string& name);
+
+    /*!
+     * \brief Opens the socket and starts the background thread that serves the metrics.
+     */
+    void start();
+
+    /*!
+     * \brief Stops the background thread (if any) and closes the socket.
+     */
+    void stop();
+
+    /*!
+     * \brief Builds the current metrics in the Prometheus text format (also called by the server thread).
+     */
+    std::string scrape();
+
+    const std::string& get_address() const;
+
+    size_t get_n_scrapes() const;
+
+  protected:
+    // samples of a metric family, they are grouped after the HELP and TYPE lines of the family
+    struct family_t
+    {
+        std::string name;
+        std::string help;
+        std::string type;
+        std::vector<std::string> samples;
+    };
+
+    static void add_sample(std::vector<family_t>& families,
+                           const std::string& name,
+                           const std::string& help,
+                           const std::string& type,
+                           const std::string& labels,
+                           const double value,
+                           const std::string& suffix = ""); // '_sum' and '_count' samples of the summaries
+
+    void scrape_probes(std::vector<family_t>& families);
+    void scrape_tasks(std::vector<family_t>& families,
+                      const std::string& labels,
+                      const std::vector<std::vector<runtime::Task*>>& tasks_per_threads);
+    void scrape_pipeline(std::vector<family_t>& families, const std::string& labels, runtime::Pipeline& pipeline);
+
+  private:
+    static void start_thread_server(Exporter_metrics* exporter);
+};
+}
+}
+
+#endif /* EXPORTER_METRICS_HPP_ */
@@ -0,0 +1,141 @@
+/*!
+ * \file
+ * \brief Class tools::Exporter_probe.
+ */
+#ifndef EXPORTER_PROBE_HPP_
+#define EXPORTER_PROBE_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
+
+#include "Tools/Reporter/Reporter.hpp"
+
+namespace aff3ct
+{
+namespace tools
+{
+/*!
+ * \class Exporter_probe
+ *
+ * \brief Streams the values of the reporters into an append-only binary columnar file.
+ *
+ * The file starts with a fixed header (magic number, version, and for each column: its group name, its name, its unit,
+ * its datatype and the number of elements per value). It is followed by blocks, each block contains the number of
+ * values drained from each column and then the raw values of each column stored contiguously. All the integers are
+ * written in the native byte order. The reporters have to support typed snapshots (see `Reporter::snapshot`) and
+ * should not be drained by another consumer (like a `Terminal`) at the same time. The file can be read back with
+ * `Exporter_probe_reader`.
+ */
+class Exporter_probe
+{
+  public:
+    static const char magic[8];
+    static const uint32_t version;
+    static const uint32_t block_magic;
+
+  private:
+    std::thread exp_thread;
+    std::mutex mutex_exporter;
+    std::condition_variable cond_exporter;
+    bool stop_exporter;
+    std::exception_ptr exp_exception; // exception thrown by the background thread, rethrown by 'stop'
+
+  protected:
+    std::vector<tools::Reporter*> reporters;
+    std::vector<Reporter::snapshot_t> snapshots;
+    std::string filepath;
+    std::ofstream file;
+    std::mutex mutex_file;
+    bool header_written;
+    size_t n_columns;
+    size_t n_blocks;
+    size_t n_values;
+
+  public:
+    /*!
+     * \brief Constructor, the file is truncated.
+     *
+     * \param filepath:  path to the binary file to write.
+     * \param reporters: the reporters to drain.
+     */
+    Exporter_probe(const std::string& filepath, const std::vector<tools::Reporter*>& reporters);
+
+    /*!
+     * \brief Constructor, the file is truncated.
+     *
+     * \param filepath:  path to the binary file to write.
+     * \param reporters: the reporters to drain.
+     */
+    Exporter_probe(const std::string& filepath, const std::vector<std::unique_ptr<tools::Reporter>>& reporters);
+
+    /*!
+     * \brief Destructor, stops the background thread and drains the remaining values.
+     */
+    virtual ~Exporter_probe();
+
+    /*!
+     * \brief Starts a background thread that drains the reporters periodically.
+     *
+     * The reporters are drained once by the caller thread before: the reporters without typed snapshots and the
+     * unsupported datatypes are reported here.
+     *
+     * \param freq: the drain period, it has to be short enough for the reporters buffers not to overflow.
+     */
+    void start(const std::chrono::milliseconds freq = std::chrono::milliseconds(10));
+
+    /*!
+     * \brief Stops the background thread (if any) and drains the remaining values, the exception thrown by the
+     * background thread (if any) is rethrown.
+     */
+    void stop();
+
+    /*!
+     * \brief Drains the values currently buffered in the reporters and appends them to the file as a new block.
+     */
+    void flush();
+
+    const std::string& get_filepath() const;
+
+    size_t get_n_blocks() const;
+
+    size_t get_n_values() const;
+
+  protected:
+    void write_header();
+
+  private:
+    static void start_thread_exporter(Exporter_probe* exporter, const std::chrono::milliseconds freq);
+};
+
+/*!
+ * \brief Gets the code of a datatype stored in the columnar file.
+ */
+uint8_t
+exporter_datatype_to_code(const std::type_index& datatype);
+
+/*!
+ * \brief Gets the datatype from its code stored in the columnar file.
+ */
+std::type_index
+exporter_code_to_datatype(const uint8_t code);
+
+/*!
+ * \brief Gets the size (in bytes) of a datatype from its code stored in the columnar file.
+ */
+size_t
+exporter_code_to_size(const uint8_t code);
+}
+}
+
+#endif /* EXPORTER_PROBE_HPP_ */
@@ -0,0 +1,104 @@
+/*!
+ * \file
+ * \brief Class tools::Exporter_probe_reader.
+ */
+#ifndef EXPORTER_PROBE_READER_HPP_
+#define EXPORTER_PROBE_READER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace aff3ct
+{
+namespace tools
+{
+/*!
+ * \class Exporter_probe_reader
+ *
+ * \brief Reads the binary columnar files written by `Exporter_probe`.
+ *
+ * An incomplete trailing block (when the file is still written or when the writer was interrupted) is ignored.
+ */
+class Exporter_probe_reader
+{
+  public:
+    struct column_t
+    {
+        std::string group;
+        std::string name;
+        std::string unit;
+        std::type_index datatype;
+        size_t data_size; // number of elements per value
+        size_t n_values;
+
+        column_t()
+          : datatype(typeid(void))
+          , data_size(0)
+          , n_values(0)
+        {
+        }
+    };
+
+  protected:
+    std::string filepath;
+    bool mapped;
+    std::vector<uint8_t> content;
+    const uint8_t* data;
+    size_t size;
+    std::vector<column_t> columns;
+    std::vector<std::vector<std::pair<size_t, size_t>>> blocks; // for each block and each column: (offset, n_values)
+
+  public:
+    /*!
+     * \brief Constructor, parses the header and indexes the blocks.
+     *
+     * \param filepath: path to the binary file to read.
+     * \param use_mmap: memory-map the file instead of loading it (if the system supports it).
+     */
+    explicit Exporter_probe_reader(const std::string& filepath, const bool use_mmap = true);
+
+    virtual ~Exporter_probe_reader();
+
+    Exporter_probe_reader(const Exporter_probe_reader&) = delete;
+
+    Exporter_probe_reader& operator=(const Exporter_probe_reader&) = delete;
+
+    const std::vector<column_t>& get_columns() const;
+
+    size_t get_n_blocks() const;
+
+    bool is_mapped() const;
+
+    /*!
+     * \brief Gets the index of a column from its name (and optionally from its group name).
+     */
+    size_t get_column_id(const std::string& name, const std::string& group = "") const;
+
+    /*!
+     * \brief Reads all the values of a column ('n_values * data_size' contiguous elements), 'T' has to match the
+     * datatype of the column.
+     */
+    template<typename T>
+    std::vector<T> read_column(const size_t col) const;
+
+    template<typename T>
+    std::vector<T> read_column(const std::string& name, const std::string& group = "") const;
+
+  protected:
+    void parse();
+
+    void check_column(const size_t col, const std::type_index& datatype) const;
+};
+}
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+#include "Tools/Display/Exporter/Exporter_probe_reader.hxx"
+#endif
+
+#endif /* EXPORTER_PROBE_READER_HPP_ */
@@ -0,0 +1,40 @@
+#include <cstring>
+
+#include "Tools/Display/Exporter/Exporter_probe_reader.hpp"
+
+namespace aff3ct
+{
+namespace tools
+{
+
+template<typename T>
+std::vector<T>
+Exporter_probe_reader::read_column(const size_t col) const
+{
+    this->check_column(col, typeid(T));
+
+    const size_t value_bytes = this->columns[col].data_size * sizeof(T);
+    std::vector<T> values(this->columns[col].n_values * this->columns[col].data_size);
+    size_t n = 0;
+    for (auto& block : this->blocks)
+    {
+        const auto offset = block[col].first;
+        const auto n_block_values = block[col].second;
+        if (n_block_values)
+            std::memcpy((void*)(values.data() + n * this->columns[col].data_size),
+                        (const void*)(this->data + offset),
+                        n_block_values * value_bytes);
+        n += n_block_values;
+    }
+    return values;
+}
+
+template<typename T>
+std::vector<T>
+Exporter_probe_reader::read_column(const std::string& name, const std::string& group) const
+{
+    return this->read_column<T>(this->get_column_id(name, group));
+}
+
+}
+}
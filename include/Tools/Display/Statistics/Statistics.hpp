@@ -12,11 +12,18 @@
 #include <string>
 #include <vector>
 
+#include "Module/Adaptor/Adaptor.hpp"
 #include "Module/Module.hpp"
 #include "Runtime/Task/Task.hpp"
+#include "Tools/Algo/Histogram/Latency_histogram.hpp"
+#include "Tools/Profiler/Profiler.hpp"
 
 namespace aff3ct
 {
+namespace runtime
+{
+class Pipeline;
+}
 namespace tools
 {
 class Statistics
@@ -38,6 +45,22 @@ class Statistics
                      const bool display_thr = true,
                      std::ostream& stream = std::cout);
 
+    // display the residence time in each synchronization buffer and the end-to-end latency of the frames (requires
+    // 'pipeline.set_latency_tracking(true)')
+    static void show_latency(runtime::Pipeline& pipeline, std::ostream& stream = std::cout);
+
+    // display the occupancy of the synchronization buffers and the time spent by the replicas to wait for a slot,
+    // the stage that waits the least is the probable bottleneck (requires 'pipeline.set_synchro_telemetry(true)')
+    static void show_synchro(runtime::Pipeline& pipeline, std::ostream& stream = std::cout);
+
+    // display the end-of-run analysis of the pipeline: throughput and capacity of each stage, utilization of the
+    // replicas, bottleneck stage and estimated throughput with one more replica in the bottleneck stage
+    static void show_analysis(runtime::Pipeline& pipeline, std::ostream& stream = std::cout);
+
+    // display the samples of a profiler: for each stage, the tasks sorted by number of samples (all the replicas
+    // together), the samples out of the tasks ('idle') and the samples of each replica in the tasks ('busy')
+    static void show_profile(const Profiler& profiler, std::ostream& stream = std::cout);
+
   private:
     template<class MODULE = const module::Module>
     static void show_modules(std::vector<MODULE*> modules,
@@ -86,6 +109,52 @@ class Statistics
                            const std::chrono::nanoseconds timer_min_duration,
                            const std::chrono::nanoseconds timer_max_duration,
                            std::ostream& stream = std::cout);
+
+    static void show_perf_header(std::ostream& stream = std::cout);
+
+    static void show_latency_header(std::ostream& stream = std::cout);
+
+    static void show_synchro_header(std::ostream& stream = std::cout);
+
+    static void show_synchro_side(const std::string& adaptor_name,
+                                  const std::string& stages,
+                                  const std::string& side,
+                                  const std::vector<module::Adaptor::telemetry_t>& telemetry,
+                                  std::ostream& stream = std::cout);
+
+    static void show_analysis_header(std::ostream& stream = std::cout);
+
+    static void show_analysis_row(const std::string& stage,
+                                  const std::string& replica,
+                                  const uint64_t n_frames,
+                                  const std::chrono::nanoseconds busy,
+                                  const std::chrono::nanoseconds waiting,
+                                  const std::chrono::nanoseconds exec_duration,
+                                  const double throughput,
+                                  const double capacity,
+                                  std::ostream& stream = std::cout);
+
+    static void show_profile_header(std::ostream& stream = std::cout);
+
+    static void show_profile_row(const std::string& stage,
+                                 const std::string& replica,
+                                 const std::string& task,
+                                 const uint64_t n_samples,
+                                 const uint64_t n_stage_samples,
+                                 const std::chrono::nanoseconds estimated_time,
+                                 std::ostream& stream = std::cout);
+
+    static void show_latency_histogram(const std::string& adaptor_name,
+                                       const std::string& stages,
+                                       const std::string& type,
+                                       const Latency_histogram& histogram,
+                                       std::ostream& stream = std::cout);
+
+    static void show_perf_task(const std::string& module_sname,
+                               const std::string& task_name,
+                               const uint64_t task_n_frames,
+                               const std::vector<uint64_t>& task_perf_total,
+                               std::ostream& stream = std::cout);
 };
 
 using Stats = Statistics;
@@ -38,6 +38,7 @@ class Terminal_std : public Terminal
 
   protected:
     std::vector<tools::Reporter*> reporters;
+    std::vector<Reporter::snapshot_t> snapshots;
 
   public:
     /*!
@@ -67,6 +68,12 @@ class Terminal_std : public Terminal
   protected:
     virtual void report(std::ostream& stream = std::cout, bool final = false);
 
+    /*!
+     * \brief Gets the formatted report of the reporter 'r', the values are formatted by the terminal from a typed
+     * snapshot when the reporter supports it.
+     */
+    Reporter::report_t collect_report(const size_t r, bool final);
+
     static unsigned extra_spaces(const Reporter::title_t& text, const unsigned group_width);
     static unsigned extra_spaces(const Reporter::group_t& group);
     static unsigned get_group_width(const Reporter::group_t& group);
@@ -5,17 +5,61 @@
 #ifndef INTERFACE_IS_DONE_HPP__
 #define INTERFACE_IS_DONE_HPP__
 
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
 namespace aff3ct
 {
 namespace tools
 {
 class Interface_is_done
 {
+  private:
+    // flags set when the module becomes done (the stop tokens of the sequences executing the module)
+    std::vector<std::atomic<bool>*> done_flags;
+
   public:
+    Interface_is_done() = default;
+
+    // the flags are registered by the executing sequence, they are not copied to the clones
+    Interface_is_done(const Interface_is_done&)
+      : done_flags()
+    {
+    }
+
+    Interface_is_done& operator=(const Interface_is_done&) { return *this; }
+
+    virtual ~Interface_is_done() = default;
+
     virtual bool is_done() const = 0;
+
+    // true if the module calls 'notify_done' when it becomes done, otherwise the sequences have to call 'is_done'
+    // after each execution
+    virtual bool is_notifying_done() const { return false; }
+
+    // the flag is set immediately if the module is already done
+    void register_done_flag(std::atomic<bool>* flag)
+    {
+        this->done_flags.push_back(flag);
+        if (this->is_done()) flag->store(true, std::memory_order_relaxed);
+    }
+
+    void unregister_done_flag(std::atomic<bool>* flag)
+    {
+        this->done_flags.erase(std::remove(this->done_flags.begin(), this->done_flags.end(), flag),
+                               this->done_flags.end());
+    }
+
+  protected:
+    void notify_done()
+    {
+        for (auto flag : this->done_flags)
+            flag->store(true, std::memory_order_relaxed);
+    }
 };
 
 }
 }
 
-#endif // INTERFACE_CLONE_HPP__
\ No newline at end of file
+#endif // INTERFACE_CLONE_HPP__
@@ -0,0 +1,127 @@
+/*!
+ * \file
+ * \brief Class tools::Profiler.
+ */
+#ifndef PROFILER_HPP_
+#define PROFILER_HPP_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace aff3ct
+{
+namespace runtime
+{
+class Task;
+class Sequence;
+class Pipeline;
+}
+namespace tools
+{
+/*!
+ * \class Profiler
+ *
+ * \brief Statistical profiler of the tasks executed by the threads of a sequence or of the stages of a pipeline.
+ *
+ * A watcher thread periodically reads the task currently executed by each active thread (see
+ * `Sequence::get_current_task`) and counts the samples per stage, per replica and per task. The threads of the
+ * sequences are never interrupted and the tasks statistics do not need to be enabled: the only cost on the processing
+ * threads is the relaxed store of the current task before each task execution. The time spent in a task is estimated
+ * from its number of samples and from the sampling duration, the precision depends on the number of rounds.
+ */
+class Profiler
+{
+  private:
+    std::thread prof_thread;
+    std::mutex mutex_profiler;
+    std::condition_variable cond_profiler;
+    bool stop_profiler;
+
+  protected:
+    std::vector<runtime::Sequence*> stages;
+    // tasks of each replica of each stage (in the 'get_tasks_per_threads' order) and their index
+    std::vector<std::vector<std::vector<runtime::Task*>>> tasks;
+    std::vector<std::vector<std::map<const runtime::Task*, size_t>>> tasks_id;
+    // number of samples per task of each replica of each stage, and number of samples out of the tasks
+    std::vector<std::vector<std::vector<uint64_t>>> samples;
+    std::vector<std::vector<uint64_t>> idle;
+    uint64_t n_rounds;
+    std::chrono::time_point<std::chrono::steady_clock> t_first_round;
+    std::chrono::nanoseconds duration;
+    mutable std::mutex mutex_samples;
+
+  public:
+    /*!
+     * \brief Constructor, profiles the threads of a sequence (one stage).
+     */
+    explicit Profiler(runtime::Sequence& sequence);
+
+    /*!
+     * \brief Constructor, profiles the threads of all the stages of a pipeline.
+     */
+    explicit Profiler(runtime::Pipeline& pipeline);
+
+    /*!
+     * \brief Destructor, stops the watcher thread.
+     */
+    virtual ~Profiler();
+
+    /*!
+     * \brief Starts the watcher thread, it takes one sample of each active thread every `period`.
+     */
+    void start(const std::chrono::microseconds period = std::chrono::microseconds(1000));
+
+    /*!
+     * \brief Stops the watcher thread (the samples are kept).
+     */
+    void stop();
+
+    /*!
+     * \brief Takes one sample of each active thread (also called by the watcher thread).
+     */
+    void sample();
+
+    /*!
+     * \brief Clears the samples.
+     */
+    void reset();
+
+    size_t get_n_stages() const;
+
+    // number of replicas allocated in the stage (only the active ones are sampled)
+    size_t get_n_replicas(const size_t stage_id) const;
+
+    const std::vector<runtime::Task*>& get_tasks(const size_t stage_id, const size_t replica_id) const;
+
+    // number of samples of the task 'task_id' (index in 'get_tasks(stage_id, replica_id)')
+    uint64_t get_n_samples(const size_t stage_id, const size_t replica_id, const size_t task_id) const;
+
+    // number of samples where the replica was not executing a task (before, between or after the 'exec' calls)
+    uint64_t get_n_idle_samples(const size_t stage_id, const size_t replica_id) const;
+
+    uint64_t get_n_rounds() const;
+
+    // time elapsed between the first and the last rounds
+    std::chrono::nanoseconds get_duration() const;
+
+    // estimated time spent in the task, from its share of the samples of the replica
+    std::chrono::nanoseconds get_estimated_time(const size_t stage_id,
+                                                const size_t replica_id,
+                                                const size_t task_id) const;
+
+  protected:
+    void init();
+
+  private:
+    static void start_thread_profiler(Profiler* profiler, const std::chrono::microseconds period);
+};
+}
+}
+
+#endif /* PROFILER_HPP_ */
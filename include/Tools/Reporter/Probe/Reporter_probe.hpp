@@ -55,6 +55,8 @@ class Reporter_probe : public Reporter
 
     virtual report_t report(bool final = false);
 
+    virtual bool snapshot(snapshot_t& snap, bool final = false);
+
     virtual void reset();
 
     void set_n_frames(const size_t n_frames);
@@ -97,11 +99,9 @@ class Reporter_probe : public Reporter
     template<typename T>
     bool pull(const int col, T* data);
 
-    size_t get_probe_index(const module::AProbe& prb);
+    bool pull(const int col, column_t& column, const size_t row);
 
-  private:
-    template<typename T>
-    bool format_values(const int col, std::stringstream& temp_stream);
+    size_t get_probe_index(const module::AProbe& prb);
 };
 }
 }
@@ -5,8 +5,13 @@
 #ifndef REPORTER_HPP__
 #define REPORTER_HPP__
 
+#include <cstddef>
+#include <cstdint>
+#include <ios>
 #include <string>
 #include <tuple>
+#include <typeindex>
+#include <typeinfo>
 #include <utility>
 #include <vector>
 
@@ -26,6 +31,42 @@ class Reporter : public Interface_reset
 
     using report_t = std::vector<std::vector<std::string>>;
 
+    /*
+     * Typed and unformatted values of one column: 'n_rows' rows of 'data_size' elements of type 'datatype' stored
+     * contiguously in 'data', 'valid[r]' is false when no value was available for the row 'r'
+     */
+    struct column_t
+    {
+        std::type_index datatype;
+        size_t data_size;
+        size_t n_rows;
+        std::ios_base::fmtflags fmtflags;
+        size_t precision;
+        std::vector<uint8_t> valid;
+        std::vector<int8_t> data;
+
+        column_t()
+          : datatype(typeid(void))
+          , data_size(0)
+          , n_rows(0)
+          , fmtflags(std::ios_base::dec)
+          , precision(0)
+        {
+        }
+
+        template<typename T>
+        inline const T* get_data(const size_t row = 0) const
+        {
+            return reinterpret_cast<const T*>(this->data.data()) + row * this->data_size;
+        }
+    };
+
+    /*
+     * A snapshot is as long as the number of groups (cols_groups.size()) with each sub vector as long as the number
+     * of columns of the matching group (cols_groups[i].second.size())
+     */
+    using snapshot_t = std::vector<std::vector<column_t>>;
+
   protected:
     std::vector<group_t> cols_groups;
 
@@ -40,6 +81,18 @@ class Reporter : public Interface_reset
      */
     virtual report_t report(bool final = false) = 0;
 
+    /*
+     * Fill 'snap' with the raw values that 'report' would have formatted, the buffers of 'snap' are reused from one
+     * call to another. Return false if the reporter does not support typed snapshots (default behavior).
+     */
+    virtual bool snapshot(snapshot_t& snap, bool final = false);
+
+    /*
+     * Format a typed snapshot into text (one string per value of each column of each row), the size of 'report'
+     * matches the number of groups of 'snap'
+     */
+    static void format(const snapshot_t& snap, report_t& report);
+
     virtual void init(); // do nothing by default
 
     virtual void reset();
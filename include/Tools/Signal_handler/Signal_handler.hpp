@@ -1,6 +1,8 @@
 #ifndef SIGNAL_HANDLER_HPP_
 #define SIGNAL_HANDLER_HPP_
 
+#include <atomic>
+
 namespace aff3ct
 {
 namespace tools
@@ -13,6 +15,11 @@ class Signal_handler
     static bool is_sigsegv();
     static void reset_sigint();
     static void reset_sigsegv();
+
+    // the registered flags are set when the SIGINT signal is caught (used as stop tokens by the sequences), returns
+    // false if the flag cannot be registered (too many registered flags), then 'is_sigint' has to be polled
+    static bool register_sigint_flag(std::atomic<bool>* flag);
+    static void unregister_sigint_flag(std::atomic<bool>* flag);
 };
 }
 }
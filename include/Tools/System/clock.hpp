@@ -0,0 +1,81 @@
+/*!
+ * \file
+ * \brief Low overhead clocks utilities (used by the task statistics).
+ */
+#ifndef SYSTEM_CLOCK_HPP__
+#define SYSTEM_CLOCK_HPP__
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#define AFF3CT_CORE_CLOCK_TSC_X86
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+#define AFF3CT_CORE_CLOCK_TSC_ARM64
+#endif
+
+namespace aff3ct
+{
+namespace tools
+{
+enum class clock_source_t : uint8_t
+{
+    STEADY, // 'std::chrono::steady_clock'
+    TSC     // time stamp counter ('rdtsc' on x86, 'cntvct_el0' on ARMv8), falls back on STEADY when unavailable
+};
+
+// returns true if the time stamp counter can be used (on x86 the TSC has to be invariant)
+bool
+clock_tsc_is_available();
+
+// calibrates the conversion of the time stamp counter ticks into nanoseconds (the calibration takes a few
+// milliseconds, it is performed once and it is automatically called by 'clock_tsc_to_ns' if needed)
+void
+clock_tsc_calibrate();
+
+std::chrono::nanoseconds
+clock_tsc_to_ns(const uint64_t ticks);
+
+inline uint64_t
+clock_tsc_now()
+{
+#if defined(AFF3CT_CORE_CLOCK_TSC_X86)
+    return (uint64_t)__rdtsc();
+#elif defined(AFF3CT_CORE_CLOCK_TSC_ARM64)
+    uint64_t ticks;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+// returns a time point in ticks of the given 'source' (in nanoseconds for the STEADY clock)
+inline uint64_t
+clock_now(const clock_source_t source)
+{
+    if (source == clock_source_t::TSC) return clock_tsc_now();
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+// returns the duration elapsed since 't_start' (given by 'clock_now' with the same 'source')
+inline std::chrono::nanoseconds
+clock_elapsed(const clock_source_t source, const uint64_t t_start)
+{
+    const uint64_t t_stop = clock_now(source);
+    if (source == clock_source_t::TSC) return clock_tsc_to_ns(t_stop - t_start);
+    return std::chrono::nanoseconds(t_stop - t_start);
+}
+}
+}
+
+#endif /* SYSTEM_CLOCK_HPP__ */
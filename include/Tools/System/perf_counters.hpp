@@ -0,0 +1,43 @@
+/*!
+ * \file
+ * \brief Per-thread performance counters utilities (based on 'perf_event_open' on Linux).
+ */
+#ifndef SYSTEM_PERF_COUNTERS_HPP__
+#define SYSTEM_PERF_COUNTERS_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace aff3ct
+{
+namespace tools
+{
+enum class perf_event_t : uint8_t
+{
+    CYCLES = 0,       // hardware
+    INSTRUCTIONS,     // hardware
+    CACHE_MISSES,     // hardware
+    BRANCH_MISSES,    // hardware
+    CONTEXT_SWITCHES, // software
+    TASK_CLOCK,       // software (in nanoseconds), fallback when the hardware counters are unavailable
+};
+
+constexpr size_t perf_n_events = 6;
+
+// read the current values of the counters of the calling thread (the counters are opened on the first call of each
+// thread), 'values' has to contain 'perf_n_events' elements and the values of the unavailable events are set to 0,
+// returns false if no counter is available
+bool
+perf_counters_read(uint64_t* values);
+
+// returns true if the 'event' has been successfully opened by at least one thread
+bool
+perf_counters_is_available(const perf_event_t event);
+
+std::string
+perf_event_to_string(const perf_event_t event);
+}
+}
+
+#endif /* SYSTEM_PERF_COUNTERS_HPP__ */
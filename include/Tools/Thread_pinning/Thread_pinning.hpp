@@ -1,6 +1,7 @@
 #ifndef THREAD_PINNING_HPP
 #define THREAD_PINNING_HPP
 
+#include <memory>
 #include <string>
 
 namespace aff3ct
@@ -10,12 +11,39 @@ namespace tools
 class Thread_pinning
 {
   public:
+    // set of PUs resolved once from the topology, pinning a thread on it is a single affinity system call (no lock and
+    // no topology walk), the set is empty if the topology has not been initialized or if the pinning is not available
+    struct cpuset_t
+    {
+        std::shared_ptr<void> set; // 'hwloc_bitmap_t' or 'cpu_set_t' depending on the backend
+        std::string str;           // bitmap
+        std::string info;          // resolved objects (for the logs)
+    };
+
     static void init();
     static void destroy();
     static void pin(const size_t puid);
     static void pin(const std::string hwloc_objects);
+    static void pin(const cpuset_t& cpuset);
     static void unpin();
 
+    static cpuset_t get_cpuset(const size_t puid);
+    static cpuset_t get_cpuset(const std::string hwloc_objects);
+
+    // pinning policy of the auxiliary threads of the runtime, the threads that do not execute tasks (terminal
+    // reporting, exporters, profiler, drivers of the executor jobs), for instance the reserved core of
+    // 'Thread_pinning_utils::get_reserved_object', an empty policy disables the pinning of these threads
+    static void set_auxiliary_policy(const std::string hwloc_objects);
+    static std::string get_auxiliary_policy();
+    static void pin_auxiliary();
+
+    // real-time scheduling of the calling thread (SCHED_FIFO), returns false if the process is not permitted to do it,
+    // then the thread keeps its scheduling policy
+    static bool set_realtime(const int priority);
+    // restores the scheduling policy and priority of the calling thread saved by the last successful 'set_realtime'
+    // call, does nothing if there is no such call
+    static void unset_realtime();
+
     static std::string get_cur_cpuset_str();
 
     static void set_logs(const bool enable_logs);
@@ -0,0 +1,62 @@
+#ifndef THREAD_PINNING_TOPOLOGY_HPP
+#define THREAD_PINNING_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace aff3ct
+{
+namespace tools
+{
+/*!
+ * \class Thread_pinning_topology
+ *
+ * \brief Topology of the machine read from the Linux sysfs (packages, NUMA nodes, caches, cores and PUs), used by the
+ * native thread pinning backend when AFF3CT is not linked with the 'hwloc' library.
+ *
+ * The objects are named like in the pinning policies ("PACKAGE", "NUMA", "L3D", "L2D", "L1D", "L1I", "CORE", "PU",
+ * ...) and their logical indexes follow the hwloc convention: the PUs are sorted by package, die, core and OS index,
+ * then the other objects are sorted by their first PU. Only the PUs that are online and allowed for the process (at
+ * the construction) are kept. If the sysfs cannot be read, each allowed PU is considered as a core of a single package
+ * and of a single NUMA node.
+ */
+class Thread_pinning_topology
+{
+  protected:
+    // OS indexes of the PUs of each object of each type
+    std::map<std::string, std::vector<std::vector<size_t>>> objects;
+    // PU logical index of each OS index
+    std::map<size_t, size_t> pu_logical_indexes;
+    std::vector<size_t> allowed_cpus;
+
+  public:
+    // if 'allowed_cpus' is empty, the PUs allowed for the calling thread are used
+    explicit Thread_pinning_topology(const std::string& sysfs_path = "/sys/devices/system",
+                                     const std::vector<size_t>& allowed_cpus = {});
+
+    virtual ~Thread_pinning_topology() = default;
+
+    std::vector<std::string> get_types() const;
+
+    size_t get_n_objects(const std::string& type) const;
+
+    // OS indexes of the PUs of the object 'logical_index' of the type 'type'
+    const std::vector<size_t>& get_cpus(const std::string& type, const size_t logical_index) const;
+
+    // OS indexes of the PUs of an object of a pinning policy (ex: "L3D_1")
+    std::vector<size_t> get_cpus(const std::string& object) const;
+
+    size_t get_pu_logical_index(const size_t os_index) const;
+
+    // OS indexes of the PUs allowed for the process at the construction
+    const std::vector<size_t>& get_allowed_cpus() const;
+
+    // the cpulist format of the kernel (ex: "0-3,8,10-11")
+    static std::vector<size_t> parse_cpulist(const std::string& cpulist);
+};
+}
+}
+
+#endif /* THREAD_PINNING_TOPOLOGY_HPP */
@@ -14,6 +14,8 @@ namespace aff3ct
 {
 namespace tools
 {
+class Thread_pinning_topology;
+
 class Thread_pinning_utils
 {
   public:
@@ -25,6 +27,20 @@ class Thread_pinning_utils
 
     static std::vector<std::string> thread_parser(std::string const& hwloc_objects_thread);
 
+    // generates a 'pipeline_pinning_policy' (one PU per thread) from the number of threads of each stage and from the
+    // type of waiting of each synchronization: the threads are placed on consecutive cores of the same L3 cache (or
+    // NUMA node) stage after stage, the SMT siblings are only used when all the cores are taken and a busy-waiting
+    // thread is preferably placed next to a passive one, the last core is left for the auxiliary threads (see
+    // 'get_reserved_object') if 'reserve_core' is true and if there are at least two cores
+    static std::string generate_pipeline_policy(const Thread_pinning_topology& topology,
+                                                const std::vector<size_t>& n_threads,
+                                                const std::vector<bool>& synchro_active_waiting = {},
+                                                const bool reserve_core = true);
+
+    // object of the core left free by 'generate_pipeline_policy' with the same 'reserve_core' (ex: "CORE_7"), empty if
+    // no core is left free ('reserve_core' is false or there is only one core)
+    static std::string get_reserved_object(const Thread_pinning_topology& topology, const bool reserve_core = true);
+
 #ifdef AFF3CT_CORE_HWLOC
     static std::pair<hwloc_obj_type_t, int> str_to_hwloc_object(std::string& str_object);
 #endif
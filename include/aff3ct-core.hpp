@@ -120,6 +120,12 @@
 #ifndef UNARYOP_HPP_
 #include <Module/Unaryop/Unaryop.hpp>
 #endif
+#ifndef EXEC_HANDLE_HPP_
+#include <Runtime/Exec_handle/Exec_handle.hpp>
+#endif
+#ifndef EXECUTOR_HPP_
+#include <Runtime/Executor/Executor.hpp>
+#endif
 #ifndef PIPELINE_HPP_
 #include <Runtime/Pipeline/Pipeline.hpp>
 #endif
@@ -138,9 +144,24 @@
 #ifndef DIGRAPH_NODE_HPP_
 #include <Tools/Algo/Digraph/Digraph_node.hpp>
 #endif
+#ifndef LATENCY_HISTOGRAM_HPP_
+#include <Tools/Algo/Histogram/Latency_histogram.hpp>
+#endif
+#ifndef RELAXED_ATOMIC_HPP_
+#include <Tools/Algo/Relaxed_atomic/Relaxed_atomic.hpp>
+#endif
 #ifndef COMPUTE_BYTES_H_
 #include <Tools/compute_bytes.h>
 #endif
+#ifndef EXPORTER_METRICS_HPP_
+#include <Tools/Display/Exporter/Exporter_metrics.hpp>
+#endif
+#ifndef EXPORTER_PROBE_HPP_
+#include <Tools/Display/Exporter/Exporter_probe.hpp>
+#endif
+#ifndef EXPORTER_PROBE_READER_HPP_
+#include <Tools/Display/Exporter/Exporter_probe_reader.hpp>
+#endif
 #ifndef RANG_FORMAT_H_
 #include <Tools/Display/rang_format/rang_format.h>
 #endif
@@ -231,6 +252,9 @@
 #ifndef MATH_UTILS_H
 #include <Tools/Math/utils.h>
 #endif
+#ifndef PROFILER_HPP_
+#include <Tools/Profiler/Profiler.hpp>
+#endif
 #ifndef REPORTER_PROBE_HPP_
 #include <Tools/Reporter/Probe/Reporter_probe.hpp>
 #endif
@@ -240,12 +264,21 @@
 #ifndef SIGNAL_HANDLER_HPP_
 #include <Tools/Signal_handler/Signal_handler.hpp>
 #endif
+#ifndef SYSTEM_CLOCK_HPP__
+#include <Tools/System/clock.hpp>
+#endif
 #ifndef SYSTEM_MEMORY_HPP__
 #include <Tools/System/memory.hpp>
 #endif
+#ifndef SYSTEM_PERF_COUNTERS_HPP__
+#include <Tools/System/perf_counters.hpp>
+#endif
 #ifndef THREAD_PINNING_HPP
 #include <Tools/Thread_pinning/Thread_pinning.hpp>
 #endif
+#ifndef THREAD_PINNING_TOPOLOGY_HPP
+#include <Tools/Thread_pinning/Thread_pinning_topology.hpp>
+#endif
 #ifndef THREAD_PINNING_UTILS_HPP
 #include <Tools/Thread_pinning/Thread_pinning_utils.hpp>
 #endif
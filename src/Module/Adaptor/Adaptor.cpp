@@ -11,6 +11,7 @@ Adaptor::~Adaptor()
     (*this->buffer)[this->id].clear();
     (*this->first)[this->id] = 0;
     (*this->last)[this->id] = 0;
+    (*this->staged_last)[this->id] = 0;
 }
 
 Adaptor*
@@ -56,6 +57,8 @@ Adaptor::deep_copy(const Adaptor& m)
         throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
     }
 
+    (*this->enabled)[this->id] = true;
+    this->push_base = (*this->last)[this->id];
     this->waiting_canceled.reset(new std::atomic<bool>(m.waiting_canceled->load()));
 }
 
@@ -73,8 +76,183 @@ Adaptor::reset()
         a = 0;
     for (auto& a : *this->last.get())
         a = 0;
+    for (auto& a : *this->staged_last.get())
+        a = 0;
     this->cur_id = 0;
-    this->reset_buffer();
+    this->push_base = 0;
+    this->n_pending_push = 0;
+    this->n_pending_pull = 0;
+    this->n_batch_push = 0;
+    this->n_batch_pull = 0;
+    this->cur_meta_valid = false;
+    this->t_ingress = 0;
+    // the sequence numbers of an ordered merge restart with the next execution
+    if (this->seq_restart) *this->n_ingress = 0;
+    // the slots keep their buffers: some of them can be borrowed by the sockets from one 'exec' call to the next one
+    // (no copy mode), they are given back by 'reset_buffer'
+}
+
+void
+Adaptor::set_enabled(const bool enabled)
+{
+    if (!enabled && this->id == 0)
+    {
+        std::stringstream message;
+        message << "The adaptor of id 0 can't be disabled.";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    (*this->enabled)[this->id] = enabled;
+}
+
+bool
+Adaptor::is_enabled() const
+{
+    return (*this->enabled)[this->id];
+}
+
+void
+Adaptor::set_batch_size(const size_t batch_size)
+{
+    if (batch_size == 0)
+    {
+        std::stringstream message;
+        message << "'batch_size' has to be greater than 0 ('batch_size' = " << batch_size << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->batch_size = batch_size;
+}
+
+size_t
+Adaptor::get_batch_size() const
+{
+    return this->batch_size;
+}
+
+void
+Adaptor::set_batch_latency(const std::chrono::nanoseconds batch_latency)
+{
+    this->batch_latency = batch_latency;
+}
+
+std::chrono::nanoseconds
+Adaptor::get_batch_latency() const
+{
+    return this->batch_latency;
+}
+
+void
+Adaptor::link_push(Adaptor& push_adaptor)
+{
+    this->linked_push = &push_adaptor;
+    push_adaptor.linked_pull = this;
+}
+
+void
+Adaptor::set_latency_tracking(const bool latency_tracking)
+{
+    this->latency_tracking = latency_tracking;
+    if (latency_tracking) this->alloc_meta();
+    this->cur_meta_valid = false;
+}
+
+void
+Adaptor::alloc_meta()
+{
+    // allocate the metadata of the slots for all the replicas sharing this adaptor
+    if (this->meta->size() < this->buffer->size()) this->meta->resize(this->buffer->size());
+    for (size_t i = 0; i < this->buffer->size(); i++)
+        if ((*this->buffer)[i].size() != 0 && (*this->meta)[i].size() != this->buffer_size)
+            (*this->meta)[i].resize(this->buffer_size, frame_meta_t{ 0, 0, 0 });
+}
+
+bool
+Adaptor::is_latency_tracking() const
+{
+    return this->latency_tracking;
+}
+
+const tools::Latency_histogram&
+Adaptor::get_residence() const
+{
+    return *this->residence;
+}
+
+void
+Adaptor::set_telemetry(const bool telemetry)
+{
+    this->telemetry = telemetry;
+}
+
+bool
+Adaptor::is_telemetry() const
+{
+    return this->telemetry;
+}
+
+const Adaptor::telemetry_t&
+Adaptor::get_push_telemetry() const
+{
+    return this->tlm_push;
+}
+
+const Adaptor::telemetry_t&
+Adaptor::get_pull_telemetry() const
+{
+    return this->tlm_pull;
+}
+
+void
+Adaptor::reset_telemetry()
+{
+    this->tlm_push = telemetry_t{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 };
+    this->tlm_pull = telemetry_t{ 0, 0, 0, 0, std::chrono::nanoseconds(0), 0, 0 };
+}
+
+void
+Adaptor::set_deadline(const std::chrono::nanoseconds deadline)
+{
+    if (deadline.count() < 0)
+    {
+        std::stringstream message;
+        message << "'deadline' has to be positive or null ('deadline' = " << deadline.count() << " ns).";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->deadline = deadline;
+    if (deadline.count() > 0) this->alloc_meta();
+    this->cur_meta_valid = false;
+}
+
+std::chrono::nanoseconds
+Adaptor::get_deadline() const
+{
+    return this->deadline;
+}
+
+void
+Adaptor::set_shedding(const bool shedding)
+{
+    this->shedding = shedding;
+}
+
+bool
+Adaptor::is_shedding() const
+{
+    return this->shedding;
+}
+
+uint64_t
+Adaptor::get_n_dropped() const
+{
+    return this->n_dropped;
+}
+
+void
+Adaptor::reset_n_dropped()
+{
+    this->n_dropped = 0;
 }
 
 void
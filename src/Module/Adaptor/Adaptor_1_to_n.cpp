@@ -49,10 +49,20 @@ Adaptor_1_to_n::pull_n(const std::vector<int8_t*>& out, const size_t frame_id)
 void
 Adaptor_1_to_n::wait_push()
 {
+    // publish the pending slots before to wait, otherwise the puller could never free a slot
+    if (this->n_pending_push && this->n_free_slots(this->cur_id) <= this->n_pending_push) this->flush_push();
+    if (this->linked_pull != nullptr && this->is_full(this->cur_id)) this->linked_pull->flush_pull();
+
+    uint64_t n_checks = 0;
+    const uint64_t t_wait = this->telemetry ? this->telemetry_begin(this->tlm_push,
+                                                                    this->n_fill_slots(this->cur_id),
+                                                                    this->is_full(this->cur_id))
+                                            : 0;
+
     if (this->active_waiting)
     {
         while (this->is_full(this->cur_id) && !*this->waiting_canceled)
-            ;
+            n_checks++;
     }
     else // passive waiting
     {
@@ -60,31 +70,81 @@ Adaptor_1_to_n::wait_push()
         {
             std::unique_lock<std::mutex> lock(*this->mtx_put.get());
             (*this->cnd_put.get())
-              .wait(lock, [this]() { return !(this->is_full(this->cur_id) && !*this->waiting_canceled); });
+              .wait(lock,
+                    [this, &n_checks]()
+                    {
+                        n_checks++;
+                        return !(this->is_full(this->cur_id) && !*this->waiting_canceled);
+                    });
         }
     }
 
+    if (this->telemetry) this->telemetry_end(this->tlm_push, t_wait, n_checks, this->active_waiting);
+
     if (*this->waiting_canceled) throw tools::waiting_canceled(__FILE__, __LINE__, __func__);
 }
 
 void
 Adaptor_1_to_n::wait_pull()
 {
+    this->wait_pull_slot();
+
+    // deadline-aware shedding: the frames that already missed their deadline are released without being processed
+    while (this->shedding)
+    {
+        const auto slot = ((*this->first)[this->id] + this->n_pending_pull) % this->buffer_size;
+        if (!this->is_expired((*this->meta)[this->id][slot])) break;
+
+        this->n_dropped += this->get_n_frames();
+        this->release_pull();
+        this->wait_pull_slot();
+    }
+}
+
+void
+Adaptor_1_to_n::wait_pull_slot()
+{
+    if (this->latency_tracking) this->track_egress();
+
+    // release the pending slots before to wait, otherwise the pusher could never fill a slot
+    if (this->n_pending_pull && this->n_fill_slots(this->id) <= this->n_pending_pull) this->flush_pull();
+    if (this->linked_push != nullptr && this->is_empty(this->id)) this->linked_push->flush_push();
+
+    uint64_t n_checks = 0;
+    const uint64_t t_wait = this->telemetry ? this->telemetry_begin(this->tlm_pull,
+                                                                    this->n_fill_slots(this->id),
+                                                                    this->is_empty(this->id))
+                                            : 0;
+
     if (this->active_waiting)
     {
         while (this->is_empty(this->id) && !*this->waiting_canceled)
-            ;
+        {
+            n_checks++;
+            this->publish_staged(this->id);
+        }
     }
     else // passive waiting
     {
         if (this->is_empty(this->id) && !*this->waiting_canceled)
         {
             std::unique_lock<std::mutex> lock((*this->mtx_pull.get())[this->id]);
-            (*this->cnd_pull.get())[this->id].wait(
-              lock, [this]() { return !(this->is_empty(this->id) && !*this->waiting_canceled); });
+            auto pred = [this, &n_checks]()
+            {
+                n_checks++;
+                return !(this->is_empty(this->id) && !*this->waiting_canceled);
+            };
+            // the pusher is not notified if it stalls with a partial batch: its staged slots are published here
+            if (this->batch_latency.count() > 0)
+                while (!(*this->cnd_pull.get())[this->id].wait_for(lock, this->batch_latency, pred))
+                    this->publish_staged(this->id);
+            else
+                (*this->cnd_pull.get())[this->id].wait(lock, pred);
         }
     }
 
+    if (this->telemetry) this->telemetry_end(this->tlm_pull, t_wait, n_checks, this->active_waiting);
+
     if (this->is_empty(this->id) && *this->waiting_canceled)
         throw tools::waiting_canceled(__FILE__, __LINE__, __func__);
 }
@@ -92,35 +152,80 @@ Adaptor_1_to_n::wait_pull()
 void*
 Adaptor_1_to_n::get_empty_buffer(const size_t sid)
 {
-    return (void*)(*this->buffer)[this->cur_id][sid][(*this->last)[this->cur_id] % this->buffer_size];
+    const auto slot = (this->push_base + this->n_pending_push) % this->buffer_size;
+    return (void*)(*this->buffer)[this->cur_id][sid][slot];
 }
 
 void*
 Adaptor_1_to_n::get_filled_buffer(const size_t sid)
 {
-    return (void*)(*this->buffer)[this->id][sid][(*this->first)[this->id] % this->buffer_size];
+    const auto slot = ((*this->first)[this->id] + this->n_pending_pull) % this->buffer_size;
+    return (void*)(*this->buffer)[this->id][sid][slot];
 }
 
 void*
 Adaptor_1_to_n::get_empty_buffer(const size_t sid, void* swap_buffer)
 {
-    void* empty_buffer = (void*)(*this->buffer)[this->cur_id][sid][(*this->last)[this->cur_id] % this->buffer_size];
-    (*this->buffer)[this->cur_id][sid][(*this->last)[this->cur_id] % this->buffer_size] = (int8_t*)swap_buffer;
+    const auto slot = (this->push_base + this->n_pending_push) % this->buffer_size;
+    void* empty_buffer = (void*)(*this->buffer)[this->cur_id][sid][slot];
+    (*this->buffer)[this->cur_id][sid][slot] = (int8_t*)swap_buffer;
     return empty_buffer;
 }
 
 void*
 Adaptor_1_to_n::get_filled_buffer(const size_t sid, void* swap_buffer)
 {
-    void* filled_buffer = (void*)(*this->buffer)[this->id][sid][(*this->first)[this->id] % this->buffer_size];
-    (*this->buffer)[this->id][sid][(*this->first)[this->id] % this->buffer_size] = (int8_t*)swap_buffer;
+    const auto slot = ((*this->first)[this->id] + this->n_pending_pull) % this->buffer_size;
+    void* filled_buffer = (void*)(*this->buffer)[this->id][sid][slot];
+    (*this->buffer)[this->id][sid][slot] = (int8_t*)swap_buffer;
     return filled_buffer;
 }
 
 void
 Adaptor_1_to_n::wake_up_puller()
 {
-    (*this->last)[this->cur_id]++;
+    if (this->is_meta_tracking())
+        this->track_push(this->cur_id, (this->push_base + this->n_pending_push) % this->buffer_size);
+
+    this->n_pending_push++;
+    this->stage_push(this->cur_id);
+
+    if (++this->n_batch_push == this->batch_size)
+    {
+        this->flush_push();
+        this->n_batch_push = 0;
+        this->cur_id = this->get_next_enabled_id(this->cur_id);
+        this->push_base = (*this->last)[this->cur_id];
+    }
+    else if (this->is_batch_latency_exceeded(this->t_pending_push))
+        this->flush_push();
+}
+
+void
+Adaptor_1_to_n::wake_up_pusher()
+{
+    if (this->is_meta_tracking())
+        this->track_pull(this->id, ((*this->first)[this->id] + this->n_pending_pull) % this->buffer_size);
+
+    this->release_pull();
+}
+
+void
+Adaptor_1_to_n::release_pull()
+{
+    if (this->n_pending_pull++ == 0 && this->batch_latency.count() > 0)
+        this->t_pending_pull = std::chrono::steady_clock::now();
+
+    if (this->n_pending_pull == this->batch_size || this->is_batch_latency_exceeded(this->t_pending_pull))
+        this->flush_pull();
+}
+
+void
+Adaptor_1_to_n::flush_push()
+{
+    if (!this->n_pending_push) return;
+
+    this->publish_push(this->cur_id);
 
     if (!this->active_waiting) // passive waiting
     {
@@ -130,17 +235,15 @@ Adaptor_1_to_n::wake_up_puller()
             (*this->cnd_pull.get())[this->cur_id].notify_one();
         }
     }
-
-    do
-    {
-        this->cur_id = (this->cur_id + 1) % this->buffer->size();
-    } while ((*this->buffer)[this->cur_id].size() == 0);
 }
 
 void
-Adaptor_1_to_n::wake_up_pusher()
+Adaptor_1_to_n::flush_pull()
 {
-    (*this->first)[this->id]++;
+    if (!this->n_pending_pull) return;
+
+    (*this->first)[this->id] += this->n_pending_pull;
+    this->n_pending_pull = 0;
 
     if (!this->active_waiting) // passive waiting
     {
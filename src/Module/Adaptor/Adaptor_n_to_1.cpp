@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <limits>
+#include <sstream>
 
 #include "Module/Adaptor/Adaptor_n_to_1.hpp"
 #include "Tools/Exception/exception.hpp"
@@ -6,14 +8,107 @@
 using namespace aff3ct;
 using namespace aff3ct::module;
 
+Adaptor_n_to_1::~Adaptor_n_to_1()
+{
+    this->free_reorder_buffer();
+}
+
 Adaptor_n_to_1*
 Adaptor_n_to_1::clone() const
 {
     auto m = new Adaptor_n_to_1(*this);
     m->deep_copy(*this);
+    // the reorder buffer is owned by each adaptor
+    m->reorder_to_free.clear();
+    if (m->merge == merge_t::ORDERED) m->alloc_reorder_buffer();
     return m;
 }
 
+void
+Adaptor_n_to_1::set_merge(const merge_t merge, const size_t reorder_size)
+{
+    this->merge = merge;
+    this->reorder_size = reorder_size ? reorder_size : this->buffer_size;
+    this->next_seq = 0;
+    if (merge == merge_t::ORDERED)
+    {
+        this->alloc_meta();
+        this->alloc_reorder_buffer();
+    }
+    else
+        this->free_reorder_buffer();
+}
+
+Adaptor_n_to_1::merge_t
+Adaptor_n_to_1::get_merge() const
+{
+    return this->merge;
+}
+
+size_t
+Adaptor_n_to_1::get_reorder_size() const
+{
+    return this->merge == merge_t::ORDERED ? this->reorder_size : 0;
+}
+
+void
+Adaptor_n_to_1::alloc_reorder_buffer()
+{
+    this->free_reorder_buffer();
+    this->reorder_buffer.assign(this->reorder_size, std::vector<int8_t*>(this->n_sockets));
+    for (size_t e = 0; e < this->reorder_size; e++)
+        for (size_t s = 0; s < this->n_sockets; s++)
+        {
+            this->reorder_buffer[e][s] = new int8_t[this->get_n_frames() * this->n_bytes[s]];
+            this->reorder_to_free.push_back(this->reorder_buffer[e][s]);
+        }
+    this->reorder_meta.assign(this->reorder_size, frame_meta_t{ 0, 0, 0 });
+    this->reorder_used.assign(this->reorder_size, false);
+    this->reorder_cur = this->reorder_size;
+}
+
+void
+Adaptor_n_to_1::free_reorder_buffer()
+{
+    for (auto b : this->reorder_to_free)
+        delete[] b;
+    this->reorder_to_free.clear();
+    this->reorder_buffer.clear();
+    this->reorder_meta.clear();
+    this->reorder_used.clear();
+    this->reorder_cur = 0;
+}
+
+void
+Adaptor_n_to_1::reset()
+{
+    Adaptor::reset();
+
+    std::fill(this->reorder_used.begin(), this->reorder_used.end(), false);
+    this->reorder_cur = this->reorder_buffer.size();
+    this->next_seq = 0;
+}
+
+void
+Adaptor_n_to_1::reset_buffer()
+{
+    Adaptor::reset_buffer();
+
+    // the buffers of the reorder buffer are swapped with the slots of the replicas and with the sockets (no copy mode)
+    size_t id_buff = 0;
+    for (size_t e = 0; e < this->reorder_buffer.size(); e++)
+        for (size_t s = 0; s < this->n_sockets; s++)
+            this->reorder_buffer[e][s] = this->reorder_to_free[id_buff++];
+}
+
+void
+Adaptor_n_to_1::set_n_frames(const size_t n_frames)
+{
+    const auto old_n_frames = this->get_n_frames();
+    Adaptor::set_n_frames(n_frames);
+    if (old_n_frames != n_frames && !this->reorder_to_free.empty()) this->alloc_reorder_buffer();
+}
+
 void
 Adaptor_n_to_1::push_n(const std::vector<const int8_t*>& in, const size_t frame_id)
 {
@@ -49,10 +144,20 @@ Adaptor_n_to_1::pull_1(const std::vector<int8_t*>& out, const size_t frame_id)
 void
 Adaptor_n_to_1::wait_push()
 {
+    // publish the pending slots before to wait, otherwise the puller could never free a slot
+    if (this->n_pending_push && this->n_free_slots(this->id) <= this->n_pending_push) this->flush_push();
+    if (this->linked_pull != nullptr && this->is_full(this->id)) this->linked_pull->flush_pull();
+
+    uint64_t n_checks = 0;
+    const uint64_t t_wait = this->telemetry ? this->telemetry_begin(this->tlm_push,
+                                                                    this->n_fill_slots(this->id),
+                                                                    this->is_full(this->id))
+                                            : 0;
+
     if (this->active_waiting)
     {
         while (this->is_full(this->id) && !*this->waiting_canceled)
-            ;
+            n_checks++;
     }
     else // passive waiting
     {
@@ -60,67 +165,351 @@ Adaptor_n_to_1::wait_push()
         {
             std::unique_lock<std::mutex> lock((*this->mtx_put.get())[this->id]);
             (*this->cnd_put.get())[this->id].wait(
-              lock, [this]() { return !(this->is_full(this->id) && !*this->waiting_canceled); });
+              lock,
+              [this, &n_checks]()
+              {
+                  n_checks++;
+                  return !(this->is_full(this->id) && !*this->waiting_canceled);
+              });
         }
     }
 
+    if (this->telemetry) this->telemetry_end(this->tlm_push, t_wait, n_checks, this->active_waiting);
+
     if (*this->waiting_canceled) throw tools::waiting_canceled(__FILE__, __LINE__, __func__);
 }
 
 void
 Adaptor_n_to_1::wait_pull()
 {
+    this->wait_pull_slot();
+
+    // deadline-aware shedding: the frames that already missed their deadline are released without being processed
+    while (this->shedding && this->is_expired(this->get_pull_meta()))
+    {
+        this->n_dropped += this->get_n_frames();
+        this->release_pull();
+        this->wait_pull_slot();
+    }
+}
+
+void
+Adaptor_n_to_1::wait_pull_slot()
+{
+    if (this->latency_tracking) this->track_egress();
+    if (this->merge != merge_t::ROUND_ROBIN) return this->wait_pull_any();
+
+    // release the pending slots before to wait, otherwise the pusher could never fill a slot
+    if (this->n_pending_pull && this->n_fill_slots(this->cur_id) <= this->n_pending_pull) this->flush_pull();
+    if (this->linked_push != nullptr && this->is_empty(this->cur_id)) this->linked_push->flush_push();
+
+    uint64_t n_checks = 0;
+    const uint64_t t_wait = this->telemetry ? this->telemetry_begin(this->tlm_pull,
+                                                                    this->n_fill_slots(this->cur_id),
+                                                                    this->is_empty(this->cur_id))
+                                            : 0;
+
     if (this->active_waiting)
     {
         while (this->is_empty(this->cur_id) && !*this->waiting_canceled)
-            ;
+        {
+            n_checks++;
+            this->publish_staged(this->cur_id);
+        }
     }
     else // passive waiting
     {
         if (this->is_empty(this->cur_id) && !*this->waiting_canceled)
         {
             std::unique_lock<std::mutex> lock(*this->mtx_pull.get());
-            (*this->cnd_pull.get())
-              .wait(lock, [this]() { return !(this->is_empty(this->cur_id) && !*this->waiting_canceled); });
+            auto pred = [this, &n_checks]()
+            {
+                n_checks++;
+                return !(this->is_empty(this->cur_id) && !*this->waiting_canceled);
+            };
+            // the pusher is not notified if it stalls with a partial batch: its staged slots are published here
+            if (this->batch_latency.count() > 0)
+                while (!(*this->cnd_pull.get()).wait_for(lock, this->batch_latency, pred))
+                    this->publish_staged(this->cur_id);
+            else
+                (*this->cnd_pull.get()).wait(lock, pred);
         }
     }
 
+    if (this->telemetry) this->telemetry_end(this->tlm_pull, t_wait, n_checks, this->active_waiting);
+
     if (this->is_empty(this->cur_id) && *this->waiting_canceled)
         throw tools::waiting_canceled(__FILE__, __LINE__, __func__);
 }
 
+void
+Adaptor_n_to_1::wait_pull_any()
+{
+    const bool ordered = this->merge == merge_t::ORDERED;
+    bool ready = ordered ? this->select_ordered() : this->select_ready();
+
+    // publish the pending slots before to wait, otherwise the next stage could never free a slot
+    if (!ready && this->linked_push != nullptr) this->linked_push->flush_push();
+
+    uint64_t n_checks = 0;
+    const uint64_t t_wait =
+      this->telemetry ? this->telemetry_begin(this->tlm_pull, this->n_fill_slots(this->cur_id), !ready) : 0;
+
+    if (this->active_waiting)
+    {
+        while (!ready && !*this->waiting_canceled)
+        {
+            n_checks++;
+            this->publish_staged_all();
+            ready = ordered ? this->select_ordered() : this->select_ready();
+        }
+    }
+    else // passive waiting
+    {
+        if (!ready && !*this->waiting_canceled)
+        {
+            std::unique_lock<std::mutex> lock(*this->mtx_pull.get());
+            auto pred = [this, ordered, &ready, &n_checks]()
+            {
+                n_checks++;
+                ready = ordered ? this->select_ordered() : this->select_ready();
+                return ready || *this->waiting_canceled;
+            };
+            if (this->batch_latency.count() > 0)
+                while (!(*this->cnd_pull.get()).wait_for(lock, this->batch_latency, pred))
+                    this->publish_staged_all();
+            else
+                (*this->cnd_pull.get()).wait(lock, pred);
+        }
+    }
+
+    if (this->telemetry) this->telemetry_end(this->tlm_pull, t_wait, n_checks, this->active_waiting);
+
+    // the replicas are stopped: the frames after a missing sequence number are released anyway
+    if (!ready && ordered) ready = this->select_ordered(true);
+
+    if (!ready) throw tools::waiting_canceled(__FILE__, __LINE__, __func__);
+}
+
+void
+Adaptor_n_to_1::publish_staged_all()
+{
+    for (size_t r = 0; r < this->buffer->size(); r++)
+        if ((*this->buffer)[r].size() != 0 && (*this->enabled)[r]) this->publish_staged(r);
+}
+
+bool
+Adaptor_n_to_1::select_ready()
+{
+    // the replicas are scanned from the next one in the round-robin to be fair
+    const size_t n_replicas = this->buffer->size();
+    for (size_t k = 0; k < n_replicas; k++)
+    {
+        const size_t r = (this->cur_id + k) % n_replicas;
+        if ((*this->buffer)[r].size() != 0 && (*this->enabled)[r] && !this->is_empty(r))
+        {
+            this->cur_id = r;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool
+Adaptor_n_to_1::select_ordered(const bool skip_gap)
+{
+    // the frames of a replica are in order in its slots, so the frame 'next_seq' is in the reorder buffer or in the
+    // first filled slot of a replica, the other first slots are moved in the reorder buffer while there is room
+    const size_t n_replicas = this->buffer->size();
+    bool moved;
+    do
+    {
+        for (size_t e = 0; e < this->reorder_size; e++)
+            if (this->reorder_used[e] && this->reorder_meta[e].seq == this->next_seq)
+            {
+                this->reorder_cur = e;
+                return true;
+            }
+
+        moved = false;
+        for (size_t r = 0; r < n_replicas; r++)
+        {
+            if ((*this->buffer)[r].size() == 0 || !(*this->enabled)[r] || this->is_empty(r)) continue;
+
+            const size_t slot = (*this->first)[r] % this->buffer_size;
+            const frame_meta_t& m = (*this->meta)[r][slot];
+            if (m.seq == this->next_seq)
+            {
+                this->cur_id = r;
+                this->reorder_cur = this->reorder_size;
+                return true;
+            }
+
+            const size_t e = std::find(this->reorder_used.begin(), this->reorder_used.end(), false) -
+                             this->reorder_used.begin();
+            if (e < this->reorder_size)
+            {
+                for (size_t s = 0; s < this->n_sockets; s++)
+                    std::swap(this->reorder_buffer[e][s], (*this->buffer)[r][s][slot]);
+                this->reorder_meta[e] = m;
+                this->reorder_used[e] = true;
+                this->release_slot(r);
+                moved = true;
+            }
+        }
+    } while (moved);
+
+    if (skip_gap)
+    {
+        uint64_t min_seq = std::numeric_limits<uint64_t>::max();
+        for (size_t e = 0; e < this->reorder_size; e++)
+            if (this->reorder_used[e]) min_seq = std::min(min_seq, this->reorder_meta[e].seq);
+        for (size_t r = 0; r < n_replicas; r++)
+            if ((*this->buffer)[r].size() != 0 && (*this->enabled)[r] && !this->is_empty(r))
+                min_seq = std::min(min_seq, (*this->meta)[r][(*this->first)[r] % this->buffer_size].seq);
+
+        if (min_seq != std::numeric_limits<uint64_t>::max())
+        {
+            this->next_seq = min_seq;
+            return this->select_ordered(false);
+        }
+    }
+
+    return false;
+}
+
+void
+Adaptor_n_to_1::release_slot(const size_t id)
+{
+    (*this->first)[id]++;
+
+    if (!this->active_waiting) // passive waiting
+    {
+        std::lock_guard<std::mutex> lock((*this->mtx_put.get())[id]);
+        (*this->cnd_put.get())[id].notify_one();
+    }
+}
+
 void*
 Adaptor_n_to_1::get_empty_buffer(const size_t sid)
 {
-    return (void*)(*this->buffer)[this->id][sid][(*this->last)[this->id] % this->buffer_size];
+    const auto slot = (this->push_base + this->n_pending_push) % this->buffer_size;
+    return (void*)(*this->buffer)[this->id][sid][slot];
 }
 
 void*
 Adaptor_n_to_1::get_filled_buffer(const size_t sid)
 {
-    return (void*)(*this->buffer)[this->cur_id][sid][(*this->first)[this->cur_id] % this->buffer_size];
+    if (this->reorder_cur < this->reorder_buffer.size()) return (void*)this->reorder_buffer[this->reorder_cur][sid];
+
+    const auto slot = ((*this->first)[this->cur_id] + this->n_pending_pull) % this->buffer_size;
+    return (void*)(*this->buffer)[this->cur_id][sid][slot];
 }
 
 void*
 Adaptor_n_to_1::get_empty_buffer(const size_t sid, void* swap_buffer)
 {
-    void* empty_buffer = (void*)(*this->buffer)[this->id][sid][(*this->last)[this->id] % this->buffer_size];
-    (*this->buffer)[this->id][sid][(*this->last)[this->id] % this->buffer_size] = (int8_t*)swap_buffer;
+    const auto slot = (this->push_base + this->n_pending_push) % this->buffer_size;
+    void* empty_buffer = (void*)(*this->buffer)[this->id][sid][slot];
+    (*this->buffer)[this->id][sid][slot] = (int8_t*)swap_buffer;
     return empty_buffer;
 }
 
 void*
 Adaptor_n_to_1::get_filled_buffer(const size_t sid, void* swap_buffer)
 {
-    void* filled_buffer = (void*)(*this->buffer)[this->cur_id][sid][(*this->first)[this->cur_id] % this->buffer_size];
-    (*this->buffer)[this->cur_id][sid][(*this->first)[this->cur_id] % this->buffer_size] = (int8_t*)swap_buffer;
+    if (this->reorder_cur < this->reorder_buffer.size())
+    {
+        void* filled_buffer = (void*)this->reorder_buffer[this->reorder_cur][sid];
+        this->reorder_buffer[this->reorder_cur][sid] = (int8_t*)swap_buffer;
+        return filled_buffer;
+    }
+
+    const auto slot = ((*this->first)[this->cur_id] + this->n_pending_pull) % this->buffer_size;
+    void* filled_buffer = (void*)(*this->buffer)[this->cur_id][sid][slot];
+    (*this->buffer)[this->cur_id][sid][slot] = (int8_t*)swap_buffer;
     return filled_buffer;
 }
 
 void
 Adaptor_n_to_1::wake_up_puller()
 {
-    (*this->last)[this->id]++;
+    if (this->is_meta_tracking())
+        this->track_push(this->id, (this->push_base + this->n_pending_push) % this->buffer_size);
+
+    this->n_pending_push++;
+    this->stage_push(this->id);
+
+    if (this->n_pending_push == this->batch_size || this->is_batch_latency_exceeded(this->t_pending_push))
+        this->flush_push();
+}
+
+void
+Adaptor_n_to_1::wake_up_pusher()
+{
+    if (this->reorder_cur < this->reorder_buffer.size())
+    {
+        // the frame has been pulled from the reorder buffer, its slot has already been released
+        this->cur_meta = this->reorder_meta[this->reorder_cur];
+        this->cur_meta_valid = true;
+        if (this->latency_tracking)
+            this->residence->add(
+              std::chrono::nanoseconds(tools::clock_now(tools::clock_source_t::STEADY) - this->cur_meta.t_push));
+    }
+    else if (this->is_meta_tracking())
+        this->track_pull(this->cur_id, ((*this->first)[this->cur_id] + this->n_pending_pull) % this->buffer_size);
+
+    this->release_pull();
+}
+
+void
+Adaptor_n_to_1::release_pull()
+{
+    if (this->merge != merge_t::ROUND_ROBIN)
+    {
+        if (this->reorder_cur < this->reorder_buffer.size())
+        {
+            this->reorder_used[this->reorder_cur] = false;
+            this->reorder_cur = this->reorder_buffer.size();
+        }
+        else
+            this->release_slot(this->cur_id);
+
+        if (this->merge == merge_t::ORDERED)
+            this->next_seq++;
+        else
+            this->cur_id = this->get_next_enabled_id(this->cur_id);
+        return;
+    }
+
+    if (this->n_pending_pull++ == 0 && this->batch_latency.count() > 0)
+        this->t_pending_pull = std::chrono::steady_clock::now();
+
+    if (++this->n_batch_pull == this->batch_size)
+    {
+        this->flush_pull();
+        this->n_batch_pull = 0;
+        this->cur_id = this->get_next_enabled_id(this->cur_id);
+    }
+    else if (this->is_batch_latency_exceeded(this->t_pending_pull))
+        this->flush_pull();
+}
+
+const Adaptor::frame_meta_t&
+Adaptor_n_to_1::get_pull_meta() const
+{
+    if (this->reorder_cur < this->reorder_buffer.size()) return this->reorder_meta[this->reorder_cur];
+
+    const auto slot = ((*this->first)[this->cur_id] + this->n_pending_pull) % this->buffer_size;
+    return (*this->meta)[this->cur_id][slot];
+}
+
+void
+Adaptor_n_to_1::flush_push()
+{
+    if (!this->n_pending_push) return;
+
+    this->publish_push(this->id);
 
     if (!this->active_waiting) // passive waiting
     {
@@ -133,9 +522,12 @@ Adaptor_n_to_1::wake_up_puller()
 }
 
 void
-Adaptor_n_to_1::wake_up_pusher()
+Adaptor_n_to_1::flush_pull()
 {
-    (*this->first)[this->cur_id]++;
+    if (!this->n_pending_pull) return;
+
+    (*this->first)[this->cur_id] += this->n_pending_pull;
+    this->n_pending_pull = 0;
 
     if (!this->active_waiting) // passive waiting
     {
@@ -145,11 +537,6 @@ Adaptor_n_to_1::wake_up_pusher()
             (*this->cnd_put.get())[this->cur_id].notify_one();
         }
     }
-
-    do
-    {
-        this->cur_id = (this->cur_id + 1) % this->buffer->size();
-    } while ((*this->buffer)[this->cur_id].size() == 0);
 }
 
 void
@@ -34,6 +34,13 @@ Incrementer<T>::Incrementer(const size_t n_elmts, const size_t ns)
           inc._increment(t[p1s_in].template get_dataptr<const T>(), t[p1s_out].template get_dataptr<T>(), frame_id);
           return runtime::status_t::SUCCESS;
       });
+    this->create_elmtwise_codelet(
+      p1,
+      [p1s_in, p1s_out](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+      {
+          auto& inc = static_cast<Incrementer&>(m);
+          inc._increment_elmts(static_cast<const T*>(d[p1s_in]), static_cast<T*>(d[p1s_out]), n_elmts);
+      });
 
     auto& p2 = this->create_task("incrementf");
     auto p2s_fwd = this->template create_socket_fwd<T>(p2, "fwd", this->n_elmts);
@@ -45,6 +52,13 @@ Incrementer<T>::Incrementer(const size_t n_elmts, const size_t ns)
           inc._increment(t[p2s_fwd].template get_dataptr<const T>(), t[p2s_fwd].template get_dataptr<T>(), frame_id);
           return runtime::status_t::SUCCESS;
       });
+    this->create_elmtwise_codelet(
+      p2,
+      [p2s_fwd](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+      {
+          auto& inc = static_cast<Incrementer&>(m);
+          inc._increment_elmts(static_cast<const T*>(d[p2s_fwd]), static_cast<T*>(d[p2s_fwd]), n_elmts);
+      });
 }
 
 template<typename T>
@@ -104,6 +118,25 @@ Incrementer<T>::_increment(const T* in, T* out, const size_t frame_id)
     }
 }
 
+template<typename T>
+void
+Incrementer<T>::_increment_elmts(const T* in, T* out, const size_t n_elmts)
+{
+    std::chrono::time_point<std::chrono::steady_clock> t_start;
+    if (this->ns) t_start = std::chrono::steady_clock::now();
+
+    for (size_t e = 0; e < n_elmts; e++)
+        out[e] = in[e] + 1;
+
+    if (this->ns)
+    {
+        const size_t ns = (this->ns * n_elmts) / this->n_elmts;
+        std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+        while ((size_t)duration.count() < ns) // active waiting
+            duration = std::chrono::steady_clock::now() - t_start;
+    }
+}
+
 // ==================================================================================== explicit template instantiation
 template class aff3ct::module::Incrementer<int8_t>;
 template class aff3ct::module::Incrementer<uint8_t>;
@@ -1,5 +1,6 @@
 #include <cmath>
 #include <sstream>
+#include <typeinfo>
 
 #include "Module/Module.hpp"
 #include "Tools/Exception/exception.hpp"
@@ -203,6 +204,15 @@ Module::create_cdl(runtime::Task& task, std::function<int(Module& m, runtime::Ta
     this->create_codelet(task, codelet);
 }
 
+void
+Module::create_elmtwise_codelet(
+  runtime::Task& task,
+  std::function<void(Module& m, runtime::Task& t, void* const* dataptrs, const size_t n_elmts)> codelet)
+{
+    // in a constructor, the type of the module is the type of the class being constructed (not the derived one)
+    task.create_elmtwise_codelet(codelet, typeid(*this));
+}
+
 size_t
 Module::create_socket_in(runtime::Task& task,
                          const std::string& name,
@@ -34,6 +34,13 @@ Relayer<T>::Relayer(const size_t n_elmts, const size_t ns)
           rly._relay(t[p1s_in].template get_dataptr<const T>(), t[p1s_out].template get_dataptr<T>(), frame_id);
           return runtime::status_t::SUCCESS;
       });
+    this->create_elmtwise_codelet(
+      p1,
+      [p1s_in, p1s_out](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+      {
+          auto& rly = static_cast<Relayer&>(m);
+          rly._relay_elmts(static_cast<const T*>(d[p1s_in]), static_cast<T*>(d[p1s_out]), n_elmts);
+      });
 
     auto& p2 = this->create_task("relayf");
     auto p2s_fwd = this->template create_socket_fwd<T>(p2, "fwd", this->n_elmts);
@@ -45,6 +52,13 @@ Relayer<T>::Relayer(const size_t n_elmts, const size_t ns)
           rly_fwd._relay(t[p2s_fwd].template get_dataptr<const T>(), t[p2s_fwd].template get_dataptr<T>(), frame_id);
           return runtime::status_t::SUCCESS;
       });
+    this->create_elmtwise_codelet(
+      p2,
+      [p2s_fwd](Module& m, runtime::Task& t, void* const* d, const size_t n_elmts)
+      {
+          auto& rly_fwd = static_cast<Relayer&>(m);
+          rly_fwd._relay_elmts(static_cast<const T*>(d[p2s_fwd]), static_cast<T*>(d[p2s_fwd]), n_elmts);
+      });
 }
 
 template<typename T>
@@ -103,6 +117,24 @@ Relayer<T>::_relay(const T* in, T* out, const size_t frame_id)
     }
 }
 
+template<typename T>
+void
+Relayer<T>::_relay_elmts(const T* in, T* out, const size_t n_elmts)
+{
+    std::chrono::time_point<std::chrono::steady_clock> t_start;
+    if (this->ns) t_start = std::chrono::steady_clock::now();
+
+    if (in != out) std::copy(in, in + n_elmts, out);
+
+    if (this->ns)
+    {
+        const size_t ns = (this->ns * n_elmts) / this->n_elmts;
+        std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+        while ((size_t)duration.count() < ns) // active waiting
+            duration = std::chrono::steady_clock::now() - t_start;
+    }
+}
+
 // ==================================================================================== explicit template instantiation
 template class aff3ct::module::Relayer<int8_t>;
 template class aff3ct::module::Relayer<uint8_t>;
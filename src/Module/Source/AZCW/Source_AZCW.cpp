@@ -21,6 +21,13 @@ Source_AZCW<B>::clone() const
     return m;
 }
 
+template<typename B>
+bool
+Source_AZCW<B>::is_notifying_done() const
+{
+    return true; // never done
+}
+
 template<typename B>
 void
 Source_AZCW<B>::_generate(B* out_data, const size_t frame_id)
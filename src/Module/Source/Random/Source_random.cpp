@@ -21,6 +21,13 @@ Source_random<B>::clone() const
     return m;
 }
 
+template<typename B>
+bool
+Source_random<B>::is_notifying_done() const
+{
+    return true; // never done
+}
+
 template<typename B>
 void
 Source_random<B>::_generate(B* out_data, const size_t frame_id)
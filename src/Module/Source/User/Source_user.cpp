@@ -106,6 +106,13 @@ Source_user<B>::is_done() const
     return this->done;
 }
 
+template<typename B>
+bool
+Source_user<B>::is_notifying_done() const
+{
+    return true;
+}
+
 template<typename B>
 void
 Source_user<B>::_generate(B* out_data, const size_t frame_id)
@@ -117,7 +124,11 @@ Source_user<B>::_generate(B* out_data, const size_t frame_id)
     if (this->auto_reset == false)
     {
         this->src_counter = (this->src_counter + 1) % (int)this->source.size();
-        if (this->src_counter == 0) this->done = true;
+        if (this->src_counter == 0)
+        {
+            this->done = true;
+            this->notify_done();
+        }
     }
 }
 
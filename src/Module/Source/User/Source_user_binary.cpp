@@ -49,6 +49,13 @@ Source_user_binary<B>::is_done() const
     return this->done;
 }
 
+template<typename B>
+bool
+Source_user_binary<B>::is_notifying_done() const
+{
+    return true;
+}
+
 template<typename B>
 void
 Source_user_binary<B>::_generate(B* out_data, uint32_t* out_count, const size_t frame_id)
@@ -93,6 +100,7 @@ Source_user_binary<B>::_generate(B* out_data, uint32_t* out_count, const size_t
             if (!this->auto_reset && source_file.eof())
             {
                 this->done = true;
+                this->notify_done();
                 if (this->n_left + n_bytes_read * CHAR_BIT == 0)
                 {
                     if (frame_id == 0)
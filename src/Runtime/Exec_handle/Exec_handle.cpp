@@ -0,0 +1,124 @@
+#include <sstream>
+#include <utility>
+
+#include "Runtime/Exec_handle/Exec_handle.hpp"
+#include "Tools/Exception/exception.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::runtime;
+
+Exec_handle::State::State()
+  : stop_requested(false)
+  , done(false)
+  , exception(nullptr)
+{
+}
+
+Exec_handle::Exec_handle(std::function<void()> exec, std::function<void()> stop)
+  : state(new State())
+{
+    this->state->stop = std::move(stop);
+    this->driver = std::thread(&Exec_handle::run, this->state, std::move(exec));
+}
+
+Exec_handle&
+Exec_handle::operator=(Exec_handle&& other)
+{
+    if (this != &other)
+    {
+        // the execution attached to this handle is stopped before to take the other one
+        if (this->driver.joinable())
+        {
+            this->request_stop();
+            this->driver.join();
+        }
+        this->state = std::move(other.state);
+        this->driver = std::move(other.driver);
+    }
+    return *this;
+}
+
+Exec_handle::~Exec_handle()
+{
+    if (this->driver.joinable())
+    {
+        this->request_stop();
+        this->driver.join(); // the exception (if any) is lost, 'wait' has to be called to get it
+    }
+}
+
+void
+Exec_handle::run(std::shared_ptr<State> state, std::function<void()> exec)
+{
+    try
+    {
+        exec();
+    }
+    catch (...)
+    {
+        state->exception = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(state->mtx);
+        state->done = true;
+    }
+    state->cv.notify_all();
+}
+
+bool
+Exec_handle::valid() const
+{
+    return this->driver.joinable();
+}
+
+bool
+Exec_handle::is_done() const
+{
+    // the state is kept after 'wait': the execution is still reported as done
+    if (!this->state) return false;
+    std::lock_guard<std::mutex> lock(this->state->mtx);
+    return this->state->done;
+}
+
+void
+Exec_handle::request_stop()
+{
+    if (!this->valid()) return;
+    this->state->stop_requested.store(true, std::memory_order_relaxed);
+
+    // the execution is not stopped if it is over: the sequence or the pipeline could have been modified since
+    std::lock_guard<std::mutex> lock(this->state->mtx);
+    if (!this->state->done) this->state->stop();
+}
+
+bool
+Exec_handle::is_stop_requested() const
+{
+    return this->state && this->state->stop_requested.load(std::memory_order_relaxed);
+}
+
+void
+Exec_handle::wait()
+{
+    if (!this->valid())
+    {
+        std::stringstream message;
+        message << "The handle is not attached to an execution (it has never been launched or 'wait' has already been "
+                << "called).";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->driver.join();
+    auto exception = this->state->exception;
+    this->state->exception = nullptr;
+    if (exception) std::rethrow_exception(exception);
+}
+
+bool
+Exec_handle::wait_for(const std::chrono::nanoseconds timeout) const
+{
+    if (!this->state) return false;
+    std::unique_lock<std::mutex> lock(this->state->mtx);
+    return this->state->cv.wait_for(lock, timeout, [this]() { return this->state->done; });
+}
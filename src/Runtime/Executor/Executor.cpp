@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "Runtime/Executor/Executor.hpp"
+#include "Tools/Exception/exception.hpp"
+#include "Tools/Signal_handler/Signal_handler.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::runtime;
+
+Executor::Executor(const size_t n_threads, const bool thread_pinning, const std::vector<size_t>& puids)
+  : n_threads(n_threads)
+  , thread_pinning(thread_pinning)
+  , puids(puids)
+  , stop_workers(false)
+{
+    if (n_threads == 0)
+    {
+        std::stringstream message;
+        message << "'n_threads' has to be greater than 0 ('n_threads' = " << n_threads << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    if (thread_pinning && !puids.empty() && puids.size() < n_threads)
+    {
+        std::stringstream message;
+        message << "'puids.size()' has to be greater or equal to 'n_threads' ('puids.size()' = " << puids.size()
+                << ", 'n_threads' = " << n_threads << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    for (size_t w = 0; w < n_threads; w++)
+        this->workers.push_back(std::thread(&Executor::run_worker, this, w));
+}
+
+Executor::~Executor()
+{
+    {
+        // the workers execute the running sequences until their replicas see the stop token
+        std::unique_lock<std::mutex> lock(this->mtx);
+        for (auto& job : this->jobs)
+            job->sequence->request_stop();
+        this->cnd_done.wait(lock, [this]() { return this->jobs.empty(); });
+        this->stop_workers = true;
+    }
+    this->cnd_work.notify_all();
+
+    for (auto& w : this->workers)
+        w.join();
+}
+
+size_t
+Executor::get_n_threads() const
+{
+    return this->n_threads;
+}
+
+Exec_handle
+Executor::submit(Sequence& sequence, const int priority, const size_t share, std::function<bool()> stop_condition)
+{
+    if (sequence.is_part_of_pipeline)
+    {
+        std::stringstream message;
+        message << "A stage of a pipeline can't be submitted to an executor (the stages are executed by the pipeline).";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    if (share == 0)
+    {
+        std::stringstream message;
+        message << "'share' has to be greater than 0 ('share' = " << share << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // the no copy processes are generated once and reused by the next executions
+    if (sequence.is_no_copy_mode() && !sequence.no_copy_processes) sequence.gen_processes(true);
+
+    std::shared_ptr<job_t> job(new job_t());
+    job->sequence = &sequence;
+    job->user_stop_condition = std::move(stop_condition);
+    job->priority = priority;
+    job->share = share;
+    job->vtime = 0.;
+    job->busy.resize(sequence.get_n_active_threads(), false);
+    job->n_finished = 0;
+
+    // the stop token is reset before the handle exists: a stop requested on the handle cannot be lost
+    sequence.stop_token->store(false);
+    job->poll_sigint = false;
+    job->polled_donners = sequence.register_stop_token(job->poll_sigint);
+    tools::Signal_handler::reset_sigint();
+
+    job->stop_condition = job->user_stop_condition;
+    if (!job->polled_donners.empty() || job->poll_sigint)
+    {
+        // the job outlives the stop condition: it is released after the end of its replicas
+        const job_t* j = job.get();
+        job->stop_condition = [j]()
+        {
+            if (j->user_stop_condition && j->user_stop_condition()) return true;
+            for (auto donner : j->polled_donners)
+                if (donner->is_done()) return true;
+            return j->poll_sigint && tools::Signal_handler::is_sigint();
+        };
+    }
+
+    {
+        // the job is registered before the handle is returned: the destructor of the executor always waits for it
+        std::lock_guard<std::mutex> lock(this->mtx);
+
+        // a new sequence starts with the smallest virtual time of its priority, otherwise it would take all the
+        // workers until it catches up with the others
+        bool first = true;
+        for (auto& j : this->jobs)
+            if (j->priority == job->priority && (first || j->vtime < job->vtime))
+            {
+                job->vtime = j->vtime;
+                first = false;
+            }
+
+        this->jobs.push_back(job);
+    }
+    this->cnd_work.notify_all();
+
+    return Exec_handle(
+      [this, job]()
+      {
+          // the driver thread only waits for the end of the sequence, the replicas are executed by the workers
+          tools::Thread_pinning::pin_auxiliary();
+          this->wait_job(job);
+      },
+      [&sequence]() { sequence.request_stop(); });
+}
+
+void
+Executor::wait_job(std::shared_ptr<job_t> job)
+{
+    auto& sequence = *job->sequence;
+
+    {
+        std::unique_lock<std::mutex> lock(this->mtx);
+        this->cnd_done.wait(lock, [&job]() { return job->n_finished == job->busy.size(); });
+        this->jobs.erase(std::find(this->jobs.begin(), this->jobs.end(), job));
+        // the destructor of the executor can wait for the end of the jobs, it is notified before the lock is released:
+        // the executor can be destroyed as soon as the lock is released, 'this' is not used after
+        this->cnd_done.notify_all();
+    }
+
+    sequence.unregister_stop_token();
+    sequence.give_back_buffers();
+
+    if (!sequence.prev_exception_messages_to_display.empty())
+        throw std::runtime_error(sequence.prev_exception_messages_to_display.back());
+}
+
+bool
+Executor::select(std::shared_ptr<job_t>& job, size_t& tid) const
+{
+    // the highest priority first, then the smallest virtual time (weighted fair share)
+    job.reset();
+    for (auto& j : this->jobs)
+    {
+        const auto it = std::find(j->busy.begin(), j->busy.end(), false);
+        if (it == j->busy.end()) continue;
+
+        if (!job || j->priority > job->priority || (j->priority == job->priority && j->vtime < job->vtime))
+        {
+            job = j;
+            tid = it - j->busy.begin();
+        }
+    }
+    return job != nullptr;
+}
+
+void
+Executor::run_worker(const size_t wid)
+{
+    if (this->thread_pinning) tools::Thread_pinning::pin(this->puids.empty() ? wid : this->puids[wid]);
+
+    std::unique_lock<std::mutex> lock(this->mtx);
+    while (true)
+    {
+        std::shared_ptr<job_t> job;
+        size_t tid = 0;
+        this->cnd_work.wait(lock, [this, &job, &tid]() { return this->stop_workers || this->select(job, tid); });
+        if (this->stop_workers) break;
+
+        job->busy[tid] = true;
+        lock.unlock();
+
+        const auto t_start = std::chrono::steady_clock::now();
+        const bool next = job->sequence->exec_iteration(tid, job->stop_condition);
+        const std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+
+        lock.lock();
+        job->vtime += (double)duration.count() / (double)job->share;
+        // the worker selects its next replica in the same loop, the other workers have nothing new to execute
+        if (next)
+            job->busy[tid] = false;
+        else if (++job->n_finished == job->busy.size())
+            this->cnd_done.notify_all();
+    }
+
+    if (this->thread_pinning) tools::Thread_pinning::unpin();
+}
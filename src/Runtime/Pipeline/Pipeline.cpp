@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <thread>
@@ -10,6 +11,7 @@
 #include "Runtime/Pipeline/Pipeline.hpp"
 #include "Tools/Exception/exception.hpp"
 #include "Tools/Interface/Interface_waiting.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
 #include "Tools/Thread_pinning/Thread_pinning_utils.hpp"
 
 using namespace aff3ct;
@@ -79,7 +81,12 @@ Pipeline
   saved_firsts_tasks_id(sep_stages.size()),
   saved_lasts_tasks_id(sep_stages.size()),
   bound_adaptors(false),
-  auto_stop(true)
+  auto_stop(true),
+  latency_tracking(false),
+  latency(new tools::Latency_histogram()),
+  synchro_telemetry(false),
+  deadline(0),
+  exec_duration(0)
 {
     this->init<runtime::Task>(
       firsts, lasts, sep_stages, n_threads, synchro_buffer_sizes, synchro_active_waiting, thread_pinning, puids
@@ -102,7 +109,12 @@ Pipeline
   saved_firsts_tasks_id(sep_stages.size()),
   saved_lasts_tasks_id(sep_stages.size()),
   bound_adaptors(false),
-  auto_stop(true)
+  auto_stop(true),
+  latency_tracking(false),
+  latency(new tools::Latency_histogram()),
+  synchro_telemetry(false),
+  deadline(0),
+  exec_duration(0)
 {
     std::vector<std::tuple<std::vector<runtime::Task*>, std::vector<runtime::Task*>, std::vector<runtime::Task*>>>
       sep_stages_bis;
@@ -216,7 +228,12 @@ Pipeline
   saved_firsts_tasks_id(sep_stages.size()),
   saved_lasts_tasks_id(sep_stages.size()),
   bound_adaptors(false),
-  auto_stop(true)
+  auto_stop(true),
+  latency_tracking(false),
+  latency(new tools::Latency_histogram()),
+  synchro_telemetry(false),
+  deadline(0),
+  exec_duration(0)
 {
     this->init<runtime::Task>(firsts,
 	                          lasts,
@@ -244,7 +261,12 @@ Pipeline
   saved_firsts_tasks_id(sep_stages.size()),
   saved_lasts_tasks_id(sep_stages.size()),
   bound_adaptors(false),
-  auto_stop(true)
+  auto_stop(true),
+  latency_tracking(false),
+  latency(new tools::Latency_histogram()),
+  synchro_telemetry(false),
+  deadline(0),
+  exec_duration(0)
 {
     std::vector<std::tuple<std::vector<runtime::Task*>, std::vector<runtime::Task*>, std::vector<runtime::Task*>>>
       sep_stages_bis;
@@ -565,6 +587,9 @@ void Pipeline
             throw tools::control_flow_error(__FILE__, __LINE__, __func__, message.str());
         }
         this->stages[s]->is_part_of_pipeline = true;
+        this->stages[s]->pipeline = this;
+        // all the stages except the last one are executed by a thread that ends with the stage
+        this->stages[s]->unpin_caller_thread = s == sep_stages.size() - 1;
     }
 
     // verify that the sequential sequence is equivalent to the pipeline sequence
@@ -1001,6 +1026,14 @@ Pipeline::create_adaptors(const std::vector<size_t>& synchro_buffer_sizes,
         }
         sck_to_adp_sck_id = sck_to_adp_sck_id_new;
     }
+
+    // link the pull and push adaptors executed by the same replica (required by the batched synchronizations)
+    for (size_t sta = 1; sta < this->stages.size() - 1; sta++)
+        for (size_t t = 0; t < this->stages[sta]->get_n_threads(); t++)
+        {
+            auto& adp_pull = t == 0 ? this->adaptors[sta - 1].first[0] : this->adaptors[sta - 1].second[t - 1];
+            adp_pull->link_push(*this->adaptors[sta].first[t]);
+        }
 }
 
 void
@@ -1133,11 +1166,37 @@ Pipeline::unbind_adaptors()
     this->_unbind_adaptors(true);
 }
 
+void
+Pipeline::reset_no_copy_mode()
+{
+    // all the stages give back the borrowed buffers before the slots get their own buffers back, otherwise a buffer
+    // could be shared by a slot and by a socket of another stage
+    std::vector<bool> no_copy_processes(this->stages.size());
+    for (size_t s = 0; s < this->stages.size(); s++)
+    {
+        no_copy_processes[s] = this->stages[s]->no_copy_processes;
+        if (no_copy_processes[s]) this->stages[s]->reset_no_copy_mode();
+    }
+
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+            adp->reset_buffer();
+        for (auto& adp : padps.second)
+            adp->reset_buffer();
+    }
+
+    for (size_t s = 0; s < this->stages.size(); s++)
+        if (no_copy_processes[s]) this->stages[s]->gen_processes(false);
+}
+
 void
 Pipeline::_unbind_adaptors(const bool bind_orphans)
 {
     if (this->bound_adaptors)
     {
+        this->reset_no_copy_mode();
+
         for (size_t sta = 0; sta < this->stages.size(); sta++)
         {
             const auto n_threads = this->stages[sta]->get_n_threads();
@@ -1225,6 +1284,14 @@ Pipeline::_unbind_adaptors(const bool bind_orphans)
 
 void
 Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*>&)>>& stop_conditions)
+{
+    for (auto& stage : this->stages)
+        stage->stop_token->store(false);
+    this->_exec(stop_conditions);
+}
+
+void
+Pipeline::_exec(const std::vector<std::function<bool(const std::vector<const int*>&)>>& stop_conditions)
 {
     if (stop_conditions.size() != this->stages.size() && stop_conditions.size() != 1)
     {
@@ -1241,6 +1308,9 @@ Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*
         throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
     }
 
+    this->begin_latency_tracking();
+    const auto t_start = std::chrono::steady_clock::now();
+
     auto& stages = this->stages;
     std::vector<std::thread> threads;
     for (size_t s = 0; s < stages.size() - 1; s++)
@@ -1249,12 +1319,18 @@ Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*
         if (stop_conditions.size() == this->stages.size()) stop_condition = &stop_conditions[s];
 
         threads.push_back(std::thread(
-          [&stages, s, stop_condition]()
+          [this, &stages, s, stop_condition]()
           {
+              // the driver thread runs the first replica of the stage: it is pinned by the stage if the stage has a
+              // pinning policy, it is not an auxiliary thread
               if (stop_condition)
-                  stages[s]->exec(*stop_condition);
+                  stages[s]->exec_threads(*stop_condition);
               else
-                  stages[s]->exec();
+                  stages[s]->exec_threads(std::function<bool(const std::vector<const int*>&)>());
+
+              // publish the slots of the uncompleted batches before to stop the next stage
+              for (auto& adp : this->adaptors[s].first)
+                  adp->flush_push();
 
               // send the signal to stop the next stage
               const auto& tasks = stages[s + 1]->get_tasks_per_threads();
@@ -1268,7 +1344,8 @@ Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*
                   }
           }));
     }
-    stages[stages.size() - 1]->exec(stop_conditions[stop_conditions.size() - 1]);
+    stages[stages.size() - 1]->exec_threads(stop_conditions[stop_conditions.size() - 1]);
+    this->end_latency_tracking();
     // stop all the stages before
     for (size_t notify_s = 0; notify_s < stages.size() - 1; notify_s++)
         for (auto& m : stages[notify_s]->get_modules<tools::Interface_waiting>())
@@ -1276,16 +1353,10 @@ Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*
 
     for (auto& t : threads)
         t.join();
+    this->exec_duration += std::chrono::steady_clock::now() - t_start;
 
-    // this is NOT made in the tools::Sequence::exec() to correctly flush the pipeline before restoring buffers
-    // initial configuration
-    for (auto& stage : this->stages)
-        if (stage->is_no_copy_mode())
-        {
-            stage->reset_no_copy_mode();
-            stage->gen_processes(false);
-        }
-
+    // the sockets keep the buffers borrowed to the adaptors for the next 'exec' call (no copy mode), only the state of
+    // the slots is reset
     for (auto& padps : this->adaptors)
     {
         for (auto& adp : padps.first)
@@ -1297,6 +1368,14 @@ Pipeline::exec(const std::vector<std::function<bool(const std::vector<const int*
 
 void
 Pipeline::exec(const std::vector<std::function<bool()>>& stop_conditions)
+{
+    for (auto& stage : this->stages)
+        stage->stop_token->store(false);
+    this->_exec(stop_conditions);
+}
+
+void
+Pipeline::_exec(const std::vector<std::function<bool()>>& stop_conditions)
 {
     if (stop_conditions.size() != this->stages.size() && stop_conditions.size() != 1)
     {
@@ -1313,6 +1392,9 @@ Pipeline::exec(const std::vector<std::function<bool()>>& stop_conditions)
         throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
     }
 
+    this->begin_latency_tracking();
+    const auto t_start = std::chrono::steady_clock::now();
+
     auto& stages = this->stages;
     std::vector<std::thread> threads;
     for (size_t s = 0; s < stages.size() - 1; s++)
@@ -1321,12 +1403,18 @@ Pipeline::exec(const std::vector<std::function<bool()>>& stop_conditions)
         if (stop_conditions.size() == this->stages.size()) stop_condition = &stop_conditions[s];
 
         threads.push_back(std::thread(
-          [&stages, s, stop_condition]()
+          [this, &stages, s, stop_condition]()
           {
+              // the driver thread runs the first replica of the stage: it is pinned by the stage if the stage has a
+              // pinning policy, it is not an auxiliary thread
               if (stop_condition)
-                  stages[s]->exec(*stop_condition);
+                  stages[s]->exec_threads(*stop_condition);
               else
-                  stages[s]->exec();
+                  stages[s]->exec_threads(std::function<bool()>());
+
+              // publish the slots of the uncompleted batches before to stop the next stage
+              for (auto& adp : this->adaptors[s].first)
+                  adp->flush_push();
 
               // send the signal to stop the next stage
               const auto& tasks = stages[s + 1]->get_tasks_per_threads();
@@ -1340,7 +1428,8 @@ Pipeline::exec(const std::vector<std::function<bool()>>& stop_conditions)
                   }
           }));
     }
-    stages[stages.size() - 1]->exec(stop_conditions[stop_conditions.size() - 1]);
+    stages[stages.size() - 1]->exec_threads(stop_conditions[stop_conditions.size() - 1]);
+    this->end_latency_tracking();
     // stop all the stages before
     for (size_t notify_s = 0; notify_s < stages.size() - 1; notify_s++)
         for (auto& m : stages[notify_s]->get_modules<tools::Interface_waiting>())
@@ -1348,16 +1437,10 @@ Pipeline::exec(const std::vector<std::function<bool()>>& stop_conditions)
 
     for (auto& t : threads)
         t.join();
+    this->exec_duration += std::chrono::steady_clock::now() - t_start;
 
-    // this is NOT made in the tools::Sequence::exec() to correctly flush the pipeline before restoring buffers
-    // initial configuration
-    for (auto& stage : this->stages)
-        if (stage->is_no_copy_mode())
-        {
-            stage->reset_no_copy_mode();
-            stage->gen_processes(false);
-        }
-
+    // the sockets keep the buffers borrowed to the adaptors for the next 'exec' call (no copy mode), only the state of
+    // the slots is reset
     for (auto& padps : this->adaptors)
     {
         for (auto& adp : padps.first)
@@ -1382,7 +1465,74 @@ Pipeline::exec(std::function<bool()> stop_condition)
 void
 Pipeline::exec()
 {
-    this->exec([]() { return false; });
+    this->exec(std::function<bool()>());
+}
+
+void
+Pipeline::request_stop()
+{
+    for (auto& stage : this->stages)
+        stage->request_stop();
+}
+
+Exec_handle
+Pipeline::exec_async(const std::vector<std::function<bool(const std::vector<const int*>&)>>& stop_conditions)
+{
+    if (stop_conditions.size() != this->stages.size() && stop_conditions.size() != 1)
+    {
+        std::stringstream message;
+        message << "'stop_conditions.size()' has to be equal to 'stages.size()' or to 1 ('stop_conditions.size()' = "
+                << stop_conditions.size() << ", 'stages.size()' = " << stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // the stop tokens are reset before the handle exists: a stop requested on the handle cannot be lost
+    for (auto& stage : this->stages)
+        stage->stop_token->store(false);
+    return Exec_handle(
+      [this, stop_conditions]()
+      {
+          // the driver thread runs the first replica of the last stage: it is pinned by the stage if the stage has a
+          // pinning policy, it is not an auxiliary thread
+          this->_exec(stop_conditions);
+      },
+      [this]() { this->request_stop(); });
+}
+
+Exec_handle
+Pipeline::exec_async(const std::vector<std::function<bool()>>& stop_conditions)
+{
+    if (stop_conditions.size() != this->stages.size() && stop_conditions.size() != 1)
+    {
+        std::stringstream message;
+        message << "'stop_conditions.size()' has to be equal to 'stages.size()' or to 1 ('stop_conditions.size()' = "
+                << stop_conditions.size() << ", 'stages.size()' = " << stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    for (auto& stage : this->stages)
+        stage->stop_token->store(false);
+    return Exec_handle(
+      [this, stop_conditions]() { this->_exec(stop_conditions); },
+      [this]() { this->request_stop(); });
+}
+
+Exec_handle
+Pipeline::exec_async(std::function<bool(const std::vector<const int*>&)> stop_condition)
+{
+    return this->exec_async(std::vector<std::function<bool(const std::vector<const int*>&)>>(1, stop_condition));
+}
+
+Exec_handle
+Pipeline::exec_async(std::function<bool()> stop_condition)
+{
+    return this->exec_async(std::vector<std::function<bool()>>(1, stop_condition));
+}
+
+Exec_handle
+Pipeline::exec_async()
+{
+    return this->exec_async(std::function<bool()>());
 }
 
 std::vector<std::vector<module::Module*>>
@@ -1565,6 +1715,504 @@ Pipeline::is_auto_stop() const
     return this->auto_stop;
 }
 
+void
+Pipeline::set_n_active_threads(const size_t stage_id, const size_t n_active_threads)
+{
+    if (stage_id >= this->stages.size())
+    {
+        std::stringstream message;
+        message << "'stage_id' has to be smaller than 'stages.size()' ('stage_id' = " << stage_id
+                << ", 'stages.size()' = " << this->stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    const auto n_threads = this->stages[stage_id]->get_n_threads();
+    this->stages[stage_id]->set_n_active_threads(n_active_threads);
+
+    // disable the adaptors of the inactive replicas, the round-robin of the 1 to n and n to 1 adaptors skips them
+    for (size_t t = 0; t < n_threads; t++)
+    {
+        if (stage_id > 0)
+        {
+            auto& adp_pull =
+              t == 0 ? this->adaptors[stage_id - 1].first[0] : this->adaptors[stage_id - 1].second[t - 1];
+            adp_pull->set_enabled(t < n_active_threads);
+            adp_pull->reset();
+        }
+        if (stage_id < this->stages.size() - 1)
+        {
+            auto& adp_push = this->adaptors[stage_id].first[t];
+            adp_push->set_enabled(t < n_active_threads);
+            adp_push->reset();
+        }
+    }
+}
+
+size_t
+Pipeline::get_n_active_threads(const size_t stage_id) const
+{
+    if (stage_id >= this->stages.size())
+    {
+        std::stringstream message;
+        message << "'stage_id' has to be smaller than 'stages.size()' ('stage_id' = " << stage_id
+                << ", 'stages.size()' = " << this->stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->stages[stage_id]->get_n_active_threads();
+}
+
+void
+Pipeline::set_realtime_priority(const size_t stage_id, const int priority)
+{
+    if (stage_id >= this->stages.size())
+    {
+        std::stringstream message;
+        message << "'stage_id' has to be smaller than 'stages.size()' ('stage_id' = " << stage_id
+                << ", 'stages.size()' = " << this->stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->stages[stage_id]->set_realtime_priority(priority);
+}
+
+int
+Pipeline::get_realtime_priority(const size_t stage_id) const
+{
+    if (stage_id >= this->stages.size())
+    {
+        std::stringstream message;
+        message << "'stage_id' has to be smaller than 'stages.size()' ('stage_id' = " << stage_id
+                << ", 'stages.size()' = " << this->stages.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->stages[stage_id]->get_realtime_priority();
+}
+
+void
+Pipeline::set_synchro_batch(const size_t batch_size, const std::chrono::nanoseconds batch_latency)
+{
+    // the same batch size is required on both sides of a multi-threaded stage to preserve the order of the frames
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+        {
+            adp->set_batch_size(batch_size);
+            adp->set_batch_latency(batch_latency);
+        }
+        for (auto& adp : padps.second)
+        {
+            adp->set_batch_size(batch_size);
+            adp->set_batch_latency(batch_latency);
+        }
+    }
+}
+
+size_t
+Pipeline::get_synchro_batch_size() const
+{
+    return this->adaptors.size() ? this->adaptors[0].first[0]->get_batch_size() : 1;
+}
+
+void
+Pipeline::set_synchro_merge(const module::Adaptor_n_to_1::merge_t merge, const size_t reorder_size)
+{
+    for (size_t s = 0; s < this->adaptors.size(); s++)
+        if (dynamic_cast<module::Adaptor_n_to_1*>(this->adaptors[s].first[0].get()) &&
+            this->stages[s + 1]->get_n_threads() == 1)
+            this->set_synchro_merge(s, merge, reorder_size);
+}
+
+void
+Pipeline::set_synchro_merge(const size_t sync_id,
+                            const module::Adaptor_n_to_1::merge_t merge,
+                            const size_t reorder_size)
+{
+    if (sync_id >= this->adaptors.size())
+    {
+        std::stringstream message;
+        message << "'sync_id' has to be smaller than 'adaptors.size()' ('sync_id' = " << sync_id
+                << ", 'adaptors.size()' = " << this->adaptors.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    auto adp_n_to_1 = dynamic_cast<module::Adaptor_n_to_1*>(this->adaptors[sync_id].first[0].get());
+    if (adp_n_to_1 == nullptr || this->stages[sync_id + 1]->get_n_threads() != 1)
+    {
+        std::stringstream message;
+        message << "The merge can only be set on a synchronization from a multi-threaded stage to a sequential stage "
+                << "('sync_id' = " << sync_id << ", 'stages[sync_id]->get_n_threads()' = "
+                << this->stages[sync_id]->get_n_threads() << ", 'stages[sync_id +1]->get_n_threads()' = "
+                << this->stages[sync_id + 1]->get_n_threads() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // the reorder buffer is reallocated: the buffers swapped with the slots and with the sockets are given back before
+    this->reset_no_copy_mode();
+
+    // the replicas put the sequence numbers of their frames in the slots
+    const bool ordered = merge == module::Adaptor_n_to_1::merge_t::ORDERED;
+    for (auto& adp : this->adaptors[sync_id].first)
+    {
+        adp->seq_tracking = ordered;
+        if (ordered) adp->alloc_meta();
+    }
+
+    // the frames are numbered when they are distributed to the replicas, otherwise when they enter the replicas
+    if (sync_id > 0 && dynamic_cast<module::Adaptor_1_to_n*>(this->adaptors[sync_id - 1].first[0].get()))
+    {
+        auto& padps = this->adaptors[sync_id - 1];
+        padps.first[0]->seq_restart = ordered;
+        for (auto& adp : padps.first)
+        {
+            adp->seq_tracking = ordered;
+            if (ordered) adp->alloc_meta();
+        }
+        for (auto& adp : padps.second)
+            adp->seq_tracking = ordered;
+    }
+    else // the numbering has to restart with the next 'exec' like the puller
+        this->adaptors[sync_id].first[0]->seq_restart = ordered;
+
+    adp_n_to_1->set_merge(merge, reorder_size);
+
+    // a replicated stage followed by this merge can drop a frame only if the merge is unordered
+    this->update_shedding();
+}
+
+module::Adaptor_n_to_1::merge_t
+Pipeline::get_synchro_merge(const size_t sync_id) const
+{
+    if (sync_id >= this->adaptors.size())
+    {
+        std::stringstream message;
+        message << "'sync_id' has to be smaller than 'adaptors.size()' ('sync_id' = " << sync_id
+                << ", 'adaptors.size()' = " << this->adaptors.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    auto adp_n_to_1 = dynamic_cast<const module::Adaptor_n_to_1*>(this->adaptors[sync_id].first[0].get());
+    return adp_n_to_1 != nullptr ? adp_n_to_1->get_merge() : module::Adaptor_n_to_1::merge_t::ROUND_ROBIN;
+}
+
+void
+Pipeline::set_latency_tracking(const bool latency_tracking)
+{
+    this->latency_tracking = latency_tracking;
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+            adp->set_latency_tracking(latency_tracking);
+        for (auto& adp : padps.second)
+            adp->set_latency_tracking(latency_tracking);
+    }
+
+    // the pull adaptors of the last stage account the end-to-end latency
+    if (this->adaptors.size())
+    {
+        this->adaptors.back().first[0]->latency = this->latency;
+        for (auto& adp : this->adaptors.back().second)
+            adp->latency = this->latency;
+    }
+}
+
+bool
+Pipeline::is_latency_tracking() const
+{
+    return this->latency_tracking;
+}
+
+const tools::Latency_histogram&
+Pipeline::get_latency() const
+{
+    return *this->latency;
+}
+
+const tools::Latency_histogram&
+Pipeline::get_residence(const size_t sync_id) const
+{
+    if (sync_id >= this->adaptors.size())
+    {
+        std::stringstream message;
+        message << "'sync_id' has to be smaller than 'adaptors.size()' ('sync_id' = " << sync_id
+                << ", 'adaptors.size()' = " << this->adaptors.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // the residence histogram is shared by all the replicas of the adaptor
+    return this->adaptors[sync_id].first[0]->get_residence();
+}
+
+void
+Pipeline::reset_latency()
+{
+    this->latency->reset();
+    for (auto& padps : this->adaptors)
+    {
+        padps.first[0]->residence->reset();
+        *padps.first[0]->n_ingress = 0;
+    }
+}
+
+void
+Pipeline::set_synchro_telemetry(const bool synchro_telemetry)
+{
+    this->synchro_telemetry = synchro_telemetry;
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+            adp->set_telemetry(synchro_telemetry);
+        for (auto& adp : padps.second)
+            adp->set_telemetry(synchro_telemetry);
+    }
+}
+
+bool
+Pipeline::is_synchro_telemetry() const
+{
+    return this->synchro_telemetry;
+}
+
+std::vector<module::Adaptor::telemetry_t>
+Pipeline::get_synchro_telemetry(const size_t sync_id, const bool push_side) const
+{
+    if (sync_id >= this->adaptors.size())
+    {
+        std::stringstream message;
+        message << "'sync_id' has to be smaller than 'adaptors.size()' ('sync_id' = " << sync_id
+                << ", 'adaptors.size()' = " << this->adaptors.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    std::vector<module::Adaptor::telemetry_t> telemetry;
+    if (push_side)
+        for (auto& adp : this->adaptors[sync_id].first)
+            telemetry.push_back(adp->get_push_telemetry());
+    else
+    {
+        // the first adaptor is also the pull adaptor of the first replica of the next stage
+        telemetry.push_back(this->adaptors[sync_id].first[0]->get_pull_telemetry());
+        for (auto& adp : this->adaptors[sync_id].second)
+            telemetry.push_back(adp->get_pull_telemetry());
+    }
+    return telemetry;
+}
+
+void
+Pipeline::reset_synchro_telemetry()
+{
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+            adp->reset_telemetry();
+        for (auto& adp : padps.second)
+            adp->reset_telemetry();
+    }
+}
+
+void
+Pipeline::set_deadline(const std::chrono::nanoseconds deadline)
+{
+    if (deadline.count() < 0)
+    {
+        std::stringstream message;
+        message << "'deadline' has to be positive or null ('deadline' = " << deadline.count() << " ns).";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->deadline = deadline;
+    for (auto& padps : this->adaptors)
+    {
+        for (auto& adp : padps.first)
+            adp->set_deadline(deadline);
+        for (auto& adp : padps.second)
+            adp->set_deadline(deadline);
+    }
+    this->update_shedding();
+}
+
+std::chrono::nanoseconds
+Pipeline::get_deadline() const
+{
+    return this->deadline;
+}
+
+void
+Pipeline::update_shedding()
+{
+    for (size_t s = 0; s < this->adaptors.size(); s++)
+    {
+        // the frames pulled by the stage 's +1' can be dropped if they are not expected by a round-robin or an
+        // ordered merge, the sequence numbers of an ordered merge are given after the drops of the previous stages
+        const size_t stage_id = s + 1;
+        bool shedding = this->deadline.count() > 0;
+        if (shedding && this->stages[stage_id]->get_n_threads() > 1 && stage_id < this->adaptors.size())
+            shedding = this->get_synchro_merge(stage_id) == module::Adaptor_n_to_1::merge_t::UNORDERED;
+
+        // the first adaptor is also the pull adaptor of the first replica of the next stage
+        this->adaptors[s].first[0]->set_shedding(shedding);
+        for (auto& adp : this->adaptors[s].second)
+            adp->set_shedding(shedding);
+    }
+}
+
+uint64_t
+Pipeline::get_n_dropped(const size_t sync_id) const
+{
+    if (sync_id >= this->adaptors.size())
+    {
+        std::stringstream message;
+        message << "'sync_id' has to be smaller than 'adaptors.size()' ('sync_id' = " << sync_id
+                << ", 'adaptors.size()' = " << this->adaptors.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    uint64_t n_dropped = this->adaptors[sync_id].first[0]->get_n_dropped();
+    for (auto& adp : this->adaptors[sync_id].second)
+        n_dropped += adp->get_n_dropped();
+    return n_dropped;
+}
+
+uint64_t
+Pipeline::get_n_dropped() const
+{
+    uint64_t n_dropped = 0;
+    for (size_t s = 0; s < this->adaptors.size(); s++)
+        n_dropped += this->get_n_dropped(s);
+    return n_dropped;
+}
+
+void
+Pipeline::reset_n_dropped()
+{
+    for (auto& padps : this->adaptors)
+    {
+        padps.first[0]->reset_n_dropped();
+        for (auto& adp : padps.second)
+            adp->reset_n_dropped();
+    }
+}
+
+std::chrono::nanoseconds
+Pipeline::get_exec_duration() const
+{
+    return this->exec_duration;
+}
+
+void
+Pipeline::reset_exec_duration()
+{
+    this->exec_duration = std::chrono::nanoseconds(0);
+}
+
+Pipeline::analysis_t
+Pipeline::analyze() const
+{
+    const auto n_frames = this->get_n_frames();
+    const double exec_seconds = (double)this->exec_duration.count() * 1e-9;
+
+    analysis_t analysis;
+    analysis.exec_duration = this->exec_duration;
+    analysis.stages.resize(this->stages.size());
+    for (size_t s = 0; s < this->stages.size(); s++)
+    {
+        auto& sta = analysis.stages[s];
+        const auto tasks_per_threads = this->stages[s]->get_tasks_per_threads();
+        sta.n_replicas = this->stages[s]->get_n_active_threads();
+        sta.n_frames = 0;
+        sta.n_frames_per_replica.resize(tasks_per_threads.size(), 0);
+        sta.busy.resize(tasks_per_threads.size(), std::chrono::nanoseconds(0));
+        sta.waiting.resize(tasks_per_threads.size(), std::chrono::nanoseconds(0));
+
+        std::chrono::nanoseconds busy_total(0);
+        for (size_t t = 0; t < tasks_per_threads.size(); t++)
+        {
+            uint64_t n_calls = 0;
+            for (auto tsk : tasks_per_threads[t])
+            {
+                if (!tsk->is_stats())
+                {
+                    std::stringstream message;
+                    message << "The statistics of the tasks have to be enabled ('stage' = " << s << ", 'task' = '"
+                            << tsk->get_module().get_custom_name() << "::" << tsk->get_name() << "').";
+                    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+                }
+
+                if (dynamic_cast<module::Adaptor*>(&tsk->get_module()) != nullptr)
+                    sta.waiting[t] += tsk->get_duration_total();
+                else
+                {
+                    sta.busy[t] += tsk->get_duration_total();
+                    n_calls = std::max(n_calls, (uint64_t)tsk->get_n_calls());
+                }
+            }
+            sta.n_frames_per_replica[t] = n_calls * n_frames;
+            sta.n_frames += sta.n_frames_per_replica[t];
+            busy_total += sta.busy[t];
+        }
+
+        // the capacity assumes that the replicas share the work evenly and never wait for the other stages
+        const double busy_per_frame = sta.n_frames ? (double)busy_total.count() * 1e-9 / (double)sta.n_frames : 0.;
+        sta.throughput = exec_seconds > 0. ? (double)sta.n_frames / exec_seconds : 0.;
+        sta.capacity = busy_per_frame > 0. ? (double)sta.n_replicas / busy_per_frame : 0.;
+        sta.capacity_plus_one = busy_per_frame > 0. ? (double)(sta.n_replicas + 1) / busy_per_frame : 0.;
+    }
+
+    // the stages without measured busy time (null capacity) cannot be the bottleneck
+    auto find_bottleneck = [&analysis](const size_t plus_one)
+    {
+        size_t bottleneck = 0;
+        double min_capacity = 0.;
+        for (size_t s = 0; s < analysis.stages.size(); s++)
+        {
+            const auto& sta = analysis.stages[s];
+            const double capacity = s == plus_one ? sta.capacity_plus_one : sta.capacity;
+            if (capacity > 0. && (min_capacity == 0. || capacity < min_capacity))
+            {
+                bottleneck = s;
+                min_capacity = capacity;
+            }
+        }
+        return std::make_pair(bottleneck, min_capacity);
+    };
+
+    const auto cur = find_bottleneck(this->stages.size());
+    analysis.bottleneck = cur.first;
+    analysis.throughput = analysis.stages.back().throughput;
+
+    // one more replica in the bottleneck stage: the pipeline is then limited by the new smallest capacity, the
+    // current effective throughput is scaled by the same ratio to account for the pipeline overheads
+    const auto what_if = find_bottleneck(analysis.bottleneck);
+    analysis.bottleneck_what_if = what_if.first;
+    analysis.throughput_what_if = cur.second > 0. ? analysis.throughput * what_if.second / cur.second : 0.;
+
+    return analysis;
+}
+
+void
+Pipeline::begin_latency_tracking()
+{
+    if ((!this->latency_tracking && this->deadline.count() == 0) || !this->adaptors.size()) return;
+
+    // the first frames enter the pipeline now (their deadline starts now)
+    const uint64_t now = tools::clock_now(tools::clock_source_t::STEADY);
+    for (auto& adp : this->adaptors[0].first)
+        adp->t_ingress = now;
+}
+
+void
+Pipeline::end_latency_tracking()
+{
+    if (!this->latency_tracking || !this->adaptors.size()) return;
+
+    // account the last frames when the last stage has been stopped by its stop condition (otherwise they are
+    // accounted when the replicas come back to pull a new frame)
+    this->adaptors.back().first[0]->track_egress();
+    for (auto& adp : this->adaptors.back().second)
+        adp->track_egress();
+}
+
 size_t
 Pipeline::get_n_frames() const
 {
@@ -12,6 +12,7 @@
 #include "Module/Module.hpp"
 #include "Module/Probe/Probe.hpp"
 #include "Module/Switcher/Switcher.hpp"
+#include "Runtime/Pipeline/Pipeline.hpp"
 #include "Runtime/Sequence/Sequence.hpp"
 #include "Runtime/Socket/Socket.hpp"
 #include "Runtime/Task/Task.hpp"
@@ -24,6 +25,25 @@
 using namespace aff3ct;
 using namespace aff3ct::runtime;
 
+namespace
+{
+// clears the current task of a replica (sampling profiler) when the execution leaves the scope, including when an
+// exception is thrown
+class Current_task_guard
+{
+  private:
+    std::atomic<runtime::Task*>& cur_task;
+
+  public:
+    explicit Current_task_guard(std::atomic<runtime::Task*>& cur_task)
+      : cur_task(cur_task)
+    {
+    }
+
+    ~Current_task_guard() { this->cur_task.store(nullptr, std::memory_order_relaxed); }
+};
+}
+
 Sequence::Sequence(const std::vector<const runtime::Task*>& firsts,
                    const std::vector<const runtime::Task*>& lasts,
                    const std::vector<const runtime::Task*>& exclusions,
@@ -31,28 +51,39 @@ Sequence::Sequence(const std::vector<const runtime::Task*>& firsts,
                    const bool thread_pinning,
                    const std::vector<size_t>& puids)
   : n_threads(n_threads)
+  , n_active_threads(n_threads)
   , sequences(n_threads, nullptr)
   , modules(n_threads)
   , all_modules(n_threads)
   , mtx_exception(new std::mutex())
-  , force_exit_loop(new std::atomic<bool>(false))
+  , stop_token(new std::atomic<bool>(false))
+  , current_tasks(new std::vector<current_task_t>(n_threads))
   , tasks_inplace(false)
   , thread_pinning(thread_pinning)
   , puids(puids)
   , no_copy_mode(true)
+  , no_copy_processes(false)
   , saved_exclusions(exclusions)
   , switchers_reset(n_threads)
   , auto_stop(true)
   , is_part_of_pipeline(false)
+  , pipeline(nullptr)
+  , sub_waves(false)
+  , n_frames_per_sub_wave(0)
+  , sub_waves_cache_size(256 * 1024)
+  , fusion(false)
+  , fusion_chunk_size(1024)
   , next_round_is_over(n_threads, false)
   , cur_task_id(n_threads, 0)
   , cur_ss(n_threads, nullptr)
+  , unpin_caller_thread(true)
+  , realtime_priority(0)
 {
-#ifndef AFF3CT_CORE_HWLOC
+#if !defined(AFF3CT_CORE_HWLOC) && !defined(AFF3CT_CORE_NATIVE_PINNING)
     if (thread_pinning)
         std::clog << rang::tag::warning
-                  << "AFF3CT has not been linked with the 'hwloc' library, the 'thread_pinning' "
-                     "option of the 'runtime::Sequence' will have no effect."
+                  << "AFF3CT has not been linked with the 'hwloc' library and the native pinning is not available on "
+                     "this system, the 'thread_pinning' option of the 'runtime::Sequence' will have no effect."
                   << std::endl;
 #endif
 
@@ -118,22 +149,33 @@ Sequence::Sequence(const std::vector<runtime::Task*>& firsts,
                    const std::vector<size_t>& puids,
                    const bool tasks_inplace)
   : n_threads(n_threads)
+  , n_active_threads(n_threads)
   , sequences(n_threads, nullptr)
   , modules(tasks_inplace ? n_threads - 1 : n_threads)
   , all_modules(n_threads)
   , mtx_exception(new std::mutex())
-  , force_exit_loop(new std::atomic<bool>(false))
+  , stop_token(new std::atomic<bool>(false))
+  , current_tasks(new std::vector<current_task_t>(n_threads))
   , tasks_inplace(tasks_inplace)
   , thread_pinning(thread_pinning)
   , puids(puids)
   , no_copy_mode(true)
+  , no_copy_processes(false)
   , saved_exclusions(exclusions_convert_to_const(exclusions))
   , switchers_reset(n_threads)
   , auto_stop(true)
   , is_part_of_pipeline(false)
+  , pipeline(nullptr)
+  , sub_waves(false)
+  , n_frames_per_sub_wave(0)
+  , sub_waves_cache_size(256 * 1024)
+  , fusion(false)
+  , fusion_chunk_size(1024)
   , next_round_is_over(n_threads, false)
   , cur_task_id(n_threads, 0)
   , cur_ss(n_threads, nullptr)
+  , unpin_caller_thread(true)
+  , realtime_priority(0)
 {
     if (thread_pinning && puids.size() < n_threads)
     {
@@ -205,28 +247,39 @@ Sequence::Sequence(const std::vector<const runtime::Task*>& firsts,
                    const bool thread_pinning,
                    const std::string& sequence_pinning_policy)
   : n_threads(n_threads)
+  , n_active_threads(n_threads)
   , sequences(n_threads, nullptr)
   , modules(n_threads)
   , all_modules(n_threads)
   , mtx_exception(new std::mutex())
-  , force_exit_loop(new std::atomic<bool>(false))
+  , stop_token(new std::atomic<bool>(false))
+  , current_tasks(new std::vector<current_task_t>(n_threads))
   , tasks_inplace(false)
   , thread_pinning(thread_pinning)
   , puids({})
   , no_copy_mode(true)
+  , no_copy_processes(false)
   , saved_exclusions(exclusions)
   , switchers_reset(n_threads)
   , auto_stop(true)
   , is_part_of_pipeline(false)
+  , pipeline(nullptr)
+  , sub_waves(false)
+  , n_frames_per_sub_wave(0)
+  , sub_waves_cache_size(256 * 1024)
+  , fusion(false)
+  , fusion_chunk_size(1024)
   , next_round_is_over(n_threads, false)
   , cur_task_id(n_threads, 0)
   , cur_ss(n_threads, nullptr)
+  , unpin_caller_thread(true)
+  , realtime_priority(0)
 {
-#ifndef AFF3CT_CORE_HWLOC
+#if !defined(AFF3CT_CORE_HWLOC) && !defined(AFF3CT_CORE_NATIVE_PINNING)
     if (thread_pinning)
         std::clog << rang::tag::warning
-                  << "AFF3CT has not been linked with the 'hwloc' library, the 'thread_pinning' "
-                     "option of the 'runtime::Sequence' will have no effect."
+                  << "AFF3CT has not been linked with the 'hwloc' library and the native pinning is not available on "
+                     "this system, the 'thread_pinning' option of the 'runtime::Sequence' will have no effect."
                   << std::endl;
 #endif
 
@@ -286,22 +339,33 @@ Sequence::Sequence(const std::vector<runtime::Task*>& firsts,
                    const std::string& sequence_pinning_policy,
                    const bool tasks_inplace)
   : n_threads(n_threads)
+  , n_active_threads(n_threads)
   , sequences(n_threads, nullptr)
   , modules(tasks_inplace ? n_threads - 1 : n_threads)
   , all_modules(n_threads)
   , mtx_exception(new std::mutex())
-  , force_exit_loop(new std::atomic<bool>(false))
+  , stop_token(new std::atomic<bool>(false))
+  , current_tasks(new std::vector<current_task_t>(n_threads))
   , tasks_inplace(tasks_inplace)
   , thread_pinning(thread_pinning)
   , puids({})
   , no_copy_mode(true)
+  , no_copy_processes(false)
   , saved_exclusions(exclusions_convert_to_const(exclusions))
   , switchers_reset(n_threads)
   , auto_stop(true)
   , is_part_of_pipeline(false)
+  , pipeline(nullptr)
+  , sub_waves(false)
+  , n_frames_per_sub_wave(0)
+  , sub_waves_cache_size(256 * 1024)
+  , fusion(false)
+  , fusion_chunk_size(1024)
   , next_round_is_over(n_threads, false)
   , cur_task_id(n_threads, 0)
   , cur_ss(n_threads, nullptr)
+  , unpin_caller_thread(true)
+  , realtime_priority(0)
 {
     if (thread_pinning && !sequence_pinning_policy.empty())
     {
@@ -375,6 +439,8 @@ Sequence::Sequence(runtime::Task& first,
 
 Sequence::~Sequence()
 {
+    // the modules can be reused by another sequence: their sockets get their own buffers back
+    if (this->no_copy_processes && !this->is_part_of_pipeline) this->reset_no_copy_mode();
     std::vector<tools::Digraph_node<Sub_sequence>*> already_deleted_nodes;
     for (auto s : this->sequences)
         this->delete_tree(s, already_deleted_nodes);
@@ -384,13 +450,8 @@ template<class SS, class TA>
 void
 Sequence::init(const std::vector<TA*>& firsts, const std::vector<TA*>& lasts, const std::vector<TA*>& exclusions)
 {
-    if (this->is_thread_pinning())
-    {
-        if (!this->puids.empty())
-            tools::Thread_pinning::pin(this->puids[0]);
-        else
-            tools::Thread_pinning::pin(this->pin_objects_per_thread[0]);
-    }
+    this->update_pin_cpusets();
+    if (this->is_thread_pinning()) this->pin_thread(0);
 
     if (firsts.size() == 0)
     {
@@ -529,7 +590,8 @@ Sequence::clone() const
 
     c->init<runtime::Sub_sequence_const, const runtime::Task>(firsts_tasks, lasts_tasks, this->saved_exclusions);
     c->mtx_exception.reset(new std::mutex());
-    c->force_exit_loop.reset(new std::atomic<bool>(false));
+    c->stop_token.reset(new std::atomic<bool>(false));
+    c->current_tasks.reset(new std::vector<current_task_t>(c->get_n_threads()));
     return c;
 }
 
@@ -547,6 +609,7 @@ Sequence::set_thread_pinning(const bool thread_pinning, const std::vector<size_t
     this->thread_pinning = thread_pinning;
     this->puids = puids;
     this->pin_objects_per_thread = {};
+    this->update_pin_cpusets();
 }
 
 void
@@ -556,6 +619,37 @@ Sequence::set_thread_pinning(const bool thread_pinning, const std::string& seque
     this->puids = {};
     this->pin_objects_per_thread =
       tools::Thread_pinning_utils::stage_parser_unpacker(sequence_pinning_policy, n_threads);
+    this->update_pin_cpusets();
+}
+
+void
+Sequence::update_pin_cpusets()
+{
+    this->pin_cpusets.clear();
+    if (!this->is_thread_pinning()) return;
+
+    this->pin_cpusets.resize(this->n_threads);
+    for (size_t tid = 0; tid < this->n_threads; tid++)
+        if (!this->puids.empty())
+            this->pin_cpusets[tid] = tools::Thread_pinning::get_cpuset(this->puids[tid]);
+        else
+            this->pin_cpusets[tid] = tools::Thread_pinning::get_cpuset(this->pin_objects_per_thread[tid]);
+}
+
+void
+Sequence::pin_thread(const size_t tid)
+{
+    // the cpuset is empty if 'Thread_pinning::init' has been called after the pinning policy was set, each thread
+    // only resolves its own cpuset
+    if (this->pin_cpusets[tid].set == nullptr)
+    {
+        if (!this->puids.empty())
+            this->pin_cpusets[tid] = tools::Thread_pinning::get_cpuset(this->puids[tid]);
+        else
+            this->pin_cpusets[tid] = tools::Thread_pinning::get_cpuset(this->pin_objects_per_thread[tid]);
+    }
+
+    tools::Thread_pinning::pin(this->pin_cpusets[tid]);
 }
 
 bool
@@ -564,6 +658,25 @@ Sequence::is_thread_pinning()
     return this->thread_pinning;
 }
 
+void
+Sequence::set_realtime_priority(const int priority)
+{
+    if (priority < 0)
+    {
+        std::stringstream message;
+        message << "'priority' has to be positive ('priority' = " << priority << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->realtime_priority = priority;
+}
+
+int
+Sequence::get_realtime_priority() const
+{
+    return this->realtime_priority;
+}
+
 std::vector<std::vector<module::Module*>>
 Sequence::get_modules_per_threads() const
 {
@@ -668,84 +781,16 @@ Sequence::_exec(const size_t tid,
 {
     tools::Signal_handler::reset_sigint();
 
-    if (this->is_thread_pinning())
-    {
-        if (!puids.empty())
-            tools::Thread_pinning::pin(this->puids[tid]);
-        else
-            tools::Thread_pinning::pin(this->pin_objects_per_thread[tid]);
-    }
-
-    std::function<void(tools::Digraph_node<Sub_sequence>*, std::vector<const int*>&)> exec_sequence =
-      [&exec_sequence](tools::Digraph_node<Sub_sequence>* cur_ss, std::vector<const int*>& statuses)
-    {
-        auto type = cur_ss->get_c()->type;
-        auto& tasks_id = cur_ss->get_c()->tasks_id;
-        auto& processes = cur_ss->get_c()->processes;
-
-        if (type == subseq_t::COMMUTE)
-        {
-            statuses[tasks_id[0]] = processes[0]();
-            const int path = statuses[tasks_id[0]][0];
-            if (cur_ss->get_children().size() > (size_t)path) exec_sequence(cur_ss->get_children()[path], statuses);
-        }
-        else
-        {
-            for (size_t p = 0; p < processes.size(); p++)
-                statuses[tasks_id[p]] = processes[p]();
-            for (auto c : cur_ss->get_children())
-                exec_sequence(c, statuses);
-        }
-    };
+    if (this->is_thread_pinning()) this->pin_thread(tid);
+    const bool realtime = this->realtime_priority > 0 && tools::Thread_pinning::set_realtime(this->realtime_priority);
 
     std::vector<const int*> statuses(this->n_tasks, nullptr);
-    try
-    {
-        do
-        {
-            // force switchers reset to reinitialize the path to the last input socket
-            for (size_t s = 0; s < this->switchers_reset[tid].size(); s++)
-                this->switchers_reset[tid][s]->reset();
+    while (this->exec_iteration(tid, stop_condition, statuses))
+        ;
 
-            std::fill(statuses.begin(), statuses.end(), nullptr);
-            try
-            {
-                exec_sequence(sequence, statuses);
-            }
-            catch (tools::processing_aborted const&)
-            {
-                // do nothing, this is normal
-            }
-        } while (!*force_exit_loop && !stop_condition(statuses) && !tools::Signal_handler::is_sigint());
-    }
-    catch (tools::waiting_canceled const&)
-    {
-        // do nothing, this is normal
-    }
-    catch (std::exception const& e)
-    {
-        *force_exit_loop = true;
-
-        this->mtx_exception->lock();
-
-        auto save = tools::exception::no_stacktrace;
-        tools::exception::no_stacktrace = true;
-        std::string msg = e.what(); // get only the function signature
-        tools::exception::no_stacktrace = save;
-
-        if (std::find(this->prev_exception_messages.begin(), this->prev_exception_messages.end(), msg) ==
-            this->prev_exception_messages.end())
-        {
-            this->prev_exception_messages.push_back(msg);                 // save only the function signature
-            this->prev_exception_messages_to_display.push_back(e.what()); // with stacktrace if debug mode
-        }
-        else if (std::strlen(e.what()) > this->prev_exception_messages_to_display.back().size())
-            this->prev_exception_messages_to_display[prev_exception_messages_to_display.size() - 1] = e.what();
-
-        this->mtx_exception->unlock();
-    }
-
-    if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
+    // the threads spawned by 'exec' end here, only the caller thread can be reused after
+    if (this->is_thread_pinning() && tid == 0 && this->unpin_caller_thread) tools::Thread_pinning::unpin();
+    if (realtime && tid == 0 && this->unpin_caller_thread) tools::Thread_pinning::unset_realtime();
 }
 
 void
@@ -755,51 +800,47 @@ Sequence::_exec_without_statuses(const size_t tid,
 {
     tools::Signal_handler::reset_sigint();
 
-    if (this->is_thread_pinning())
-    {
-        if (!puids.empty())
-            tools::Thread_pinning::pin(this->puids[tid]);
-        else
-            tools::Thread_pinning::pin(this->pin_objects_per_thread[tid]);
-    }
+    if (this->is_thread_pinning()) this->pin_thread(tid);
+    const bool realtime = this->realtime_priority > 0 && tools::Thread_pinning::set_realtime(this->realtime_priority);
 
-    std::function<void(tools::Digraph_node<Sub_sequence>*)> exec_sequence =
-      [&exec_sequence](tools::Digraph_node<Sub_sequence>* cur_ss)
+    while (this->exec_iteration(tid, stop_condition))
+        ;
+
+    // the threads spawned by 'exec' end here, only the caller thread can be reused after
+    if (this->is_thread_pinning() && tid == 0 && this->unpin_caller_thread) tools::Thread_pinning::unpin();
+    if (realtime && tid == 0 && this->unpin_caller_thread) tools::Thread_pinning::unset_realtime();
+}
+
+template<class SC>
+bool
+Sequence::_exec_iteration(const size_t tid, std::vector<const int*>* statuses, SC&& is_stop_condition)
+{
+    // the current task is published with a relaxed store for the sampling profiler
+    auto& cur_task = (*this->current_tasks)[tid].task;
+    const Current_task_guard cur_task_guard(cur_task);
+    try
     {
-        auto type = cur_ss->get_c()->type;
-        auto& processes = cur_ss->get_c()->processes;
+        // force switchers reset to reinitialize the path to the last input socket
+        for (size_t s = 0; s < this->switchers_reset[tid].size(); s++)
+            this->switchers_reset[tid][s]->reset();
 
-        if (type == subseq_t::COMMUTE)
+        if (statuses) std::fill(statuses->begin(), statuses->end(), nullptr);
+        try
         {
-            const int path = processes[0]()[0];
-            if (cur_ss->get_children().size() > (size_t)path) exec_sequence(cur_ss->get_children()[path]);
+            this->exec_subsequences(cur_task, this->sequences[tid], statuses);
         }
-        else
+        catch (tools::processing_aborted const&)
         {
-            for (auto& process : processes)
-                process();
-            for (auto c : cur_ss->get_children())
-                exec_sequence(c);
+            // do nothing, this is normal
         }
-    };
-
-    try
-    {
-        do
-        {
-            // force switchers reset to reinitialize the path to the last input socket
-            for (size_t s = 0; s < this->switchers_reset[tid].size(); s++)
-                this->switchers_reset[tid][s]->reset();
-
-            try
-            {
-                exec_sequence(sequence);
-            }
-            catch (tools::processing_aborted const&)
-            {
-                // do nothing, this is normal
-            }
-        } while (!*force_exit_loop && !stop_condition() && !tools::Signal_handler::is_sigint());
+        cur_task.store(nullptr, std::memory_order_relaxed);
+
+        // the user stop condition is optional, the stop token is set by 'request_stop', by the donners, by the SIGINT
+        // signal and when an exception is thrown, it is read again after the stop condition: a stop requested while
+        // the stop condition is evaluated does not start a new frame
+        auto& stop_token = *this->stop_token;
+        return !stop_token.load(std::memory_order_relaxed) && !is_stop_condition() &&
+               !stop_token.load(std::memory_order_relaxed);
     }
     catch (tools::waiting_canceled const&)
     {
@@ -807,85 +848,190 @@ Sequence::_exec_without_statuses(const size_t tid,
     }
     catch (std::exception const& e)
     {
-        *force_exit_loop = true;
+        this->save_exception(e);
+    }
+    return false;
+}
 
-        this->mtx_exception->lock();
+bool
+Sequence::exec_iteration(const size_t tid, std::function<bool()>& stop_condition)
+{
+    return this->_exec_iteration(tid, nullptr, [&stop_condition]() { return stop_condition && stop_condition(); });
+}
 
-        auto save = tools::exception::no_stacktrace;
-        tools::exception::no_stacktrace = true;
-        std::string msg = e.what(); // get only the function signature
-        tools::exception::no_stacktrace = save;
+bool
+Sequence::exec_iteration(const size_t tid,
+                         std::function<bool(const std::vector<const int*>&)>& stop_condition,
+                         std::vector<const int*>& statuses)
+{
+    return this->_exec_iteration(tid,
+                                 &statuses,
+                                 [&stop_condition, &statuses]() { return stop_condition && stop_condition(statuses); });
+}
 
-        if (std::find(this->prev_exception_messages.begin(), this->prev_exception_messages.end(), msg) ==
-            this->prev_exception_messages.end())
+void
+Sequence::exec_subsequences(std::atomic<runtime::Task*>& cur_task,
+                            tools::Digraph_node<Sub_sequence>* cur_ss,
+                            std::vector<const int*>* statuses)
+{
+    auto type = cur_ss->get_c()->type;
+    auto& tasks = cur_ss->get_c()->tasks;
+    auto& tasks_id = cur_ss->get_c()->tasks_id;
+    auto& processes = cur_ss->get_c()->processes;
+
+    if (type == subseq_t::COMMUTE)
+    {
+        cur_task.store(tasks[0], std::memory_order_relaxed);
+        const int* status = processes[0]();
+        if (statuses) (*statuses)[tasks_id[0]] = status;
+        const int path = status[0];
+        if (cur_ss->get_children().size() > (size_t)path)
+            this->exec_subsequences(cur_task, cur_ss->get_children()[path], statuses);
+    }
+    else
+    {
+        for (size_t p = 0; p < processes.size(); p++)
         {
-            this->prev_exception_messages.push_back(msg);                 // save only the function signature
-            this->prev_exception_messages_to_display.push_back(e.what()); // with stacktrace if debug mode
+            cur_task.store(tasks[p], std::memory_order_relaxed);
+            const int* status = processes[p]();
+            if (statuses) (*statuses)[tasks_id[p]] = status;
         }
-        else if (std::strlen(e.what()) > this->prev_exception_messages_to_display.back().size())
-            this->prev_exception_messages_to_display[prev_exception_messages_to_display.size() - 1] = e.what();
+        for (auto c : cur_ss->get_children())
+            this->exec_subsequences(cur_task, c, statuses);
+    }
+}
+
+void
+Sequence::save_exception(std::exception const& e)
+{
+    this->stop_token->store(true, std::memory_order_relaxed);
+
+    this->mtx_exception->lock();
 
-        this->mtx_exception->unlock();
+    auto save = tools::exception::no_stacktrace;
+    tools::exception::no_stacktrace = true;
+    std::string msg = e.what(); // get only the function signature
+    tools::exception::no_stacktrace = save;
+
+    if (std::find(this->prev_exception_messages.begin(), this->prev_exception_messages.end(), msg) ==
+        this->prev_exception_messages.end())
+    {
+        this->prev_exception_messages.push_back(msg);                 // save only the function signature
+        this->prev_exception_messages_to_display.push_back(e.what()); // with stacktrace if debug mode
     }
+    else if (std::strlen(e.what()) > this->prev_exception_messages_to_display.back().size())
+        this->prev_exception_messages_to_display[prev_exception_messages_to_display.size() - 1] = e.what();
 
-    if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
+    this->mtx_exception->unlock();
 }
 
 void
 Sequence::exec(std::function<bool(const std::vector<const int*>&)> stop_condition)
 {
-    if (this->is_no_copy_mode()) this->gen_processes(true);
+    this->stop_token->store(false);
+    this->exec_threads(stop_condition);
+}
+
+void
+Sequence::exec(std::function<bool()> stop_condition)
+{
+    this->stop_token->store(false);
+    this->exec_threads(stop_condition);
+}
+
+void
+Sequence::request_stop()
+{
+    this->stop_token->store(true, std::memory_order_relaxed);
+}
+
+bool
+Sequence::is_stop_requested() const
+{
+    return this->stop_token->load(std::memory_order_relaxed);
+}
 
-    std::function<bool(const std::vector<const int*>&)> real_stop_condition;
+std::vector<tools::Interface_is_done*>
+Sequence::register_stop_token(bool& poll_sigint)
+{
+    // the donners that cannot notify that they are done are polled after each execution
+    std::vector<tools::Interface_is_done*> polled_donners;
     if (this->auto_stop)
-        real_stop_condition = [this, stop_condition](const std::vector<const int*>& statuses)
+        for (auto donner : this->donners)
+            if (donner->is_notifying_done())
+                donner->register_done_flag(this->stop_token.get());
+            else
+                polled_donners.push_back(donner);
+
+    poll_sigint = !tools::Signal_handler::register_sigint_flag(this->stop_token.get());
+    return polled_donners;
+}
+
+void
+Sequence::unregister_stop_token()
+{
+    for (auto donner : this->donners)
+        donner->unregister_done_flag(this->stop_token.get());
+    tools::Signal_handler::unregister_sigint_flag(this->stop_token.get());
+}
+
+void
+Sequence::exec_threads(std::function<bool(const std::vector<const int*>&)> stop_condition)
+{
+    // the no copy processes are generated once and reused by the next 'exec' calls
+    if (this->is_no_copy_mode() && !this->no_copy_processes) this->gen_processes(true);
+
+    bool poll_sigint = false;
+    const auto polled_donners = this->register_stop_token(poll_sigint);
+
+    std::function<bool(const std::vector<const int*>&)> real_stop_condition = stop_condition;
+    if (!polled_donners.empty() || poll_sigint)
+        real_stop_condition = [&stop_condition, &polled_donners, poll_sigint](const std::vector<const int*>& statuses)
         {
-            bool res = stop_condition(statuses);
-            return res || this->is_done();
+            if (stop_condition && stop_condition(statuses)) return true;
+            for (auto donner : polled_donners)
+                if (donner->is_done()) return true;
+            return poll_sigint && tools::Signal_handler::is_sigint();
         };
-    else
-        real_stop_condition = stop_condition;
 
-    std::vector<std::thread> threads(n_threads);
-    for (size_t tid = 1; tid < n_threads; tid++)
+    std::vector<std::thread> threads(this->n_active_threads);
+    for (size_t tid = 1; tid < this->n_active_threads; tid++)
         threads[tid] =
           std::thread(&Sequence::_exec, this, tid, std::ref(real_stop_condition), std::ref(this->sequences[tid]));
 
     this->_exec(0, real_stop_condition, this->sequences[0]);
 
-    for (size_t tid = 1; tid < n_threads; tid++)
+    for (size_t tid = 1; tid < this->n_active_threads; tid++)
         threads[tid].join();
 
-    if (this->is_no_copy_mode() && !this->is_part_of_pipeline)
-    {
-        this->reset_no_copy_mode();
-        this->gen_processes(false);
-    }
+    this->unregister_stop_token();
+    this->give_back_buffers();
 
     if (!this->prev_exception_messages_to_display.empty())
-    {
-        *force_exit_loop = false;
         throw std::runtime_error(this->prev_exception_messages_to_display.back());
-    }
 }
 
 void
-Sequence::exec(std::function<bool()> stop_condition)
+Sequence::exec_threads(std::function<bool()> stop_condition)
 {
-    if (this->is_no_copy_mode()) this->gen_processes(true);
+    // the no copy processes are generated once and reused by the next 'exec' calls
+    if (this->is_no_copy_mode() && !this->no_copy_processes) this->gen_processes(true);
 
-    std::function<bool()> real_stop_condition;
-    if (this->auto_stop)
-        real_stop_condition = [this, stop_condition]()
+    bool poll_sigint = false;
+    const auto polled_donners = this->register_stop_token(poll_sigint);
+
+    std::function<bool()> real_stop_condition = stop_condition;
+    if (!polled_donners.empty() || poll_sigint)
+        real_stop_condition = [&stop_condition, &polled_donners, poll_sigint]()
         {
-            bool res = stop_condition();
-            return res || this->is_done();
+            if (stop_condition && stop_condition()) return true;
+            for (auto donner : polled_donners)
+                if (donner->is_done()) return true;
+            return poll_sigint && tools::Signal_handler::is_sigint();
         };
-    else
-        real_stop_condition = stop_condition;
 
-    std::vector<std::thread> threads(n_threads);
-    for (size_t tid = 1; tid < n_threads; tid++)
+    std::vector<std::thread> threads(this->n_active_threads);
+    for (size_t tid = 1; tid < this->n_active_threads; tid++)
     {
         threads[tid] = std::thread(
           &Sequence::_exec_without_statuses, this, tid, std::ref(real_stop_condition), std::ref(this->sequences[tid]));
@@ -893,31 +1039,72 @@ Sequence::exec(std::function<bool()> stop_condition)
 
     this->_exec_without_statuses(0, real_stop_condition, this->sequences[0]);
 
-    for (size_t tid = 1; tid < n_threads; tid++)
+    for (size_t tid = 1; tid < this->n_active_threads; tid++)
         threads[tid].join();
 
-    if (this->is_no_copy_mode() && !this->is_part_of_pipeline)
-    {
-        this->reset_no_copy_mode();
-        this->gen_processes(false);
-    }
+    this->unregister_stop_token();
+    this->give_back_buffers();
 
     if (!this->prev_exception_messages_to_display.empty())
-    {
-        *force_exit_loop = false;
         throw std::runtime_error(this->prev_exception_messages_to_display.back());
+}
+
+void
+Sequence::set_n_active_threads(const size_t n_active_threads)
+{
+    if (n_active_threads == 0 || n_active_threads > this->n_threads)
+    {
+        std::stringstream message;
+        message << "'n_active_threads' has to be greater than 0 and smaller or equal to 'n_threads' "
+                << "('n_active_threads' = " << n_active_threads << ", 'n_threads' = " << this->n_threads << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
     }
+
+    this->n_active_threads = n_active_threads;
 }
 
 void
 Sequence::exec()
 {
-    this->exec([]() { return false; });
+    this->exec(std::function<bool()>());
+}
+
+Exec_handle
+Sequence::exec_async(std::function<bool(const std::vector<const int*>&)> stop_condition)
+{
+    // the stop token is reset before the handle exists: a stop requested on the handle cannot be lost
+    this->stop_token->store(false);
+    return Exec_handle(
+      [this, stop_condition]()
+      {
+          // the driver thread runs the first replica: it is pinned by the sequence if the sequence has a pinning
+          // policy, it is not an auxiliary thread
+          this->exec_threads(stop_condition);
+      },
+      [this]() { this->request_stop(); });
+}
+
+Exec_handle
+Sequence::exec_async(std::function<bool()> stop_condition)
+{
+    this->stop_token->store(false);
+    return Exec_handle(
+      [this, stop_condition]() { this->exec_threads(stop_condition); },
+      [this]() { this->request_stop(); });
+}
+
+Exec_handle
+Sequence::exec_async()
+{
+    return this->exec_async(std::function<bool()>());
 }
 
 void
 Sequence::exec_seq(const size_t tid, const int frame_id)
 {
+    // the tasks are executed directly (without the processes): the sockets need their own buffers
+    if (this->no_copy_processes) this->gen_processes(false);
+
     if (tid >= this->sequences.size())
     {
         std::stringstream message;
@@ -951,6 +1138,9 @@ Sequence::exec_seq(const size_t tid, const int frame_id)
 runtime::Task*
 Sequence::exec_step(const size_t tid, const int frame_id)
 {
+    // the tasks are executed directly (without the processes): the sockets need their own buffers
+    if (this->no_copy_processes) this->gen_processes(false);
+
     if (tid >= this->sequences.size())
     {
         std::stringstream message;
@@ -1422,14 +1612,7 @@ Sequence::duplicate(const tools::Digraph_node<SS>* sequence)
     // clone the modules
     for (size_t tid = 0; tid < this->n_threads - (this->tasks_inplace ? 1 : 0); tid++)
     {
-        if (this->is_thread_pinning())
-        {
-            const auto real_tid = tid + (this->tasks_inplace ? 1 : 0);
-            if (!this->puids.empty())
-                tools::Thread_pinning::pin(this->puids[real_tid]);
-            else
-                tools::Thread_pinning::pin(this->pin_objects_per_thread[real_tid]);
-        }
+        if (this->is_thread_pinning()) this->pin_thread(tid + (this->tasks_inplace ? 1 : 0));
 
         this->modules[tid].resize(modules_vec.size());
         this->all_modules[tid + (this->tasks_inplace ? 1 : 0)].resize(modules_vec.size());
@@ -1449,9 +1632,9 @@ Sequence::duplicate(const tools::Digraph_node<SS>* sequence)
             }
             this->all_modules[tid + (this->tasks_inplace ? 1 : 0)][m] = this->modules[tid][m].get();
         }
-
-        if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
     }
+    // the same thread is pinned at each iteration, it is unpinned only once at the end
+    if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
 
     auto get_module_id = [](const std::vector<MO*>& modules, const module::Module& module)
     {
@@ -1640,13 +1823,7 @@ Sequence::duplicate(const tools::Digraph_node<SS>* sequence)
 
     for (size_t thread_id = (this->tasks_inplace ? 1 : 0); thread_id < this->sequences.size(); thread_id++)
     {
-        if (this->is_thread_pinning())
-        {
-            if (!this->puids.empty())
-                tools::Thread_pinning::pin(this->puids[thread_id]);
-            else
-                tools::Thread_pinning::pin(this->pin_objects_per_thread[thread_id]);
-        }
+        if (this->is_thread_pinning()) this->pin_thread(thread_id);
 
         this->sequences[thread_id] = new tools::Digraph_node<Sub_sequence>({}, {}, nullptr, 0);
         already_parsed_nodes.clear();
@@ -1654,9 +1831,8 @@ Sequence::duplicate(const tools::Digraph_node<SS>* sequence)
         duplicate_sequence(sequence, this->sequences[thread_id], thread_id, already_parsed_nodes, allocated_nodes);
         std::vector<tools::Digraph_node<Sub_sequence>*> already_parsed_nodes_bis;
         set_autoalloc_true(this->sequences[thread_id], already_parsed_nodes_bis);
-
-        if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
     }
+    if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
 }
 
 template void
@@ -1887,6 +2063,16 @@ Sequence::export_dot(tools::Digraph_node<SS>* root, std::ostream& stream) const
 void
 Sequence::gen_processes(const bool no_copy_mode)
 {
+    if (this->no_copy_processes)
+    {
+        // the buffers of the adaptors are shared with the other stages, they are given back by the pipeline for all
+        // the stages at once (the other stages generate their no copy processes again at the next 'exec' call)
+        if (this->pipeline != nullptr)
+            this->pipeline->reset_no_copy_mode();
+        else
+            this->reset_no_copy_mode();
+    }
+
     std::function<void(Socket * socket, std::vector<runtime::Socket*> & list_fwd)> explore_thread_rec =
       [&explore_thread_rec](Socket* socket, std::vector<runtime::Socket*>& list_fwd)
     {
@@ -1919,7 +2105,7 @@ Sequence::gen_processes(const bool no_copy_mode)
 
     std::function<void(tools::Digraph_node<Sub_sequence>*, std::vector<tools::Digraph_node<Sub_sequence>*>&)>
       gen_processes_recursive =
-        [&gen_processes_recursive, no_copy_mode, &explore_thread_rec, &explore_thread_rec_reverse](
+        [this, &gen_processes_recursive, no_copy_mode, &explore_thread_rec, &explore_thread_rec_reverse](
           tools::Digraph_node<Sub_sequence>* cur_node,
           std::vector<tools::Digraph_node<Sub_sequence>*>& already_parsed_nodes)
     {
@@ -2148,17 +2334,70 @@ Sequence::gen_processes(const bool no_copy_mode)
                 }
             }
 
-            for (auto task : contents->tasks)
+            for (size_t ta = 0; ta < contents->tasks.size(); ta++)
+            {
+                auto task = contents->tasks[ta];
                 if (modified_tasks.count(task))
                     contents->processes.push_back(modified_tasks[task]);
                 else
-                    contents->processes.push_back(
-                      [task]() -> const int*
-                      {
-                          task->exec();
-                          const int* status = task->sockets.back()->get_dataptr<int>();
-                          return status;
-                      });
+                {
+                    const auto fusion_group = this->fusion ? this->get_fusion_group(contents->tasks, ta, modified_tasks)
+                                                           : std::vector<runtime::Task*>();
+                    const auto group = this->sub_waves ? this->get_sub_waves_group(contents->tasks, ta, modified_tasks)
+                                                       : std::vector<runtime::Task*>();
+                    if (fusion_group.size() > 1)
+                    {
+                        // like for the sub-waves, the first task of the group executes the whole group
+                        contents->processes.push_back(this->gen_fusion_process(fusion_group));
+                        for (size_t g = 1; g < fusion_group.size(); g++)
+                        {
+                            auto next_task = fusion_group[g];
+                            contents->processes.push_back([next_task]() -> const int*
+                                                          { return next_task->sockets.back()->get_dataptr<int>(); });
+                        }
+                        ta += fusion_group.size() - 1;
+                    }
+                    else if (group.size() > 1)
+                    {
+                        // the first task of the group executes the whole group sub-wave after sub-wave, the
+                        // processes of the next tasks only return their status
+                        const size_t n_waves_per_sub_wave = this->get_n_waves_per_sub_wave(group);
+                        std::vector<bool> stopped(group.size());
+                        contents->processes.push_back(
+                          [group, n_waves_per_sub_wave, stopped]() mutable -> const int*
+                          {
+                              const size_t n_waves = group[0]->get_n_waves();
+                              std::fill(stopped.begin(), stopped.end(), false);
+                              for (size_t w = 0; w < n_waves; w += n_waves_per_sub_wave)
+                                  for (size_t g = 0; g < group.size(); g++)
+                                      if (!stopped[g])
+                                      {
+                                          group[g]->exec_waves(w, w + n_waves_per_sub_wave);
+                                          const int* status = group[g]->sockets.back()->get_dataptr<int>();
+                                          const size_t w_stop = std::min(w + n_waves_per_sub_wave, n_waves);
+                                          for (size_t ww = w; ww < w_stop; ww++)
+                                              stopped[g] = stopped[g] || status[ww] == status_t::FAILURE_STOP;
+                                      }
+                              return group[0]->sockets.back()->get_dataptr<int>();
+                          });
+                        for (size_t g = 1; g < group.size(); g++)
+                        {
+                            auto next_task = group[g];
+                            contents->processes.push_back([next_task]() -> const int*
+                                                          { return next_task->sockets.back()->get_dataptr<int>(); });
+                        }
+                        ta += group.size() - 1;
+                    }
+                    else
+                        contents->processes.push_back(
+                          [task]() -> const int*
+                          {
+                              task->exec();
+                              const int* status = task->sockets.back()->get_dataptr<int>();
+                              return status;
+                          });
+                }
+            }
 
             for (auto c : cur_node->get_children())
                 gen_processes_recursive(c, already_parsed_nodes);
@@ -2168,27 +2407,22 @@ Sequence::gen_processes(const bool no_copy_mode)
     size_t thread_id = 0;
     for (auto& sequence : this->sequences)
     {
-        if (this->is_thread_pinning())
-        {
-            if (!this->puids.empty())
-                tools::Thread_pinning::pin(this->puids[thread_id++]);
-            else
-                tools::Thread_pinning::pin(this->pin_objects_per_thread[thread_id++]);
-        }
+        if (this->is_thread_pinning()) this->pin_thread(thread_id++);
         std::vector<tools::Digraph_node<Sub_sequence>*> already_parsed_nodes;
         gen_processes_recursive(sequence, already_parsed_nodes);
-
-        if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
     }
+    if (this->is_thread_pinning()) tools::Thread_pinning::unpin();
+    this->no_copy_processes = no_copy_mode;
 }
 
 void
-Sequence::reset_no_copy_mode()
+Sequence::reset_no_copy_mode(const bool keep_processes)
 {
     std::function<void(tools::Digraph_node<Sub_sequence>*, std::vector<tools::Digraph_node<Sub_sequence>*>&)>
       reset_no_copy_mode_recursive =
-        [&reset_no_copy_mode_recursive](tools::Digraph_node<Sub_sequence>* cur_node,
-                                        std::vector<tools::Digraph_node<Sub_sequence>*>& already_parsed_nodes)
+        [&reset_no_copy_mode_recursive, keep_processes](
+          tools::Digraph_node<Sub_sequence>* cur_node,
+          std::vector<tools::Digraph_node<Sub_sequence>*>& already_parsed_nodes)
     {
         if (cur_node != nullptr &&
             std::find(already_parsed_nodes.begin(), already_parsed_nodes.end(), cur_node) == already_parsed_nodes.end())
@@ -2202,7 +2436,7 @@ Sequence::reset_no_copy_mode()
                 {
                     auto select_task = task;
                     auto switcher = dynamic_cast<module::Switcher*>(&select_task->get_module());
-                    switcher->set_no_copy_select(false);
+                    if (!keep_processes) switcher->set_no_copy_select(false);
                 }
 
                 if (dynamic_cast<module::Switcher*>(&task->get_module()) &&
@@ -2210,7 +2444,7 @@ Sequence::reset_no_copy_mode()
                 {
                     auto commute_task = task;
                     auto switcher = dynamic_cast<module::Switcher*>(&commute_task->get_module());
-                    switcher->set_no_copy_commute(false);
+                    if (!keep_processes) switcher->set_no_copy_commute(false);
                 }
 
                 if (dynamic_cast<module::Adaptor*>(&task->get_module()) &&
@@ -2218,7 +2452,7 @@ Sequence::reset_no_copy_mode()
                 {
                     auto pull_task = task;
                     auto adp_pull = dynamic_cast<module::Adaptor*>(&pull_task->get_module());
-                    adp_pull->set_no_copy_pull(false);
+                    if (!keep_processes) adp_pull->set_no_copy_pull(false);
                     adp_pull->reset_buffer();
                 }
 
@@ -2227,7 +2461,7 @@ Sequence::reset_no_copy_mode()
                 {
                     auto push_task = task;
                     auto adp_push = dynamic_cast<module::Adaptor*>(&push_task->get_module());
-                    adp_push->set_no_copy_push(false);
+                    if (!keep_processes) adp_push->set_no_copy_push(false);
                     adp_push->reset_buffer();
                 }
             }
@@ -2248,11 +2482,228 @@ Sequence::reset_no_copy_mode()
         std::vector<tools::Digraph_node<Sub_sequence>*> already_parsed_nodes;
         reset_no_copy_mode_recursive(sequence, already_parsed_nodes);
     }
+    if (!keep_processes) this->no_copy_processes = false;
+}
+
+void
+Sequence::give_back_buffers()
+{
+    // the processes are kept, the stages of a pipeline keep the buffers: the buffers of the adaptors are shared with
+    // the other stages, they are given back by the pipeline
+    if (this->no_copy_processes && this->pipeline == nullptr) this->reset_no_copy_mode(true);
+}
+
+std::vector<runtime::Task*>
+Sequence::get_sub_waves_group(const std::vector<runtime::Task*>& tasks,
+                              const size_t first_task_id,
+                              const std::map<runtime::Task*, std::function<const int*()>>& modified_tasks) const
+{
+    // a group is made of consecutive tasks that can be executed wave by wave (the single wave modules like the
+    // adaptors, the switchers or the probes need all the frames at once)
+    std::vector<runtime::Task*> group;
+    const auto n_frames_per_wave = tasks[first_task_id]->get_module().get_n_frames_per_wave();
+    for (size_t ta = first_task_id; ta < tasks.size(); ta++)
+    {
+        auto task = tasks[ta];
+        if (modified_tasks.count(task) || task->is_debug() || task->get_module().is_single_wave() ||
+            task->get_module().get_n_frames_per_wave() != n_frames_per_wave)
+            break;
+        group.push_back(task);
+    }
+    return group;
+}
+
+size_t
+Sequence::get_n_waves_per_sub_wave(const std::vector<runtime::Task*>& group) const
+{
+    const auto n_frames = group[0]->get_module().get_n_frames();
+    const auto n_frames_per_wave = group[0]->get_module().get_n_frames_per_wave();
+
+    size_t n_frames_per_sub_wave = this->n_frames_per_sub_wave;
+    if (n_frames_per_sub_wave == 0)
+    {
+        // the sub-wave is sized to fit the data of one frame of each socket buffer of the group in the cache, the
+        // buffers shared by a producer and its consumers are counted only once
+        std::set<const void*> buffers;
+        size_t n_bytes_per_frame = 0;
+        for (auto task : group)
+            for (size_t s = 0; s < task->sockets.size() - 1; s++)
+                if (buffers.insert(task->sockets[s]->_get_dataptr()).second)
+                    n_bytes_per_frame += task->sockets[s]->get_databytes() / n_frames;
+        n_frames_per_sub_wave = n_bytes_per_frame ? this->sub_waves_cache_size / n_bytes_per_frame : n_frames;
+    }
+
+    return std::max((size_t)1, n_frames_per_sub_wave / n_frames_per_wave);
+}
+
+std::vector<runtime::Task*>
+Sequence::get_fusion_group(const std::vector<runtime::Task*>& tasks,
+                           const size_t first_task_id,
+                           const std::map<runtime::Task*, std::function<const int*()>>& modified_tasks) const
+{
+    // a group is made of consecutive element-wise tasks working on the same number of elements, each task of the group
+    // has to consume at least one of the sockets of the previous task
+    std::vector<runtime::Task*> group;
+    for (size_t ta = first_task_id; ta < tasks.size(); ta++)
+    {
+        auto task = tasks[ta];
+        if (modified_tasks.count(task) || task->is_debug() || !task->is_elmtwise() ||
+            (group.size() && task->sockets[0]->get_n_elmts() != group[0]->sockets[0]->get_n_elmts()))
+            break;
+
+        if (group.size())
+        {
+            bool consumer = false;
+            auto prev_task = group.back();
+            for (size_t s = 0; s < prev_task->sockets.size() - 1 && !consumer; s++)
+                for (auto bound_socket : prev_task->sockets[s]->get_bound_sockets())
+                    consumer = consumer || &bound_socket->get_task() == task;
+            if (!consumer) break;
+        }
+        group.push_back(task);
+    }
+    return group;
+}
+
+std::function<const int*()>
+Sequence::gen_fusion_process(const std::vector<runtime::Task*>& group) const
+{
+    typedef std::vector<int8_t, tools::aligned_allocator<int8_t>> buffer;
+
+    // an output buffer only read by the next tasks of the group is never entirely needed, it is replaced by a chunk
+    // sized buffer shared by the producer and its consumers ('-1' = the socket dataptr is used)
+    std::map<const runtime::Socket*, int> scratch_ids;
+    std::vector<buffer> scratches;
+    std::vector<std::vector<int>> sockets_scratch_id(group.size());
+    std::vector<std::vector<size_t>> sockets_datatype_size(group.size());
+    for (size_t g = 0; g < group.size(); g++)
+        for (size_t s = 0; s < group[g]->sockets.size() - 1; s++)
+        {
+            auto socket = group[g]->sockets[s].get();
+            sockets_datatype_size[g].push_back(socket->get_datatype_size());
+
+            int scratch_id = -1;
+            if (scratch_ids.count(socket))
+                scratch_id = scratch_ids[socket];
+            else if (socket->get_type() == socket_t::SOUT && socket->get_bound_sockets().size())
+            {
+                bool only_read_by_group = true;
+                for (auto bound_socket : socket->get_bound_sockets())
+                {
+                    auto consumer = std::find(group.begin() + g + 1, group.end(), &bound_socket->get_task());
+                    only_read_by_group =
+                      only_read_by_group && bound_socket->get_type() == socket_t::SIN && consumer != group.end();
+                }
+
+                if (only_read_by_group)
+                {
+                    scratch_id = (int)scratches.size();
+                    scratches.push_back(buffer(this->fusion_chunk_size * socket->get_datatype_size()));
+                    for (auto bound_socket : socket->get_bound_sockets())
+                        scratch_ids[bound_socket] = scratch_id;
+                }
+            }
+            sockets_scratch_id[g].push_back(scratch_id);
+        }
+
+    const size_t n_elmts = group[0]->sockets[0]->get_n_elmts();
+    const size_t chunk_size = this->fusion_chunk_size;
+    std::vector<std::vector<void*>> dataptrs(group.size());
+    for (size_t g = 0; g < group.size(); g++)
+        dataptrs[g].resize(group[g]->sockets.size() - 1);
+
+    return [group, n_elmts, chunk_size, scratches, sockets_scratch_id, sockets_datatype_size, dataptrs]() mutable
+           -> const int*
+    {
+        for (size_t e_start = 0; e_start < n_elmts; e_start += chunk_size)
+        {
+            const size_t e_stop = std::min(e_start + chunk_size, n_elmts);
+            for (size_t g = 0; g < group.size(); g++)
+            {
+                // the sockets dataptr are read at each chunk because they can be updated by the no copy mode
+                for (size_t s = 0; s < dataptrs[g].size(); s++)
+                    dataptrs[g][s] = sockets_scratch_id[g][s] == -1
+                                       ? (void*)((int8_t*)group[g]->sockets[s]->_get_dataptr() +
+                                                 e_start * sockets_datatype_size[g][s])
+                                       : (void*)scratches[sockets_scratch_id[g][s]].data();
+                group[g]->exec_elmts(e_start, e_stop, dataptrs[g].data());
+            }
+        }
+        return group[0]->sockets.back()->get_dataptr<int>();
+    };
+}
+
+void
+Sequence::set_fusion(const bool fusion, const size_t fusion_chunk_size)
+{
+    if (fusion_chunk_size == 0)
+    {
+        std::stringstream message;
+        message << "'fusion_chunk_size' has to be greater than 0.";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->fusion = fusion;
+    this->fusion_chunk_size = fusion_chunk_size;
+    this->gen_processes();
+}
+
+bool
+Sequence::is_fusion() const
+{
+    return this->fusion;
+}
+
+size_t
+Sequence::get_fusion_chunk_size() const
+{
+    return this->fusion_chunk_size;
+}
+
+void
+Sequence::set_sub_waves(const bool sub_waves, const size_t n_frames_per_sub_wave)
+{
+    this->sub_waves = sub_waves;
+    this->n_frames_per_sub_wave = n_frames_per_sub_wave;
+    this->gen_processes();
+}
+
+bool
+Sequence::is_sub_waves() const
+{
+    return this->sub_waves;
+}
+
+size_t
+Sequence::get_n_frames_per_sub_wave() const
+{
+    return this->n_frames_per_sub_wave;
+}
+
+void
+Sequence::set_sub_waves_cache_size(const size_t cache_size)
+{
+    if (cache_size == 0)
+    {
+        std::stringstream message;
+        message << "'cache_size' has to be greater than 0.";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->sub_waves_cache_size = cache_size;
+    if (this->sub_waves) this->gen_processes();
+}
+
+size_t
+Sequence::get_sub_waves_cache_size() const
+{
+    return this->sub_waves_cache_size;
 }
 
 void
 Sequence::set_no_copy_mode(const bool no_copy_mode)
 {
+    if (!no_copy_mode && this->no_copy_processes) this->gen_processes(false);
     this->no_copy_mode = no_copy_mode;
 }
 
@@ -2497,6 +2948,9 @@ Sequence::set_n_frames(const size_t n_frames)
     const auto old_n_frames = this->get_n_frames();
     if (old_n_frames != n_frames)
     {
+        // the buffers are reallocated: the sockets have to give back the borrowed buffers before
+        if (this->no_copy_processes) this->gen_processes(false);
+
         std::vector<std::pair<runtime::Socket*, runtime::Socket*>> unbind_sockets;
         std::vector<std::pair<runtime::Task*, runtime::Socket*>> unbind_tasks;
         this->_set_n_frames_unbind(unbind_sockets, unbind_tasks);
@@ -24,6 +24,7 @@ Task::Task(module::Module& module,
   , name(name)
   , autoalloc(autoalloc)
   , stats(stats)
+  , perf(false)
   , fast(fast)
   , debug(debug)
   , debug_hex(false)
@@ -36,16 +37,28 @@ Task::Task(module::Module& module,
           throw tools::unimplemented_error(__FILE__, __LINE__, __func__);
           return 0;
       })
+  , elmtwise_type(typeid(void))
   , n_input_sockets(0)
   , n_output_sockets(0)
   , n_fwd_sockets(0)
   , status(module.get_n_waves())
+  , stats_clock(tools::clock_source_t::STEADY)
+  , stats_sampling(1)
   , n_calls(0)
+  , n_sampled_calls(0)
   , duration_total(std::chrono::nanoseconds(0))
   , duration_min(std::chrono::nanoseconds(0))
   , duration_max(std::chrono::nanoseconds(0))
+  , duration_partial(std::chrono::nanoseconds(0))
+  , perf_total(tools::perf_n_events, 0)
   , last_input_socket(nullptr)
+  , exec_mode(exec_mode_t::SINGLE_WAVE)
+  , n_frames(module.get_n_frames())
+  , n_frames_per_wave(module.get_n_frames_per_wave())
+  , n_waves(module.get_n_waves())
+  , n_frames_per_wave_rest(module.get_n_frames_per_wave_rest())
 {
+    this->update_exec_mode();
 }
 
 Socket&
@@ -99,6 +112,38 @@ Task::set_stats(const bool stats)
     this->stats = stats;
 }
 
+void
+Task::set_perf(const bool perf)
+{
+    this->perf = perf;
+}
+
+void
+Task::set_stats_clock(const tools::clock_source_t clock)
+{
+    if (clock == tools::clock_source_t::TSC && tools::clock_tsc_is_available())
+    {
+        // calibrate now to avoid the calibration overhead during the first measured call
+        tools::clock_tsc_calibrate();
+        this->stats_clock = tools::clock_source_t::TSC;
+    }
+    else
+        this->stats_clock = tools::clock_source_t::STEADY;
+}
+
+void
+Task::set_stats_sampling(const uint32_t n_calls)
+{
+    if (n_calls == 0)
+    {
+        std::stringstream message;
+        message << "'n_calls' has to be strictly positive ('task.name' = " << this->get_name()
+                << ", 'module.name' = " << this->get_module().get_name() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+    this->stats_sampling = n_calls;
+}
+
 void
 Task::set_fast(const bool fast)
 {
@@ -261,109 +306,242 @@ display_data(const T* data,
 void
 Task::_exec(const int frame_id, const bool managed_memory)
 {
-    const auto n_frames = this->get_module().get_n_frames();
-    const auto n_frames_per_wave = this->get_module().get_n_frames_per_wave();
-    const auto n_waves = this->get_module().get_n_waves();
-    const auto n_frames_per_wave_rest = this->get_module().get_n_frames_per_wave_rest();
-
     // do not use 'this->status' because the dataptr can have been changed by the 'tools::Sequence' when using the no
     // copy mode
     int* status = this->sockets.back()->get_dataptr<int>();
-    for (size_t w = 0; w < n_waves; w++)
+
+    if (this->exec_mode == exec_mode_t::SINGLE_WAVE)
+    {
+        // there is only one status and it is always overwritten, no need to reset it
+        if (frame_id <= 0 || managed_memory == false)
+            status[0] = this->codelet(*this->module, *this, frame_id == -1 ? 0 : frame_id);
+        else if (this->n_frames_per_wave > 1)
+            this->_exec_frame(frame_id, status);
+        else // the wave is the frame: the codelet is called in place
+            status[0] = this->codelet(*this->module, *this, 0);
+        return;
+    }
+
+    for (size_t w = 0; w < this->n_waves; w++)
         status[w] = (int)status_t::UNKNOWN;
 
-    if ((managed_memory == false && frame_id >= 0) || (frame_id == -1 && n_frames_per_wave == n_frames) ||
-        (frame_id == 0 && n_frames_per_wave == 1) || (frame_id == 0 && n_waves > 1) ||
-        (frame_id == 0 && n_frames_per_wave_rest == 0))
+    if ((managed_memory == false && frame_id >= 0) || (frame_id == 0 && this->n_waves > 1))
     {
-        const auto real_frame_id = frame_id == -1 ? 0 : frame_id;
-        const size_t w = (real_frame_id % n_frames) / n_frames_per_wave;
-        status[w] = this->codelet(*this->module, *this, real_frame_id);
+        const size_t w = ((size_t)frame_id % this->n_frames) / this->n_frames_per_wave;
+        status[w] = this->codelet(*this->module, *this, frame_id);
     }
+    else if (frame_id > 0 && this->n_frames_per_wave > 1)
+        this->_exec_frame(frame_id, status);
     else
     {
-        // save the initial dataptr of the sockets
+        const size_t w_start = (frame_id < 0) ? 0 : frame_id % this->n_waves;
+        const size_t w_stop = (frame_id < 0) ? this->n_waves : w_start + 1;
+        this->_exec_waves(w_start, w_stop, status);
+    }
+}
+
+void
+Task::_exec_waves(const size_t w_start, const size_t w_stop, int* status)
+{
+    // save the initial dataptr of the sockets
+    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
+        sockets_dataptr_init[sid] = (int8_t*)this->sockets[sid]->_get_dataptr();
+
+    // only the last wave can be partial, the full waves are directly processed in the sockets memory
+    const size_t w_stop_in_place =
+      (this->exec_mode == exec_mode_t::MULTI_WAVES_REST && w_stop == this->n_waves) ? w_stop - 1 : w_stop;
+
+    size_t w = 0;
+    auto exec_status = status_t::SUCCESS;
+    for (w = w_start; w < w_stop_in_place && exec_status != status_t::FAILURE_STOP; w++)
+    {
         for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-            sockets_dataptr_init[sid] = (int8_t*)this->sockets[sid]->_get_dataptr();
+            this->sockets[sid]->dataptr =
+              (void*)(sockets_dataptr_init[sid] + w * this->n_frames_per_wave * sockets_databytes_per_frame[sid]);
 
-        if (frame_id > 0 && managed_memory == true && n_frames_per_wave > 1)
+        status[w] = this->codelet(*this->module, *this, w * this->n_frames_per_wave);
+        exec_status = (status_t)status[w];
+    }
+
+    if (w < w_stop && exec_status != status_t::FAILURE_STOP)
+    {
+        for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
         {
-            const size_t w = (frame_id % n_frames) / n_frames_per_wave;
-            const size_t w_pos = frame_id % n_frames_per_wave;
+            if (sockets[sid]->get_type() == socket_t::SIN || sockets[sid]->get_type() == socket_t::SFWD)
+                std::copy(sockets_dataptr_init[sid] + w * this->n_frames_per_wave * sockets_databytes_per_frame[sid],
+                          sockets_dataptr_init[sid] + this->n_frames * sockets_databytes_per_frame[sid],
+                          sockets_data[sid].begin());
+            this->sockets[sid]->dataptr = (void*)sockets_data[sid].data();
+        }
 
-            for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-            {
-                if (sockets[sid]->get_type() == socket_t::SIN || sockets[sid]->get_type() == socket_t::SFWD)
-                    std::copy(
-                      sockets_dataptr_init[sid] + ((frame_id % n_frames) + 0) * sockets_databytes_per_frame[sid],
-                      sockets_dataptr_init[sid] + ((frame_id % n_frames) + 1) * sockets_databytes_per_frame[sid],
+        status[w] = this->codelet(*this->module, *this, w * this->n_frames_per_wave);
+
+        for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
+            if (sockets[sid]->get_type() == socket_t::SOUT || sockets[sid]->get_type() == socket_t::SFWD)
+                std::copy(sockets_data[sid].begin(),
+                          sockets_data[sid].begin() + this->n_frames_per_wave_rest * sockets_databytes_per_frame[sid],
+                          sockets_dataptr_init[sid] + w * this->n_frames_per_wave * sockets_databytes_per_frame[sid]);
+    }
+
+    // restore the initial dataptr of the sockets
+    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
+        this->sockets[sid]->dataptr = (void*)sockets_dataptr_init[sid];
+}
+
+void
+Task::_exec_frame(const int frame_id, int* status)
+{
+    // the other frames of the wave must not be modified: the selected frame is processed through the 'sockets_data'
+    // buffers
+    const size_t f = (size_t)frame_id % this->n_frames;
+    const size_t w = f / this->n_frames_per_wave;
+    const size_t w_pos = f % this->n_frames_per_wave;
+
+    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
+    {
+        sockets_dataptr_init[sid] = (int8_t*)this->sockets[sid]->_get_dataptr();
+        if (sockets[sid]->get_type() == socket_t::SIN || sockets[sid]->get_type() == socket_t::SFWD)
+            std::copy(sockets_dataptr_init[sid] + (f + 0) * sockets_databytes_per_frame[sid],
+                      sockets_dataptr_init[sid] + (f + 1) * sockets_databytes_per_frame[sid],
                       sockets_data[sid].begin() + w_pos * sockets_databytes_per_frame[sid]);
-                this->sockets[sid]->dataptr = (void*)sockets_data[sid].data();
-            }
+        this->sockets[sid]->dataptr = (void*)sockets_data[sid].data();
+    }
 
-            status[w] = this->codelet(*this->module, *this, w * n_frames_per_wave);
+    status[w] = this->codelet(*this->module, *this, w * this->n_frames_per_wave);
 
-            for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-                if (sockets[sid]->get_type() == socket_t::SOUT || sockets[sid]->get_type() == socket_t::SFWD)
-                    std::copy(sockets_data[sid].begin() + (w_pos + 0) * sockets_databytes_per_frame[sid],
-                              sockets_data[sid].begin() + (w_pos + 1) * sockets_databytes_per_frame[sid],
-                              sockets_dataptr_init[sid] + (frame_id % n_frames) * sockets_databytes_per_frame[sid]);
-        }
-        else // if (frame_id <= 0 || n_frames_per_wave == 1)
-        {
-            const size_t w_start = (frame_id < 0) ? 0 : frame_id % n_waves;
-            const size_t w_stop = (frame_id < 0) ? n_waves : w_start + 1;
+    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
+    {
+        if (sockets[sid]->get_type() == socket_t::SOUT || sockets[sid]->get_type() == socket_t::SFWD)
+            std::copy(sockets_data[sid].begin() + (w_pos + 0) * sockets_databytes_per_frame[sid],
+                      sockets_data[sid].begin() + (w_pos + 1) * sockets_databytes_per_frame[sid],
+                      sockets_dataptr_init[sid] + f * sockets_databytes_per_frame[sid]);
+        this->sockets[sid]->dataptr = (void*)sockets_dataptr_init[sid];
+    }
+}
 
-            size_t w = 0;
-            auto exec_status = status_t::SUCCESS;
-            for (w = w_start; w < w_stop - 1 && exec_status != status_t::FAILURE_STOP; w++)
-            {
-                for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-                    this->sockets[sid]->dataptr =
-                      (void*)(sockets_dataptr_init[sid] + w * n_frames_per_wave * sockets_databytes_per_frame[sid]);
+const std::vector<int>&
+Task::exec_waves(const size_t w_start, const size_t w_stop)
+{
+    const size_t w_stop_real = std::min(w_stop, this->n_waves);
+#ifndef AFF3CT_CORE_FAST
+    if (w_start >= w_stop_real)
+    {
+        std::stringstream message;
+        message << "'w_start' has to be smaller than 'w_stop' and 'n_waves' ('w_start' = " << w_start
+                << ", 'w_stop' = " << w_stop << ", 'n_waves' = " << this->n_waves << ").";
+        throw tools::length_error(__FILE__, __LINE__, __func__, message.str());
+    }
 
-                status[w] = this->codelet(*this->module, *this, w * n_frames_per_wave);
-                exec_status = (status_t)status[w];
-            }
+    // the regular 'exec' method throws the right exception when some of the sockets are not fed
+    if (!this->is_fast() && !this->can_exec()) return this->exec();
+#endif
 
-            if (exec_status != status_t::FAILURE_STOP)
-            {
-                if (n_frames_per_wave_rest == 0)
-                {
-                    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-                        this->sockets[sid]->dataptr =
-                          (void*)(sockets_dataptr_init[sid] + w * n_frames_per_wave * sockets_databytes_per_frame[sid]);
+    // do not use 'this->status' because the dataptr can have been changed by the 'tools::Sequence' when using the no
+    // copy mode
+    int* status = this->sockets.back()->get_dataptr<int>();
+    if (w_start == 0)
+        for (size_t w = 0; w < this->n_waves; w++)
+            status[w] = (int)status_t::UNKNOWN;
 
-                    status[w] = this->codelet(*this->module, *this, w * n_frames_per_wave);
-                }
-                else
-                {
-                    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-                    {
-                        if (sockets[sid]->get_type() == socket_t::SIN || sockets[sid]->get_type() == socket_t::SFWD)
-                            std::copy(sockets_dataptr_init[sid] +
-                                        w * n_frames_per_wave * sockets_databytes_per_frame[sid],
-                                      sockets_dataptr_init[sid] + n_frames * sockets_databytes_per_frame[sid],
-                                      sockets_data[sid].begin());
-                        this->sockets[sid]->dataptr = (void*)sockets_data[sid].data();
-                    }
+    const bool stats = this->is_stats() && this->is_stats_sampled();
+    if (stats)
+    {
+        uint64_t perf_values[tools::perf_n_events];
+        this->perf_start(perf_values);
+        const auto t_start = tools::clock_now(this->stats_clock);
+        this->_exec_waves(w_start, w_stop_real, status);
+        this->duration_partial += tools::clock_elapsed(this->stats_clock, t_start);
+        this->perf_stop(perf_values);
+    }
+    else
+        this->_exec_waves(w_start, w_stop_real, status);
+
+    // the statistics are committed when the last wave has been processed or when a wave stopped the task (like
+    // 'exec', the next waves are not executed), this way a call to 'exec_waves' on the full range of the waves is
+    // accounted as one call to 'exec'
+    bool over = w_stop_real == this->n_waves;
+    for (size_t w = w_start; w < w_stop_real && !over; w++)
+        over = status[w] == status_t::FAILURE_STOP;
+    if (over)
+    {
+        if (stats) this->commit_partial_stats();
+        this->n_calls++;
+    }
 
-                    status[w] = this->codelet(*this->module, *this, w * n_frames_per_wave);
+    return this->get_status();
+}
 
-                    for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-                        if (sockets[sid]->get_type() == socket_t::SOUT || sockets[sid]->get_type() == socket_t::SFWD)
-                            std::copy(
-                              sockets_data[sid].begin(),
-                              sockets_data[sid].begin() + n_frames_per_wave_rest * sockets_databytes_per_frame[sid],
-                              sockets_dataptr_init[sid] + w * n_frames_per_wave * sockets_databytes_per_frame[sid]);
-                }
-            }
-        }
+const std::vector<int>&
+Task::exec_elmts(const size_t e_start, const size_t e_stop, void* const* dataptrs)
+{
+    const size_t n_elmts = this->sockets[0]->get_n_elmts();
+#ifndef AFF3CT_CORE_FAST
+    if (!this->is_elmtwise())
+    {
+        std::stringstream message;
+        message << "This task has no element-wise codelet for the type of its module ('task.name' = "
+                << this->get_name() << ", 'module.name' = " << this->get_module().get_name() << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
 
-        // restore the initial dataptr of the sockets
-        for (size_t sid = 0; sid < this->sockets.size() - 1; sid++)
-            this->sockets[sid]->dataptr = (void*)sockets_dataptr_init[sid];
+    if (e_start >= e_stop || e_stop > n_elmts)
+    {
+        std::stringstream message;
+        message << "'e_start' has to be smaller than 'e_stop' and 'e_stop' has to be smaller or equal to 'n_elmts' "
+                << "('e_start' = " << e_start << ", 'e_stop' = " << e_stop << ", 'n_elmts' = " << n_elmts << ").";
+        throw tools::length_error(__FILE__, __LINE__, __func__, message.str());
     }
+
+    // the regular 'exec' method throws the right exception when some of the sockets are not fed
+    if (!this->is_fast() && !this->can_exec()) return this->exec();
+#endif
+
+    int* status = this->sockets.back()->get_dataptr<int>();
+    if (e_start == 0)
+        for (size_t w = 0; w < this->n_waves; w++)
+            status[w] = (int)status_t::UNKNOWN;
+
+    if (this->is_stats() && this->is_stats_sampled())
+    {
+        uint64_t perf_values[tools::perf_n_events];
+        this->perf_start(perf_values);
+        const auto t_start = tools::clock_now(this->stats_clock);
+        this->elmtwise_codelet(*this->module, *this, dataptrs, e_stop - e_start);
+        this->duration_partial += tools::clock_elapsed(this->stats_clock, t_start);
+        this->perf_stop(perf_values);
+
+        if (e_stop == n_elmts) this->commit_partial_stats();
+    }
+    else
+        this->elmtwise_codelet(*this->module, *this, dataptrs, e_stop - e_start);
+
+    if (e_stop == n_elmts)
+    {
+        // an element-wise codelet cannot fail
+        for (size_t w = 0; w < this->n_waves; w++)
+            status[w] = (int)status_t::SUCCESS;
+        this->n_calls++;
+    }
+
+    return this->get_status();
+}
+
+void
+Task::commit_partial_stats()
+{
+    this->duration_total += this->duration_partial;
+    if (this->n_sampled_calls)
+    {
+        this->duration_min = std::min(this->duration_min.load(), this->duration_partial);
+        this->duration_max = std::max(this->duration_max.load(), this->duration_partial);
+    }
+    else
+    {
+        this->duration_min = this->duration_partial;
+        this->duration_max = this->duration_partial;
+    }
+    this->duration_partial = std::chrono::nanoseconds(0);
+    this->n_sampled_calls++;
 }
 
 const std::vector<int>&
@@ -536,23 +714,27 @@ Task::exec(const int frame_id, const bool managed_memory)
             }
         }
 
-        if (this->is_stats())
+        if (this->is_stats() && this->is_stats_sampled())
         {
-            auto t_start = std::chrono::steady_clock::now();
+            uint64_t perf_values[tools::perf_n_events];
+            this->perf_start(perf_values);
+            const auto t_start = tools::clock_now(this->stats_clock);
             this->_exec(frame_id, managed_memory);
-            auto duration = std::chrono::steady_clock::now() - t_start;
+            const auto duration = tools::clock_elapsed(this->stats_clock, t_start);
+            this->perf_stop(perf_values);
 
             this->duration_total += duration;
-            if (n_calls)
+            if (this->n_sampled_calls)
             {
-                this->duration_min = std::min(this->duration_min, duration);
-                this->duration_max = std::max(this->duration_max, duration);
+                this->duration_min = std::min(this->duration_min.load(), duration);
+                this->duration_max = std::max(this->duration_max.load(), duration);
             }
             else
             {
                 this->duration_min = duration;
                 this->duration_max = duration;
             }
+            this->n_sampled_calls++;
         }
         else
         {
@@ -1075,6 +1257,41 @@ Task::create_codelet(std::function<int(module::Module& m, Task& t, const size_t
     this->sockets[s]->dataptr = (void*)this->status.data();
 }
 
+void
+Task::create_elmtwise_codelet(
+  std::function<void(module::Module& m, Task& t, void* const* dataptrs, const size_t n_elmts)>& codelet,
+  const std::type_index& type)
+{
+    if (this->sockets.empty() || this->sockets.back()->get_name() != "status")
+    {
+        std::stringstream message;
+        message << "The regular codelet has to be created before the element-wise codelet ('task.name' = "
+                << this->get_name() << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    for (size_t s = 1; s < this->sockets.size() - 1; s++)
+        if (this->sockets[s]->get_n_elmts() != this->sockets[0]->get_n_elmts())
+        {
+            std::stringstream message;
+            message << "All the sockets of an element-wise task have to contain the same number of elements "
+                    << "('sockets[" << s << "]->get_n_elmts()' = " << this->sockets[s]->get_n_elmts()
+                    << ", 'sockets[0]->get_n_elmts()' = " << this->sockets[0]->get_n_elmts()
+                    << ", 'task.name' = " << this->get_name() << ").";
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+        }
+
+    this->elmtwise_codelet = codelet;
+    this->elmtwise_type = type;
+}
+
+bool
+Task::is_elmtwise() const
+{
+    // a derived module has to create its own element-wise codelet to be fused
+    return this->elmtwise_codelet != nullptr && this->elmtwise_type == std::type_index(typeid(*this->module));
+}
+
 void
 Task::update_n_frames(const size_t old_n_frames, const size_t new_n_frames)
 {
@@ -1107,6 +1324,8 @@ Task::update_n_frames(const size_t old_n_frames, const size_t new_n_frames)
             }
         }
     }
+
+    this->update_exec_mode();
 }
 
 void
@@ -1131,6 +1350,24 @@ Task::update_n_frames_per_wave(const size_t old_n_frames_per_wave, const size_t
         }
         s_id++;
     }
+
+    this->update_exec_mode();
+}
+
+void
+Task::update_exec_mode()
+{
+    this->n_frames = this->get_module().get_n_frames();
+    this->n_frames_per_wave = this->get_module().get_n_frames_per_wave();
+    this->n_waves = this->get_module().get_n_waves();
+    this->n_frames_per_wave_rest = this->get_module().get_n_frames_per_wave_rest();
+
+    if (this->n_frames_per_wave_rest != 0)
+        this->exec_mode = exec_mode_t::MULTI_WAVES_REST;
+    else if (this->n_waves > 1)
+        this->exec_mode = exec_mode_t::MULTI_WAVES;
+    else
+        this->exec_mode = exec_mode_t::SINGLE_WAVE;
 }
 
 bool
@@ -1144,13 +1381,14 @@ Task::can_exec() const
 std::chrono::nanoseconds
 Task::get_duration_total() const
 {
-    return this->duration_total;
+    if (this->n_sampled_calls == this->n_calls) return this->duration_total;
+    return std::chrono::nanoseconds((int64_t)((double)this->duration_total.load().count() * this->get_stats_extrapolation()));
 }
 
 std::chrono::nanoseconds
 Task::get_duration_avg() const
 {
-    return this->duration_total / this->n_calls;
+    return this->get_duration_total() / this->n_calls.load();
 }
 
 std::chrono::nanoseconds
@@ -1183,6 +1421,28 @@ Task::get_timers_total() const
     return this->timers_total;
 }
 
+std::vector<uint32_t>
+Task::get_timers_n_calls_extrapolated() const
+{
+    if (this->n_sampled_calls == this->n_calls) return this->timers_n_calls;
+    const double factor = this->get_stats_extrapolation();
+    std::vector<uint32_t> n_calls(this->timers_n_calls.size());
+    for (size_t t = 0; t < n_calls.size(); t++)
+        n_calls[t] = (uint32_t)((double)this->timers_n_calls[t] * factor);
+    return n_calls;
+}
+
+std::vector<std::chrono::nanoseconds>
+Task::get_timers_total_extrapolated() const
+{
+    if (this->n_sampled_calls == this->n_calls) return this->timers_total;
+    const double factor = this->get_stats_extrapolation();
+    std::vector<std::chrono::nanoseconds> total(this->timers_total.size());
+    for (size_t t = 0; t < total.size(); t++)
+        total[t] = std::chrono::nanoseconds((int64_t)((double)this->timers_total[t].count() * factor));
+    return total;
+}
+
 const std::vector<std::chrono::nanoseconds>&
 Task::get_timers_min() const
 {
@@ -1195,6 +1455,18 @@ Task::get_timers_max() const
     return this->timers_max;
 }
 
+const std::vector<uint64_t>&
+Task::get_perf_total() const
+{
+    return this->perf_total;
+}
+
+double
+Task::get_stats_extrapolation() const
+{
+    return this->n_sampled_calls ? (double)this->n_calls / (double)this->n_sampled_calls : 0.;
+}
+
 size_t
 Task::get_n_input_sockets() const
 {
@@ -1227,9 +1499,12 @@ void
 Task::reset()
 {
     this->n_calls = 0;
+    this->n_sampled_calls = 0;
     this->duration_total = std::chrono::nanoseconds(0);
     this->duration_min = std::chrono::nanoseconds(0);
     this->duration_max = std::chrono::nanoseconds(0);
+    this->duration_partial = std::chrono::nanoseconds(0);
+    std::fill(this->perf_total.begin(), this->perf_total.end(), 0);
 
     for (auto& x : this->timers_n_calls)
         x = 0;
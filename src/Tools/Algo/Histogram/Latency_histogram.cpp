@@ -0,0 +1,98 @@
+#include <algorithm>
+#include <limits>
+#include <sstream>
+
+#include "Tools/Algo/Histogram/Latency_histogram.hpp"
+#include "Tools/Exception/exception.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+Latency_histogram::Latency_histogram()
+{
+    this->reset();
+}
+
+void
+Latency_histogram::reset()
+{
+    for (auto& b : this->buckets)
+        b = 0;
+    this->n_values = 0;
+    this->total = 0;
+    this->min = std::numeric_limits<uint64_t>::max();
+    this->max = 0;
+}
+
+uint64_t
+Latency_histogram::get_n_values() const
+{
+    return this->n_values.load(std::memory_order_acquire);
+}
+
+uint64_t
+Latency_histogram::get_bucket(const size_t b) const
+{
+    if (b >= Latency_histogram::n_buckets)
+    {
+        std::stringstream message;
+        message << "'b' has to be smaller than 'n_buckets' ('b' = " << b
+                << ", 'n_buckets' = " << Latency_histogram::n_buckets << ").";
+        throw tools::out_of_range(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->buckets[b].load(std::memory_order_relaxed);
+}
+
+std::chrono::nanoseconds
+Latency_histogram::get_total() const
+{
+    return std::chrono::nanoseconds(this->total.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds
+Latency_histogram::get_avg() const
+{
+    const auto n_values = this->get_n_values();
+    return n_values ? this->get_total() / (int64_t)n_values : std::chrono::nanoseconds(0);
+}
+
+std::chrono::nanoseconds
+Latency_histogram::get_min() const
+{
+    return this->get_n_values() ? std::chrono::nanoseconds(this->min.load(std::memory_order_relaxed))
+                                : std::chrono::nanoseconds(0);
+}
+
+std::chrono::nanoseconds
+Latency_histogram::get_max() const
+{
+    return std::chrono::nanoseconds(this->max.load(std::memory_order_relaxed));
+}
+
+std::chrono::nanoseconds
+Latency_histogram::get_percentile(const float p) const
+{
+    if (p < 0.f || p > 100.f)
+    {
+        std::stringstream message;
+        message << "'p' has to be in [0;100] ('p' = " << p << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    const auto n_values = this->get_n_values();
+    if (n_values == 0) return std::chrono::nanoseconds(0);
+
+    const uint64_t rank = std::max((uint64_t)1, (uint64_t)((double)p / 100. * (double)n_values + 0.5));
+    uint64_t count = 0;
+    size_t b = 0;
+    for (; b < Latency_histogram::n_buckets - 1; b++)
+    {
+        count += this->buckets[b].load(std::memory_order_relaxed);
+        if (count >= rank) break;
+    }
+
+    const uint64_t upper = b < 63 ? ((uint64_t)1 << (b + 1)) - 1 : std::numeric_limits<uint64_t>::max();
+    const uint64_t value = std::max(upper, (uint64_t)this->get_min().count());
+    return std::chrono::nanoseconds(std::min(value, (uint64_t)this->get_max().count()));
+}
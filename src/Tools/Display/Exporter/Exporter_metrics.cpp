@@ -0,0 +1,553 @@
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define AFF3CT_CORE_METRICS_SOCKETS
+#endif
+
+#include "Module/Adaptor/Adaptor.hpp"
+#include "Runtime/Pipeline/Pipeline.hpp"
+#include "Runtime/Sequence/Sequence.hpp"
+#include "Runtime/Task/Task.hpp"
+#include "Tools/Display/Exporter/Exporter_metrics.hpp"
+#include "Tools/Exception/exception.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+const size_t aff3ct::tools::Exporter_metrics::max_column_size = 64;
+
+static std::string
+escape_label(const std::string& value)
+{
+    std::string escaped;
+    for (auto c : value)
+    {
+        if (c == '\\')
+            escaped += "\\\\";
+        else if (c == '"')
+            escaped += "\\\"";
+        else if (c == '\n')
+            escaped += "\\n";
+        else
+            escaped += c;
+    }
+    return escaped;
+}
+
+static std::string
+label(const std::string& name, const std::string& value)
+{
+    return name + "=\"" + escape_label(value) + "\"";
+}
+
+template<typename T>
+static double
+column_value(const Reporter::column_t& column, const size_t row, const size_t e)
+{
+    return (double)column.get_data<T>(row)[e];
+}
+
+static bool
+column_to_double(const Reporter::column_t& column, const size_t row, const size_t e, double& value)
+{
+    // clang-format off
+    if      (column.datatype == typeid(double  )) value = column_value<double  >(column, row, e);
+    else if (column.datatype == typeid(float   )) value = column_value<float   >(column, row, e);
+    else if (column.datatype == typeid(int64_t )) value = column_value<int64_t >(column, row, e);
+    else if (column.datatype == typeid(uint64_t)) value = column_value<uint64_t>(column, row, e);
+    else if (column.datatype == typeid(int32_t )) value = column_value<int32_t >(column, row, e);
+    else if (column.datatype == typeid(uint32_t)) value = column_value<uint32_t>(column, row, e);
+    else if (column.datatype == typeid(int16_t )) value = column_value<int16_t >(column, row, e);
+    else if (column.datatype == typeid(uint16_t)) value = column_value<uint16_t>(column, row, e);
+    else if (column.datatype == typeid(int8_t  )) value = column_value<int8_t  >(column, row, e);
+    else if (column.datatype == typeid(uint8_t )) value = column_value<uint8_t >(column, row, e);
+    else return false;
+    // clang-format on
+    return true;
+}
+
+Exporter_metrics::Exporter_metrics(const std::string& address, const std::vector<tools::Reporter*>& reporters)
+  : stop_server(false)
+  , listen_fd(-1)
+  , address(address)
+  , reporters(reporters)
+  , snapshots(reporters.size())
+  , last_values(reporters.size())
+  , n_scrapes(0)
+{
+    for (auto& r : this->reporters)
+        if (r == nullptr)
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, "'reporters' contains null pointer.");
+
+    if (address.find("unix:") != 0 && address.find("tcp:") != 0)
+    {
+        std::stringstream message;
+        message << "'address' has to start with 'unix:' or 'tcp:' ('address' = " << address << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+}
+
+Exporter_metrics::Exporter_metrics(const std::string& address,
+                                   const std::vector<std::unique_ptr<tools::Reporter>>& reporters)
+  : Exporter_metrics(address,
+                     [&reporters]()
+                     {
+                         std::vector<tools::Reporter*> reps;
+                         for (auto const& r : reporters)
+                             reps.push_back(r.get());
+                         return reps;
+                     }())
+{
+}
+
+Exporter_metrics::~Exporter_metrics()
+{
+    // try to join the thread and to close the socket if this is not been done by the user
+    try
+    {
+        this->stop();
+    }
+    catch (...)
+    { /* do not throw from the destructor */
+    }
+}
+
+void
+Exporter_metrics::register_sequence(runtime::Sequence& sequence, const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(this->mutex_scrape);
+    this->sequences.push_back(std::make_pair(name, &sequence));
+}
+
+void
+Exporter_metrics::register_pipeline(runtime::Pipeline& pipeline, const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(this->mutex_scrape);
+    this->pipelines.push_back(std::make_pair(name, &pipeline));
+}
+
+void
+Exporter_metrics::start()
+{
+    this->stop();
+
+#if defined(AFF3CT_CORE_METRICS_SOCKETS)
+    if (this->address.find("unix:") == 0)
+    {
+        const std::string path = this->address.substr(5);
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        if (path.empty() || path.size() >= sizeof(addr.sun_path))
+        {
+            std::stringstream message;
+            message << "The Unix socket path is empty or too long ('path' = " << path << ").";
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+        }
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+        // remove the socket left by a previous run (but never a regular file)
+        struct stat st;
+        if (stat(path.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) unlink(path.c_str());
+
+        this->listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (this->listen_fd < 0 || bind(this->listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+        {
+            if (this->listen_fd >= 0) close(this->listen_fd);
+            this->listen_fd = -1;
+            std::stringstream message;
+            message << "The Unix socket cannot be bound ('path' = " << path << ", 'errno' = " << errno << ").";
+            throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+        }
+    }
+    else
+    {
+        // "tcp:<port>" or "tcp:<host>:<port>", only the loopback interface is allowed
+        const std::string host_port = this->address.substr(4);
+        const auto colon = host_port.rfind(':');
+        std::string host = colon == std::string::npos ? "127.0.0.1" : host_port.substr(0, colon);
+        const std::string port = colon == std::string::npos ? host_port : host_port.substr(colon + 1);
+        if (host == "localhost") host = "127.0.0.1";
+
+        sockaddr_in addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        const int port_val = std::atoi(port.c_str());
+        if (inet_pton(AF_INET, host.c_str(), &addr.sin_addr) != 1 || (ntohl(addr.sin_addr.s_addr) >> 24) != 127 ||
+            port_val < 0 || port_val > 65535 || port.empty())
+        {
+            std::stringstream message;
+            message << "The TCP address has to be a loopback address with a valid port ('address' = "
+                    << this->address << ").";
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+        }
+        addr.sin_port = htons((uint16_t)port_val);
+
+        this->listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+        const int reuse = 1;
+        if (this->listen_fd >= 0) setsockopt(this->listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (this->listen_fd < 0 || bind(this->listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0)
+        {
+            if (this->listen_fd >= 0) close(this->listen_fd);
+            this->listen_fd = -1;
+            std::stringstream message;
+            message << "The TCP socket cannot be bound ('address' = " << this->address << ", 'errno' = " << errno
+                    << ").";
+            throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+        }
+    }
+
+    if (listen(this->listen_fd, 8) != 0)
+    {
+        close(this->listen_fd);
+        this->listen_fd = -1;
+        std::stringstream message;
+        message << "The socket cannot listen ('address' = " << this->address << ", 'errno' = " << errno << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // launch a thread dedicated to the server
+    this->stop_server = false;
+    this->srv_thread = std::thread(Exporter_metrics::start_thread_server, this);
+#else
+    std::stringstream message;
+    message << "The metrics server is only available on the Unix-like systems.";
+    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+#endif
+}
+
+void
+Exporter_metrics::stop()
+{
+    if (this->srv_thread.joinable())
+    {
+        this->stop_server = true;
+        // wait the server thread to finish (it polls the socket with a short timeout)
+        this->srv_thread.join();
+        this->stop_server = false;
+    }
+
+#if defined(AFF3CT_CORE_METRICS_SOCKETS)
+    if (this->listen_fd >= 0)
+    {
+        close(this->listen_fd);
+        this->listen_fd = -1;
+        if (this->address.find("unix:") == 0) unlink(this->address.substr(5).c_str());
+    }
+#endif
+}
+
+void
+Exporter_metrics::add_sample(std::vector<family_t>& families,
+                             const std::string& name,
+                             const std::string& help,
+                             const std::string& type,
+                             const std::string& labels,
+                             const double value,
+                             const std::string& suffix)
+{
+    size_t f = 0;
+    while (f < families.size() && families[f].name != name)
+        f++;
+    if (f == families.size())
+    {
+        families.push_back(family_t());
+        families[f].name = name;
+        families[f].help = help;
+        families[f].type = type;
+    }
+
+    std::stringstream sample;
+    sample << std::setprecision(std::numeric_limits<double>::max_digits10) << name << suffix;
+    if (!labels.empty()) sample << "{" << labels << "}";
+    sample << " " << value;
+    families[f].samples.push_back(sample.str());
+}
+
+void
+Exporter_metrics::scrape_probes(std::vector<family_t>& families)
+{
+    for (size_t r = 0; r < this->reporters.size(); r++)
+    {
+        if (!this->reporters[r]->snapshot(this->snapshots[r], true))
+        {
+            std::stringstream message;
+            message << "The reporter does not support typed snapshots ('r' = " << r << ").";
+            throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+        }
+
+        // keep the last valid value of each column, the columns without new values keep their previous value
+        auto& groups = this->reporters[r]->get_groups();
+        auto& snap = this->snapshots[r];
+        this->last_values[r].resize(snap.size());
+        for (size_t g = 0; g < snap.size(); g++)
+        {
+            this->last_values[r][g].resize(snap[g].size());
+            for (size_t c = 0; c < snap[g].size(); c++)
+            {
+                auto& column = snap[g][c];
+                auto& values = this->last_values[r][g][c];
+                if (column.data_size > Exporter_metrics::max_column_size) continue;
+                for (size_t row = column.n_rows; row > 0; row--)
+                    if (column.valid[row - 1])
+                    {
+                        values.resize(column.data_size);
+                        for (size_t e = 0; e < column.data_size; e++)
+                            if (!column_to_double(column, row - 1, e, values[e])) values.clear();
+                        break;
+                    }
+
+                const std::string labels = label("group", std::get<0>(groups[g].first)) + "," +
+                                           label("column", std::get<0>(groups[g].second[c])) + "," +
+                                           label("unit", std::get<1>(groups[g].second[c]));
+                for (size_t e = 0; e < values.size(); e++)
+                    Exporter_metrics::add_sample(families,
+                                                 "aff3ct_probe_value",
+                                                 "Last value collected by a probe.",
+                                                 "gauge",
+                                                 values.size() > 1 ? labels + "," + label("index", std::to_string(e))
+                                                                   : labels,
+                                                 values[e]);
+            }
+        }
+    }
+}
+
+void
+Exporter_metrics::scrape_tasks(std::vector<family_t>& families,
+                               const std::string& labels,
+                               const std::vector<std::vector<runtime::Task*>>& tasks_per_threads)
+{
+    for (size_t t = 0; t < tasks_per_threads.size(); t++)
+        for (auto tsk : tasks_per_threads[t])
+        {
+            auto& mdl = tsk->get_module();
+            const std::string module_name =
+              mdl.get_custom_name().empty() ? mdl.get_short_name() : mdl.get_custom_name();
+            const std::string tsk_labels = labels + "," + label("replica", std::to_string(t)) + "," +
+                                           label("module", module_name) + "," + label("task", tsk->get_name());
+
+            Exporter_metrics::add_sample(families,
+                                         "aff3ct_task_calls_total",
+                                         "Number of executions of a task.",
+                                         "counter",
+                                         tsk_labels,
+                                         (double)tsk->get_n_calls());
+            if (!tsk->is_stats()) continue;
+
+            Exporter_metrics::add_sample(families,
+                                         "aff3ct_task_duration_seconds_total",
+                                         "Cumulated duration of the executions of a task.",
+                                         "counter",
+                                         tsk_labels,
+                                         (double)tsk->get_duration_total().count() * 1e-9);
+            if (tsk->get_n_sampled_calls() == 0) continue;
+
+            Exporter_metrics::add_sample(families,
+                                         "aff3ct_task_duration_min_seconds",
+                                         "Shortest execution of a task.",
+                                         "gauge",
+                                         tsk_labels,
+                                         (double)tsk->get_duration_min().count() * 1e-9);
+            Exporter_metrics::add_sample(families,
+                                         "aff3ct_task_duration_max_seconds",
+                                         "Longest execution of a task.",
+                                         "gauge",
+                                         tsk_labels,
+                                         (double)tsk->get_duration_max().count() * 1e-9);
+        }
+}
+
+void
+Exporter_metrics::scrape_pipeline(std::vector<family_t>& families,
+                                  const std::string& labels,
+                                  runtime::Pipeline& pipeline)
+{
+    auto stages = pipeline.get_stages();
+    for (size_t s = 0; s < stages.size(); s++)
+        this->scrape_tasks(
+          families, labels + "," + label("stage", std::to_string(s)), stages[s]->get_tasks_per_threads());
+
+    if (pipeline.is_synchro_telemetry())
+        for (size_t s = 0; s + 1 < stages.size(); s++)
+            for (auto push_side : { true, false })
+            {
+                const auto telemetry = pipeline.get_synchro_telemetry(s, push_side);
+                for (size_t t = 0; t < telemetry.size(); t++)
+                {
+                    const auto& tlm = telemetry[t];
+                    const std::string adp_labels = labels + "," + label("sync", std::to_string(s)) + "," +
+                                                   label("side", push_side ? "push" : "pull") + "," +
+                                                   label("replica", std::to_string(t));
+                    // clang-format off
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_calls_total",
+                                                 "Number of push/pull calls on a synchronization buffer.",
+                                                 "counter", adp_labels, (double)tlm.n_calls);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_blocked_total",
+                                                 "Number of push/pull calls that had to wait for a slot.",
+                                                 "counter", adp_labels, (double)tlm.n_blocked);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_wait_seconds_total",
+                                                 "Cumulated time spent waiting for a slot.",
+                                                 "counter", adp_labels, (double)tlm.wait_duration.load().count() * 1e-9);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_spins_total",
+                                                 "Number of active waiting iterations.",
+                                                 "counter", adp_labels, (double)tlm.n_spins);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_sleeps_total",
+                                                 "Number of passive waiting wake-ups.",
+                                                 "counter", adp_labels, (double)tlm.n_sleeps);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_occupancy_avg",
+                                                 "Average number of filled slots seen by the push/pull calls.",
+                                                 "gauge", adp_labels,
+                                                 tlm.n_calls ? (double)tlm.occupancy_sum / (double)tlm.n_calls : 0.);
+                    Exporter_metrics::add_sample(families, "aff3ct_adaptor_occupancy_max",
+                                                 "Maximum number of filled slots seen by the push/pull calls.",
+                                                 "gauge", adp_labels, (double)tlm.occupancy_max);
+                    // clang-format on
+                }
+            }
+
+    if (pipeline.is_latency_tracking())
+    {
+        const auto& latency = pipeline.get_latency();
+        const std::string help = "End-to-end latency of the frames through the pipeline.";
+        for (auto q : { 0.5f, 0.9f, 0.99f })
+        {
+            std::stringstream quantile;
+            quantile << q;
+            Exporter_metrics::add_sample(families,
+                                         "aff3ct_pipeline_latency_seconds",
+                                         help,
+                                         "summary",
+                                         labels + "," + label("quantile", quantile.str()),
+                                         (double)latency.get_percentile(q * 100.f).count() * 1e-9);
+        }
+        Exporter_metrics::add_sample(families,
+                                     "aff3ct_pipeline_latency_seconds",
+                                     help,
+                                     "summary",
+                                     labels,
+                                     (double)latency.get_total().count() * 1e-9,
+                                     "_sum");
+        Exporter_metrics::add_sample(families,
+                                     "aff3ct_pipeline_latency_seconds",
+                                     help,
+                                     "summary",
+                                     labels,
+                                     (double)latency.get_n_values(),
+                                     "_count");
+    }
+}
+
+std::string
+Exporter_metrics::scrape()
+{
+    std::unique_lock<std::mutex> lock(this->mutex_scrape);
+
+    std::vector<family_t> families;
+    this->scrape_probes(families);
+    for (auto& seq : this->sequences)
+        this->scrape_tasks(families, label("sequence", seq.first), seq.second->get_tasks_per_threads());
+    for (auto& pip : this->pipelines)
+        this->scrape_pipeline(families, label("pipeline", pip.first), *pip.second);
+
+    std::stringstream text;
+    for (auto& family : families)
+    {
+        text << "# HELP " << family.name << " " << family.help << "\n";
+        text << "# TYPE " << family.name << " " << family.type << "\n";
+        for (auto& sample : family.samples)
+            text << sample << "\n";
+    }
+
+    this->n_scrapes++;
+    return text.str();
+}
+
+const std::string&
+Exporter_metrics::get_address() const
+{
+    return this->address;
+}
+
+size_t
+Exporter_metrics::get_n_scrapes() const
+{
+    return this->n_scrapes;
+}
+
+void
+Exporter_metrics::start_thread_server(Exporter_metrics* exporter)
+{
+    Thread_pinning::pin_auxiliary();
+#if defined(AFF3CT_CORE_METRICS_SOCKETS)
+#if defined(MSG_NOSIGNAL)
+    const int send_flags = MSG_NOSIGNAL; // do not raise SIGPIPE when the client leaves early
+#else
+    const int send_flags = 0;
+#endif
+    while (!exporter->stop_server)
+    {
+        pollfd pfd = { exporter->listen_fd, POLLIN, 0 };
+        if (poll(&pfd, 1, 100) <= 0) continue;
+
+        const int client_fd = accept(exporter->listen_fd, nullptr, nullptr);
+        if (client_fd < 0) continue;
+#if defined(SO_NOSIGPIPE)
+        const int no_sigpipe = 1;
+        setsockopt(client_fd, SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+
+        // read the request (if any), its content is ignored: all the requests get the metrics
+        std::string request;
+        char buffer[1024];
+        pollfd cfd = { client_fd, POLLIN, 0 };
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 16384 && poll(&cfd, 1, 100) > 0)
+        {
+            const auto n = recv(client_fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) break;
+            request.append(buffer, (size_t)n);
+        }
+
+        std::string body;
+        try
+        {
+            body = exporter->scrape();
+        }
+        catch (std::exception& e)
+        {
+            body = std::string("# error: ") + e.what() + "\n";
+        }
+
+        std::stringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << body;
+        const std::string data = response.str();
+        size_t sent = 0;
+        while (sent < data.size())
+        {
+            const auto n = send(client_fd, data.data() + sent, data.size() - sent, send_flags);
+            if (n <= 0) break;
+            sent += (size_t)n;
+        }
+        close(client_fd);
+    }
+#else
+    (void)exporter;
+#endif
+}
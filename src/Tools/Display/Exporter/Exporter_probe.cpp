@@ -0,0 +1,280 @@
+#include <sstream>
+
+#include "Tools/Display/Exporter/Exporter_probe.hpp"
+#include "Tools/Exception/exception.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+const char aff3ct::tools::Exporter_probe::magic[8] = { 'A', 'F', 'F', '3', 'C', 'T', 'P', 'B' };
+const uint32_t aff3ct::tools::Exporter_probe::version = 1;
+const uint32_t aff3ct::tools::Exporter_probe::block_magic = 0x4B4C4F42; // "BLOK" in little endian
+
+static const std::vector<std::type_index> exporter_datatypes = {
+    typeid(double),  typeid(float),    typeid(int64_t), typeid(uint64_t), typeid(int32_t),
+    typeid(uint32_t), typeid(int16_t), typeid(uint16_t), typeid(int8_t),  typeid(uint8_t)
+};
+
+static const std::vector<size_t> exporter_datatype_sizes = { 8, 4, 8, 8, 4, 4, 2, 2, 1, 1 };
+
+uint8_t
+aff3ct::tools::exporter_datatype_to_code(const std::type_index& datatype)
+{
+    for (size_t c = 0; c < exporter_datatypes.size(); c++)
+        if (exporter_datatypes[c] == datatype) return (uint8_t)c;
+
+    std::stringstream message;
+    message << "Unsupported type.";
+    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+}
+
+std::type_index
+aff3ct::tools::exporter_code_to_datatype(const uint8_t code)
+{
+    if (code >= exporter_datatypes.size())
+    {
+        std::stringstream message;
+        message << "Unsupported type code ('code' = " << +code << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+    return exporter_datatypes[code];
+}
+
+size_t
+aff3ct::tools::exporter_code_to_size(const uint8_t code)
+{
+    exporter_code_to_datatype(code); // check the code
+    return exporter_datatype_sizes[code];
+}
+
+template<typename T>
+static void
+write_value(std::ofstream& file, const T& value)
+{
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void
+write_string(std::ofstream& file, const std::string& str)
+{
+    write_value<uint32_t>(file, (uint32_t)str.size());
+    file.write(str.data(), str.size());
+}
+
+Exporter_probe::Exporter_probe(const std::string& filepath, const std::vector<tools::Reporter*>& reporters)
+  : stop_exporter(false)
+  , reporters(reporters)
+  , snapshots(reporters.size())
+  , filepath(filepath)
+  , file(filepath, std::ios::out | std::ios::binary | std::ios::trunc)
+  , header_written(false)
+  , n_columns(0)
+  , n_blocks(0)
+  , n_values(0)
+{
+    for (auto& r : this->reporters)
+        if (r == nullptr)
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, "'reporters' contains null pointer.");
+
+    if (!this->file.is_open())
+    {
+        std::stringstream message;
+        message << "'filepath' file cannot be opened ('filepath' = " << filepath << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+}
+
+Exporter_probe::Exporter_probe(const std::string& filepath,
+                               const std::vector<std::unique_ptr<tools::Reporter>>& reporters)
+  : Exporter_probe(filepath,
+                   [&reporters]()
+                   {
+                       std::vector<tools::Reporter*> reps;
+                       for (auto const& r : reporters)
+                           reps.push_back(r.get());
+                       return reps;
+                   }())
+{
+}
+
+Exporter_probe::~Exporter_probe()
+{
+    // try to join the thread and to drain the reporters if this is not been done by the user
+    try
+    {
+        this->stop();
+    }
+    catch (...)
+    { /* do not throw from the destructor */
+    }
+}
+
+void
+Exporter_probe::start(const std::chrono::milliseconds freq)
+{
+    // the first drain is done by the caller thread: the errors on the reporters are thrown here and not in the
+    // background thread
+    this->stop();
+
+    // launch a thread dedicated to the export
+    exp_thread = std::thread(Exporter_probe::start_thread_exporter, this, freq);
+}
+
+void
+Exporter_probe::stop()
+{
+    if (exp_thread.joinable())
+    {
+        {
+            std::unique_lock<std::mutex> lock(this->mutex_exporter);
+            stop_exporter = true;
+        }
+        cond_exporter.notify_all();
+        // wait the exporter thread to finish
+        exp_thread.join();
+        stop_exporter = false;
+
+        if (this->exp_exception)
+        {
+            std::exception_ptr e = this->exp_exception;
+            this->exp_exception = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+
+    this->flush();
+}
+
+void
+Exporter_probe::write_header()
+{
+    // the datatypes are checked before writing the header: an unsupported datatype does not leave a partial header
+    this->n_columns = 0;
+    for (auto& snap : this->snapshots)
+        for (auto& columns : snap)
+        {
+            for (auto& column : columns)
+                exporter_datatype_to_code(column.datatype);
+            this->n_columns += columns.size();
+        }
+
+    this->file.write(Exporter_probe::magic, sizeof(Exporter_probe::magic));
+    write_value<uint32_t>(this->file, Exporter_probe::version);
+    write_value<uint32_t>(this->file, (uint32_t)this->n_columns);
+
+    for (size_t r = 0; r < this->reporters.size(); r++)
+    {
+        auto& groups = this->reporters[r]->get_groups();
+        for (size_t g = 0; g < this->snapshots[r].size(); g++)
+            for (size_t c = 0; c < this->snapshots[r][g].size(); c++)
+            {
+                write_string(this->file, std::get<0>(groups[g].first));
+                write_string(this->file, std::get<0>(groups[g].second[c]));
+                write_string(this->file, std::get<1>(groups[g].second[c]));
+                write_value<uint8_t>(this->file, exporter_datatype_to_code(this->snapshots[r][g][c].datatype));
+                write_value<uint64_t>(this->file, (uint64_t)this->snapshots[r][g][c].data_size);
+            }
+    }
+
+    this->header_written = true;
+}
+
+void
+Exporter_probe::flush()
+{
+    std::unique_lock<std::mutex> lock(this->mutex_file);
+
+    for (size_t r = 0; r < this->reporters.size(); r++)
+        if (!this->reporters[r]->snapshot(this->snapshots[r], true))
+        {
+            std::stringstream message;
+            message << "The reporter does not support typed snapshots ('r' = " << r << ").";
+            throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+        }
+
+    if (!this->header_written) this->write_header();
+
+    // count the drained values of each column, nothing is written when all the columns are empty
+    std::vector<uint64_t> counts;
+    size_t n_block_values = 0;
+    for (auto& snap : this->snapshots)
+        for (auto& columns : snap)
+            for (auto& column : columns)
+            {
+                uint64_t count = 0;
+                for (size_t row = 0; row < column.n_rows; row++)
+                    count += column.valid[row] ? 1 : 0;
+                counts.push_back(count);
+                n_block_values += count;
+            }
+
+    if (counts.size() != this->n_columns)
+    {
+        std::stringstream message;
+        message << "The number of columns has changed since the header has been written ('counts.size()' = "
+                << counts.size() << ", 'n_columns' = " << this->n_columns << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    if (n_block_values == 0) return;
+
+    write_value<uint32_t>(this->file, Exporter_probe::block_magic);
+    for (auto count : counts)
+        write_value<uint64_t>(this->file, count);
+
+    for (auto& snap : this->snapshots)
+        for (auto& columns : snap)
+            for (auto& column : columns)
+            {
+                const size_t row_bytes =
+                  column.data_size * exporter_code_to_size(exporter_datatype_to_code(column.datatype));
+                for (size_t row = 0; row < column.n_rows; row++)
+                    if (column.valid[row])
+                        this->file.write(reinterpret_cast<const char*>(column.data.data() + row * row_bytes),
+                                         row_bytes);
+            }
+
+    this->file.flush();
+    this->n_blocks++;
+    this->n_values += n_block_values;
+}
+
+const std::string&
+Exporter_probe::get_filepath() const
+{
+    return this->filepath;
+}
+
+size_t
+Exporter_probe::get_n_blocks() const
+{
+    return this->n_blocks;
+}
+
+size_t
+Exporter_probe::get_n_values() const
+{
+    return this->n_values;
+}
+
+void
+Exporter_probe::start_thread_exporter(Exporter_probe* exporter, const std::chrono::milliseconds freq)
+{
+    Thread_pinning::pin_auxiliary();
+    std::unique_lock<std::mutex> lock(exporter->mutex_exporter);
+    while (!exporter->stop_exporter)
+        if (exporter->cond_exporter.wait_for(lock, freq) == std::cv_status::timeout)
+        {
+            // an exception cannot leave the thread: it is saved and rethrown by 'stop'
+            try
+            {
+                exporter->flush();
+            }
+            catch (...)
+            {
+                exporter->exp_exception = std::current_exception();
+                return;
+            }
+        }
+}
@@ -0,0 +1,227 @@
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define AFF3CT_CORE_EXPORTER_MMAP
+#endif
+
+#include "Tools/Display/Exporter/Exporter_probe.hpp"
+#include "Tools/Display/Exporter/Exporter_probe_reader.hpp"
+#include "Tools/Exception/exception.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+Exporter_probe_reader::Exporter_probe_reader(const std::string& filepath, const bool use_mmap)
+  : filepath(filepath)
+  , mapped(false)
+  , data(nullptr)
+  , size(0)
+{
+#ifdef AFF3CT_CORE_EXPORTER_MMAP
+    if (use_mmap)
+    {
+        const int fd = open(filepath.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd != -1 && fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void* ptr = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (ptr != MAP_FAILED)
+            {
+                this->data = (const uint8_t*)ptr;
+                this->size = (size_t)st.st_size;
+                this->mapped = true;
+            }
+        }
+        if (fd != -1) close(fd);
+    }
+#endif
+
+    if (!this->mapped)
+    {
+        std::ifstream file(filepath, std::ios::in | std::ios::binary);
+        if (!file.is_open())
+        {
+            std::stringstream message;
+            message << "'filepath' file cannot be opened ('filepath' = " << filepath << ").";
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+        }
+        this->content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        this->data = this->content.data();
+        this->size = this->content.size();
+    }
+
+    try
+    {
+        this->parse();
+    }
+    catch (...)
+    {
+#ifdef AFF3CT_CORE_EXPORTER_MMAP
+        if (this->mapped) munmap((void*)this->data, this->size);
+#endif
+        throw;
+    }
+}
+
+Exporter_probe_reader::~Exporter_probe_reader()
+{
+#ifdef AFF3CT_CORE_EXPORTER_MMAP
+    if (this->mapped) munmap((void*)this->data, this->size);
+#endif
+}
+
+template<typename T>
+static bool
+read_value(const uint8_t* data, const size_t size, size_t& offset, T& value)
+{
+    if (offset + sizeof(T) > size) return false;
+    std::memcpy((void*)&value, (const void*)(data + offset), sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+static bool
+read_string(const uint8_t* data, const size_t size, size_t& offset, std::string& str)
+{
+    uint32_t len = 0;
+    if (!read_value<uint32_t>(data, size, offset, len) || offset + len > size) return false;
+    str.assign((const char*)(data + offset), len);
+    offset += len;
+    return true;
+}
+
+void
+Exporter_probe_reader::parse()
+{
+    size_t offset = 0;
+    bool valid_header = this->size >= sizeof(Exporter_probe::magic) &&
+                        std::memcmp(this->data, Exporter_probe::magic, sizeof(Exporter_probe::magic)) == 0;
+    offset += sizeof(Exporter_probe::magic);
+
+    uint32_t version = 0, n_columns = 0;
+    valid_header = valid_header && read_value<uint32_t>(this->data, this->size, offset, version);
+    if (valid_header && version != Exporter_probe::version)
+    {
+        std::stringstream message;
+        message << "Unsupported file version ('version' = " << version
+                << ", 'Exporter_probe::version' = " << Exporter_probe::version << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+    valid_header = valid_header && read_value<uint32_t>(this->data, this->size, offset, n_columns);
+
+    std::vector<size_t> value_bytes;
+    for (uint32_t c = 0; c < n_columns && valid_header; c++)
+    {
+        column_t column;
+        uint8_t code = 0;
+        uint64_t data_size = 0;
+        valid_header = read_string(this->data, this->size, offset, column.group) &&
+                       read_string(this->data, this->size, offset, column.name) &&
+                       read_string(this->data, this->size, offset, column.unit) &&
+                       read_value<uint8_t>(this->data, this->size, offset, code) &&
+                       read_value<uint64_t>(this->data, this->size, offset, data_size);
+        if (valid_header)
+        {
+            column.datatype = exporter_code_to_datatype(code);
+            column.data_size = (size_t)data_size;
+            this->columns.push_back(column);
+            value_bytes.push_back(column.data_size * exporter_code_to_size(code));
+        }
+    }
+
+    if (!valid_header)
+    {
+        std::stringstream message;
+        message << "'filepath' is not a valid probes file ('filepath' = " << this->filepath << ").";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // index the complete blocks, an incomplete trailing block is ignored
+    while (true)
+    {
+        size_t block_offset = offset;
+        uint32_t magic = 0;
+        if (!read_value<uint32_t>(this->data, this->size, block_offset, magic)) break;
+        if (magic != Exporter_probe::block_magic)
+        {
+            std::stringstream message;
+            message << "Corrupted block ('offset' = " << offset << ").";
+            throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+        }
+
+        std::vector<uint64_t> counts(this->columns.size());
+        bool complete = true;
+        for (auto& count : counts)
+            complete = complete && read_value<uint64_t>(this->data, this->size, block_offset, count);
+        if (!complete) break;
+
+        std::vector<std::pair<size_t, size_t>> block(this->columns.size());
+        for (size_t c = 0; c < this->columns.size() && complete; c++)
+        {
+            block[c] = std::make_pair(block_offset, (size_t)counts[c]);
+            block_offset += counts[c] * value_bytes[c];
+            complete = block_offset <= this->size;
+        }
+        if (!complete) break;
+
+        for (size_t c = 0; c < this->columns.size(); c++)
+            this->columns[c].n_values += block[c].second;
+        this->blocks.push_back(block);
+        offset = block_offset;
+    }
+}
+
+const std::vector<Exporter_probe_reader::column_t>&
+Exporter_probe_reader::get_columns() const
+{
+    return this->columns;
+}
+
+size_t
+Exporter_probe_reader::get_n_blocks() const
+{
+    return this->blocks.size();
+}
+
+bool
+Exporter_probe_reader::is_mapped() const
+{
+    return this->mapped;
+}
+
+size_t
+Exporter_probe_reader::get_column_id(const std::string& name, const std::string& group) const
+{
+    for (size_t c = 0; c < this->columns.size(); c++)
+        if (this->columns[c].name == name && (group.empty() || this->columns[c].group == group)) return c;
+
+    std::stringstream message;
+    message << "Column not found ('name' = " << name << ", 'group' = " << group << ").";
+    throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+}
+
+void
+Exporter_probe_reader::check_column(const size_t col, const std::type_index& datatype) const
+{
+    if (col >= this->columns.size())
+    {
+        std::stringstream message;
+        message << "'col' has to be smaller than 'columns.size()' ('col' = " << col
+                << ", 'columns.size()' = " << this->columns.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    if (this->columns[col].datatype != datatype)
+    {
+        std::stringstream message;
+        message << "'T' does not match the datatype of the column ('col' = " << col
+                << ", 'name' = " << this->columns[col].name << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+}
@@ -4,9 +4,12 @@
 #include <sstream>
 #include <type_traits>
 
+#include "Module/Adaptor/Adaptor.hpp"
+#include "Runtime/Pipeline/Pipeline.hpp"
 #include "Tools/Display/Statistics/Statistics.hpp"
 #include "Tools/Display/rang_format/rang_format.h"
 #include "Tools/Exception/exception.hpp"
+#include "Tools/System/perf_counters.hpp"
 
 using namespace aff3ct;
 using namespace aff3ct::tools;
@@ -222,6 +225,496 @@ Statistics::show_timer(const float total_sec,
     // clang-format on
 }
 
+void
+Statistics::show_perf_header(std::ostream& stream)
+{
+    // clang-format off
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "  Performance counters for the given task  ||                    Average per frame ('-' = unavailable)                    " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "    ('*' = any, '-' = same as previous)    ||                  (IPC = instructions per cycle on the task)                 " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "      MODULE |              TASK |   TIMER ||      IPC |   CYCLES |   INSTRS |   C-MISS |   B-MISS |   CTX-SW | CPU TIME " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "             |                   |         ||          |          |          |          |          |          |     (us) " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    // clang-format on
+}
+
+void
+Statistics::show_perf_task(const std::string& module_name,
+                           const std::string& task_name,
+                           const uint64_t task_n_frames,
+                           const std::vector<uint64_t>& task_perf_total,
+                           std::ostream& stream)
+{
+    if (task_n_frames == 0) return;
+
+    auto format = [](const bool available, const float value)
+    {
+        std::stringstream ss;
+        if (available)
+            ss << std::setprecision(2) << (value > 99999.99f ? std::scientific : std::fixed) << std::setw(8) << value;
+        else
+            ss << std::setw(8) << "-";
+        return ss.str();
+    };
+
+    auto is_available = [&task_perf_total](const perf_event_t e)
+    { return perf_counters_is_available(e) && (size_t)e < task_perf_total.size(); };
+    auto per_frame = [&task_perf_total, task_n_frames](const perf_event_t e)
+    { return (float)task_perf_total[(size_t)e] / (float)task_n_frames; };
+
+    const bool ipc_available = is_available(perf_event_t::CYCLES) && is_available(perf_event_t::INSTRUCTIONS) &&
+                               task_perf_total[(size_t)perf_event_t::CYCLES] != 0;
+    const float ipc = ipc_available ? (float)task_perf_total[(size_t)perf_event_t::INSTRUCTIONS] /
+                                        (float)task_perf_total[(size_t)perf_event_t::CYCLES]
+                                    : 0.f;
+
+    std::stringstream ssmodule, ssprocess, sssp;
+    ssmodule << std::setw(12) << module_name;
+    ssprocess << std::setw(17) << task_name;
+    sssp << std::setw(7) << "*";
+
+    const std::vector<perf_event_t> per_frame_events = { perf_event_t::CYCLES,        perf_event_t::INSTRUCTIONS,
+                                                         perf_event_t::CACHE_MISSES,  perf_event_t::BRANCH_MISSES,
+                                                         perf_event_t::CONTEXT_SWITCHES };
+
+    stream << "# ";
+    stream << ssmodule.str() << rang::style::bold << " | " << rang::style::reset << ssprocess.str() << rang::style::bold
+           << " | " << rang::style::reset << sssp.str() << rang::style::bold << " || " << rang::style::reset
+           << format(ipc_available, ipc);
+    for (auto e : per_frame_events)
+        stream << rang::style::bold << " | " << rang::style::reset << format(is_available(e), per_frame(e));
+    stream << rang::style::bold << " | " << rang::style::reset
+           << format(is_available(perf_event_t::TASK_CLOCK), per_frame(perf_event_t::TASK_CLOCK) * 0.001f)
+           << std::endl;
+}
+
+void
+Statistics::show_latency_header(std::ostream& stream)
+{
+    // clang-format off
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "     Latency of the frames in the pipeline ||         Per slot (a slot contains 'n_frames' frames)            " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "  (queue = time spent in the synchro buf.) ||        (the percentiles are bounds of power of 2 buckets)       " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "     ADAPTOR |            STAGES |    TYPE ||    SLOTS |  AVERAGE |  MINIMUM |      P50 |      P99 |  MAXIMUM " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "             |                   |         ||          |     (us) |     (us) |     (us) |     (us) |     (us) " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    // clang-format on
+}
+
+void
+Statistics::show_latency_histogram(const std::string& adaptor_name,
+                                   const std::string& stages,
+                                   const std::string& type,
+                                   const Latency_histogram& histogram,
+                                   std::ostream& stream)
+{
+    auto format = [](const std::chrono::nanoseconds duration)
+    {
+        const float us = (float)duration.count() * 0.001f;
+        std::stringstream ss;
+        ss << std::setprecision(2) << (us > 99999.99f ? std::scientific : std::fixed) << std::setw(8) << us;
+        return ss.str();
+    };
+
+    std::stringstream ssadaptor, ssstages, sstype, ssn_values;
+    ssadaptor << std::setw(12) << adaptor_name.substr(0, 12);
+    ssstages << std::setw(17) << stages;
+    sstype << std::setw(7) << type;
+    ssn_values << std::setw(8) << histogram.get_n_values();
+
+    stream << "# ";
+    stream << ssadaptor.str() << rang::style::bold << " | " << rang::style::reset << ssstages.str() << rang::style::bold
+           << " | " << rang::style::reset << sstype.str() << rang::style::bold << " || " << rang::style::reset
+           << ssn_values.str() << rang::style::bold << " | " << rang::style::reset << format(histogram.get_avg())
+           << rang::style::bold << " | " << rang::style::reset << format(histogram.get_min()) << rang::style::bold
+           << " | " << rang::style::reset << format(histogram.get_percentile(50.f)) << rang::style::bold << " | "
+           << rang::style::reset << format(histogram.get_percentile(99.f)) << rang::style::bold << " | "
+           << rang::style::reset << format(histogram.get_max()) << std::endl;
+}
+
+void
+Statistics::show_latency(runtime::Pipeline& pipeline, std::ostream& stream)
+{
+    if (!pipeline.is_latency_tracking())
+    {
+        std::stringstream message;
+        message << "The latency tracking of the pipeline has to be enabled.";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    const auto stages = pipeline.get_stages();
+    const size_t n_stages = stages.size();
+
+    Statistics::show_latency_header(stream);
+    for (size_t s = 0; s + 1 < n_stages; s++)
+    {
+        // same names as the adaptors created by the pipeline
+        const std::string name =
+          (stages[s]->get_n_threads() == 1 ? "Adp_1_to_n_" : "Adp_n_to_1_") + std::to_string(s);
+        Statistics::show_latency_histogram(
+          name, std::to_string(s) + " -> " + std::to_string(s + 1), "queue", pipeline.get_residence(s), stream);
+    }
+    Statistics::show_latency_histogram(
+      "*", "0 -> " + std::to_string(n_stages - 1), "e2e", pipeline.get_latency(), stream);
+}
+
+void
+Statistics::show_synchro_header(std::ostream& stream)
+{
+    // clang-format off
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "      Synchronizations between the stages  ||     Sum on the replicas, except WAIT (average per replica) and MAX OCC      " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "  (push = upstream, pull = downstream st.) ||   (OCC = number of filled slots seen at the beginning of the push/pull)     " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------------------------------------||-----------------------------------------------------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "     ADAPTOR |            STAGES |    SIDE ||    CALLS |  BLOCKED |     WAIT |    SPINS |   SLEEPS |  AVG OCC |  MAX OCC " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "             |                   |         ||          |      (%) |     (ms) |          |          |  (slots) |  (slots) " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------|-------------------|---------||----------|----------|----------|----------|----------|----------|----------" << rang::style::reset << std::endl;
+    // clang-format on
+}
+
+void
+Statistics::show_synchro_side(const std::string& adaptor_name,
+                              const std::string& stages,
+                              const std::string& side,
+                              const std::vector<module::Adaptor::telemetry_t>& telemetry,
+                              std::ostream& stream)
+{
+    auto format = [](const float value)
+    {
+        std::stringstream ss;
+        ss << std::setprecision(2) << (value > 99999.99f ? std::scientific : std::fixed) << std::setw(8) << value;
+        return ss.str();
+    };
+
+    uint64_t n_calls = 0, n_blocked = 0, n_spins = 0, n_sleeps = 0, occupancy_sum = 0, occupancy_max = 0;
+    std::chrono::nanoseconds wait_duration(0);
+    for (auto& tlm : telemetry)
+    {
+        n_calls += tlm.n_calls;
+        n_blocked += tlm.n_blocked;
+        n_spins += tlm.n_spins;
+        n_sleeps += tlm.n_sleeps;
+        wait_duration += tlm.wait_duration;
+        occupancy_sum += tlm.occupancy_sum;
+        occupancy_max = std::max(occupancy_max, tlm.occupancy_max.load());
+    }
+    const size_t n_replicas = std::max((size_t)1, telemetry.size());
+
+    std::stringstream ssadaptor, ssstages, ssside, ssn_calls, ssn_spins, ssn_sleeps, ssocc_max;
+    ssadaptor << std::setw(12) << adaptor_name.substr(0, 12);
+    ssstages << std::setw(17) << stages;
+    ssside << std::setw(7) << side;
+    ssn_calls << std::setw(8) << n_calls;
+    if (n_spins > 99999999)
+        ssn_spins << std::setprecision(2) << std::scientific << std::setw(8) << (double)n_spins;
+    else
+        ssn_spins << std::setw(8) << n_spins;
+    ssn_sleeps << std::setw(8) << n_sleeps;
+    ssocc_max << std::setw(8) << occupancy_max;
+
+    const float blocked = n_calls ? 100.f * (float)n_blocked / (float)n_calls : 0.f;
+    const float wait_ms = (float)wait_duration.count() * 1e-6f / (float)n_replicas;
+    const float occupancy_avg = n_calls ? (float)occupancy_sum / (float)n_calls : 0.f;
+
+    stream << "# ";
+    stream << ssadaptor.str() << rang::style::bold << " | " << rang::style::reset << ssstages.str() << rang::style::bold
+           << " | " << rang::style::reset << ssside.str() << rang::style::bold << " || " << rang::style::reset
+           << ssn_calls.str() << rang::style::bold << " | " << rang::style::reset << format(blocked)
+           << rang::style::bold << " | " << rang::style::reset << format(wait_ms) << rang::style::bold << " | "
+           << rang::style::reset << ssn_spins.str() << rang::style::bold << " | " << rang::style::reset
+           << ssn_sleeps.str() << rang::style::bold << " | " << rang::style::reset << format(occupancy_avg)
+           << rang::style::bold << " | " << rang::style::reset << ssocc_max.str() << std::endl;
+}
+
+void
+Statistics::show_synchro(runtime::Pipeline& pipeline, std::ostream& stream)
+{
+    if (!pipeline.is_synchro_telemetry())
+    {
+        std::stringstream message;
+        message << "The synchronizations telemetry of the pipeline has to be enabled.";
+        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    const auto stages = pipeline.get_stages();
+    const size_t n_stages = stages.size();
+
+    // average time waited by the replicas of each stage on the pull and push sides, the first and the last stages
+    // only have one side
+    std::vector<float> stage_wait_ms(n_stages, 0.f);
+    std::vector<size_t> stage_n_sides(n_stages, 0);
+    auto accumulate_wait =
+      [&stage_wait_ms, &stage_n_sides](const size_t s, const std::vector<module::Adaptor::telemetry_t>& tlm)
+    {
+        std::chrono::nanoseconds wait_duration(0);
+        for (auto& t : tlm)
+            wait_duration += t.wait_duration;
+        stage_wait_ms[s] += (float)wait_duration.count() * 1e-6f / (float)std::max((size_t)1, tlm.size());
+        stage_n_sides[s]++;
+    };
+
+    Statistics::show_synchro_header(stream);
+    for (size_t s = 0; s + 1 < n_stages; s++)
+    {
+        // same names as the adaptors created by the pipeline
+        const std::string name =
+          (stages[s]->get_n_threads() == 1 ? "Adp_1_to_n_" : "Adp_n_to_1_") + std::to_string(s);
+        const std::string sta = std::to_string(s) + " -> " + std::to_string(s + 1);
+        const auto tlm_push = pipeline.get_synchro_telemetry(s, true);
+        const auto tlm_pull = pipeline.get_synchro_telemetry(s, false);
+        Statistics::show_synchro_side(name, sta, "push", tlm_push, stream);
+        Statistics::show_synchro_side(name, sta, "pull", tlm_pull, stream);
+        accumulate_wait(s, tlm_push);
+        accumulate_wait(s + 1, tlm_pull);
+    }
+
+    if (n_stages < 2) return;
+    // the stages are compared on the average wait per side, otherwise the stages with two sides would be penalized
+    std::vector<float> side_wait_ms(n_stages);
+    for (size_t s = 0; s < n_stages; s++)
+        side_wait_ms[s] = stage_wait_ms[s] / (float)std::max((size_t)1, stage_n_sides[s]);
+
+    size_t bottleneck = 0;
+    stream << "#" << std::endl;
+    for (size_t s = 0; s < n_stages; s++)
+    {
+        stream << "# Stage " << s << ": " << std::fixed << std::setprecision(2) << stage_wait_ms[s]
+               << " ms waited per replica (" << side_wait_ms[s] << " ms per side)" << std::endl;
+        if (side_wait_ms[s] < side_wait_ms[bottleneck]) bottleneck = s;
+    }
+    stream << "# " << rang::style::bold << "Probable bottleneck: stage " << bottleneck << rang::style::reset
+           << " (its replicas wait the least for the other stages)" << std::endl;
+}
+
+void
+Statistics::show_analysis_header(std::ostream& stream)
+{
+    // clang-format off
+    stream << "# " << rang::style::bold << "--------------------||------------------------------------------------------||-------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << " Pipeline analysis  ||           Frames and times of the replicas           ||       Throughputs       " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << " (* = all replicas) ||           (% of the total execution time)            ||   (frames per second)   " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "--------------------||------------------------------------------------------||-------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "---------|----------||----------|----------|----------|----------|----------||------------|------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "   STAGE |  REPLICA ||   FRAMES |     BUSY |     WAIT |     BUSY |     WAIT ||  EFFECTIVE |   CAPACITY " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "         |          ||          |     (ms) |     (ms) |      (%) |      (%) ||            |            " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "---------|----------||----------|----------|----------|----------|----------||------------|------------" << rang::style::reset << std::endl;
+    // clang-format on
+}
+
+void
+Statistics::show_analysis_row(const std::string& stage,
+                              const std::string& replica,
+                              const uint64_t n_frames,
+                              const std::chrono::nanoseconds busy,
+                              const std::chrono::nanoseconds waiting,
+                              const std::chrono::nanoseconds exec_duration,
+                              const double throughput,
+                              const double capacity,
+                              std::ostream& stream)
+{
+    auto format = [](const double value, const int width)
+    {
+        std::stringstream ss;
+        ss << std::setprecision(2) << (value > 99999.99 ? std::scientific : std::fixed) << std::setw(width) << value;
+        return ss.str();
+    };
+
+    const double exec_ns = (double)exec_duration.count();
+    const double busy_perc = exec_ns > 0. ? 100. * (double)busy.count() / exec_ns : 0.;
+    const double waiting_perc = exec_ns > 0. ? 100. * (double)waiting.count() / exec_ns : 0.;
+
+    std::stringstream ssstage, ssreplica, ssn_frames;
+    ssstage << std::setw(8) << stage;
+    ssreplica << std::setw(8) << replica;
+    ssn_frames << std::setw(8) << n_frames;
+
+    stream << "# ";
+    stream << ssstage.str() << rang::style::bold << " | " << rang::style::reset << ssreplica.str() << rang::style::bold
+           << " || " << rang::style::reset << ssn_frames.str() << rang::style::bold << " | " << rang::style::reset
+           << format((double)busy.count() * 1e-6, 8) << rang::style::bold << " | " << rang::style::reset
+           << format((double)waiting.count() * 1e-6, 8) << rang::style::bold << " | " << rang::style::reset
+           << format(busy_perc, 8) << rang::style::bold << " | " << rang::style::reset << format(waiting_perc, 8)
+           << rang::style::bold << " || " << rang::style::reset << format(throughput, 10) << rang::style::bold << " | "
+           << rang::style::reset << format(capacity, 10) << std::endl;
+}
+
+void
+Statistics::show_analysis(runtime::Pipeline& pipeline, std::ostream& stream)
+{
+    const auto analysis = pipeline.analyze();
+
+    Statistics::show_analysis_header(stream);
+    for (size_t s = 0; s < analysis.stages.size(); s++)
+    {
+        const auto& sta = analysis.stages[s];
+
+        // the stage line gives the average busy and waiting times of the active replicas
+        const auto n_replicas = (int64_t)std::max((size_t)1, sta.n_replicas);
+        std::chrono::nanoseconds busy(0), waiting(0);
+        for (size_t t = 0; t < sta.busy.size(); t++)
+        {
+            busy += sta.busy[t];
+            waiting += sta.waiting[t];
+        }
+        Statistics::show_analysis_row(std::to_string(s),
+                                      "*",
+                                      sta.n_frames,
+                                      busy / n_replicas,
+                                      waiting / n_replicas,
+                                      analysis.exec_duration,
+                                      sta.throughput,
+                                      sta.capacity,
+                                      stream);
+
+        if (sta.busy.size() > 1)
+            for (size_t t = 0; t < sta.busy.size(); t++)
+            {
+                // capacity of the replica alone
+                const double capacity =
+                  sta.busy[t].count() ? (double)sta.n_frames_per_replica[t] / ((double)sta.busy[t].count() * 1e-9) : 0.;
+                const double exec_seconds = (double)analysis.exec_duration.count() * 1e-9;
+                const double throughput = exec_seconds > 0. ? (double)sta.n_frames_per_replica[t] / exec_seconds : 0.;
+                Statistics::show_analysis_row("-",
+                                              std::to_string(t),
+                                              sta.n_frames_per_replica[t],
+                                              sta.busy[t],
+                                              sta.waiting[t],
+                                              analysis.exec_duration,
+                                              throughput,
+                                              capacity,
+                                              stream);
+            }
+    }
+
+    const auto& bot = analysis.stages[analysis.bottleneck];
+    const double gain = analysis.throughput > 0. ? 100. * (analysis.throughput_what_if / analysis.throughput - 1.) : 0.;
+    stream << "#" << std::endl;
+    stream << "# Execution time: " << std::fixed << std::setprecision(2)
+           << (double)analysis.exec_duration.count() * 1e-6 << " ms, throughput: " << analysis.throughput
+           << " frames/s" << std::endl;
+    stream << "# " << rang::style::bold << "Bottleneck: stage " << analysis.bottleneck << rang::style::reset << " ("
+           << bot.n_replicas << " replica(s), capacity: " << bot.capacity << " frames/s)" << std::endl;
+    stream << "# What-if: with " << (bot.n_replicas + 1) << " replicas in the stage " << analysis.bottleneck
+           << ", the estimated throughput is " << analysis.throughput_what_if << " frames/s (+" << gain
+           << "%, bottleneck: stage " << analysis.bottleneck_what_if << ")" << std::endl;
+}
+
+void
+Statistics::show_profile_header(std::ostream& stream)
+{
+    // clang-format off
+    stream << "# " << rang::style::bold << "-------------------------------------------------------||-----------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << " Sampling profile                                      || Samples of the active replicas    " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << " (* = all replicas)                                    || (time estimated from the samples) " << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "-------------------------------------------------------||-----------------------------------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "---------|----------|----------------------------------||------------|----------|-----------" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "   STAGE |  REPLICA |                             TASK ||    SAMPLES |  SAMPLES |  EST. TIME" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "         |          |                                  ||            |      (%) |       (ms)" << rang::style::reset << std::endl;
+    stream << "# " << rang::style::bold << "---------|----------|----------------------------------||------------|----------|-----------" << rang::style::reset << std::endl;
+    // clang-format on
+}
+
+void
+Statistics::show_profile_row(const std::string& stage,
+                             const std::string& replica,
+                             const std::string& task,
+                             const uint64_t n_samples,
+                             const uint64_t n_stage_samples,
+                             const std::chrono::nanoseconds estimated_time,
+                             std::ostream& stream)
+{
+    const double perc = n_stage_samples ? 100. * (double)n_samples / (double)n_stage_samples : 0.;
+
+    std::stringstream ssstage, ssreplica, sstask, ssn_samples, ssperc, sstime;
+    ssstage << std::setw(8) << stage;
+    ssreplica << std::setw(8) << replica;
+    sstask << std::setw(32) << (task.size() > 32 ? task.substr(0, 31) + "*" : task);
+    ssn_samples << std::setw(10) << n_samples;
+    ssperc << std::setprecision(2) << std::fixed << std::setw(8) << perc;
+    sstime << std::setprecision(2) << std::fixed << std::setw(10) << (double)estimated_time.count() * 1e-6;
+
+    stream << "# ";
+    stream << ssstage.str() << rang::style::bold << " | " << rang::style::reset << ssreplica.str() << rang::style::bold
+           << " | " << rang::style::reset << sstask.str() << rang::style::bold << " || " << rang::style::reset
+           << ssn_samples.str() << rang::style::bold << " | " << rang::style::reset << ssperc.str() << rang::style::bold
+           << " | " << rang::style::reset << sstime.str() << std::endl;
+}
+
+void
+Statistics::show_profile(const Profiler& profiler, std::ostream& stream)
+{
+    Statistics::show_profile_header(stream);
+    for (size_t s = 0; s < profiler.get_n_stages(); s++)
+    {
+        // the replicas of a stage execute the same tasks in the same order, the samples are aggregated per index
+        const auto n_replicas = profiler.get_n_replicas(s);
+        if (n_replicas == 0) continue;
+
+        const auto& tasks = profiler.get_tasks(s, 0);
+        std::vector<uint64_t> n_samples(tasks.size(), 0), n_busy(n_replicas, 0);
+        std::vector<std::chrono::nanoseconds> est_times(tasks.size(), std::chrono::nanoseconds(0));
+        std::vector<std::chrono::nanoseconds> est_busy(n_replicas, std::chrono::nanoseconds(0));
+        uint64_t n_idle = 0, n_stage_samples = 0;
+        for (size_t r = 0; r < n_replicas; r++)
+        {
+            for (size_t t = 0; t < tasks.size(); t++)
+            {
+                const auto n = profiler.get_n_samples(s, r, t);
+                const auto time = profiler.get_estimated_time(s, r, t);
+                n_samples[t] += n;
+                n_busy[r] += n;
+                est_times[t] += time;
+                est_busy[r] += time;
+            }
+            n_idle += profiler.get_n_idle_samples(s, r);
+        }
+        for (size_t t = 0; t < tasks.size(); t++)
+            n_stage_samples += n_samples[t];
+        n_stage_samples += n_idle;
+
+        std::vector<size_t> order(tasks.size());
+        for (size_t t = 0; t < order.size(); t++)
+            order[t] = t;
+        std::stable_sort(order.begin(),
+                         order.end(),
+                         [&n_samples](const size_t t1, const size_t t2) { return n_samples[t1] > n_samples[t2]; });
+
+        for (auto t : order)
+        {
+            if (n_samples[t] == 0) continue;
+            const auto& module = tasks[t]->get_module();
+            const auto module_name =
+              module.get_custom_name().empty() ? module.get_short_name() : module.get_custom_name();
+            Statistics::show_profile_row(std::to_string(s),
+                                         "*",
+                                         module_name + "::" + tasks[t]->get_name(),
+                                         n_samples[t],
+                                         n_stage_samples,
+                                         est_times[t],
+                                         stream);
+        }
+
+        const auto est_idle =
+          profiler.get_n_rounds() ? (profiler.get_duration() * (int64_t)n_idle) / (int64_t)profiler.get_n_rounds()
+                                  : std::chrono::nanoseconds(0);
+        Statistics::show_profile_row(std::to_string(s), "*", "(idle)", n_idle, n_stage_samples, est_idle, stream);
+
+        if (n_replicas > 1)
+            for (size_t r = 0; r < n_replicas; r++)
+                Statistics::show_profile_row(
+                  "-", std::to_string(r), "(busy)", n_busy[r], n_stage_samples, est_busy[r], stream);
+    }
+
+    stream << "#" << std::endl;
+    stream << "# Sampling rounds: " << profiler.get_n_rounds() << ", sampling duration: " << std::fixed
+           << std::setprecision(2) << (double)profiler.get_duration().count() * 1e-6 << " ms" << std::endl;
+}
+
 template<class MODULE_OR_TASK>
 void
 Statistics::show(std::vector<MODULE_OR_TASK*> modules_or_tasks,
@@ -376,8 +869,8 @@ Statistics::show_tasks(std::vector<TASK*> tasks, const bool ordered, const bool
 
             auto timers_name = t->get_timers_name();
             auto timers_n_elmts = task_n_elmts;
-            auto timers_n_calls = t->get_timers_n_calls();
-            auto timers_tot_duration = t->get_timers_total();
+            auto timers_n_calls = t->get_timers_n_calls_extrapolated();
+            auto timers_tot_duration = t->get_timers_total_extrapolated();
             auto timers_min_duration = t->get_timers_min();
             auto timers_max_duration = t->get_timers_max();
 
@@ -406,6 +899,27 @@ Statistics::show_tasks(std::vector<TASK*> tasks, const bool ordered, const bool
                               ttask_max_duration,
                               display_thr,
                               stream);
+
+        bool show_perf = false;
+        for (auto* t : tasks)
+            show_perf = show_perf || (t->is_perf() && t->get_n_calls());
+
+        if (show_perf)
+        {
+            stream << "#" << std::endl;
+            Statistics::show_perf_header(stream);
+            for (auto* t : tasks)
+                if (t->is_perf())
+                {
+                    auto module_name = t->get_module().get_custom_name().empty() ? t->get_module().get_short_name()
+                                                                                 : t->get_module().get_custom_name();
+                    Statistics::show_perf_task(module_name,
+                                               t->get_name(),
+                                               (uint64_t)t->get_n_sampled_calls() * t->get_module().get_n_frames(),
+                                               t->get_perf_total(),
+                                               stream);
+                }
+        }
     }
     else
     {
@@ -617,8 +1131,8 @@ Statistics::show_tasks(std::vector<std::vector<TASK*>> tasks,
             {
                 for (auto* t : vt)
                 {
-                    timers_n_calls[tn] += t->get_timers_n_calls()[tn];
-                    timers_tot_duration[tn] += t->get_timers_total()[tn];
+                    timers_n_calls[tn] += t->get_timers_n_calls_extrapolated()[tn];
+                    timers_tot_duration[tn] += t->get_timers_total_extrapolated()[tn];
                     timers_min_duration[tn] = std::min(task_min_duration, t->get_timers_min()[tn]);
                     timers_max_duration[tn] = std::max(task_max_duration, t->get_timers_max()[tn]);
                 }
@@ -646,6 +1160,33 @@ Statistics::show_tasks(std::vector<std::vector<TASK*>> tasks,
                               ttask_max_duration,
                               display_thr,
                               stream);
+
+        bool show_perf = false;
+        for (auto& vt : tasks)
+            for (auto* t : vt)
+                show_perf = show_perf || (t->is_perf() && t->get_n_calls());
+
+        if (show_perf)
+        {
+            stream << "#" << std::endl;
+            Statistics::show_perf_header(stream);
+            for (auto& vt : tasks)
+            {
+                auto module_name = vt[0]->get_module().get_custom_name().empty()
+                                     ? vt[0]->get_module().get_short_name()
+                                     : vt[0]->get_module().get_custom_name();
+                uint64_t task_n_frames = 0;
+                std::vector<uint64_t> task_perf_total(perf_n_events, 0);
+                for (auto* t : vt)
+                    if (t->is_perf())
+                    {
+                        task_n_frames += (uint64_t)t->get_n_sampled_calls() * t->get_module().get_n_frames();
+                        for (size_t e = 0; e < perf_n_events; e++)
+                            task_perf_total[e] += t->get_perf_total()[e];
+                    }
+                Statistics::show_perf_task(module_name, vt[0]->get_name(), task_n_frames, task_perf_total, stream);
+            }
+        }
     }
     else
     {
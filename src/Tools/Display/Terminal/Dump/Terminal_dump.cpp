@@ -28,7 +28,7 @@ Terminal_dump::report(std::ostream& stream, bool final)
 
     std::vector<Reporter::report_t> report_list;
     for (unsigned r = 0; r < this->reporters.size(); r++)
-        report_list.push_back(this->reporters[r]->report(final));
+        report_list.push_back(this->collect_report(r, final));
 
     bool is_not_over = true;
     while (is_not_over)
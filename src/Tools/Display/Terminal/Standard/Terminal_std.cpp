@@ -3,6 +3,7 @@
 #include <cmath>
 #include <iomanip>
 #include <ios>
+#include <sstream>
 
 #include "Tools/Display/Terminal/Standard/Terminal_std.hpp"
 #include "Tools/Display/rang_format/rang_format.h"
@@ -46,6 +47,19 @@ Terminal_std::get_reporters()
     return this->reporters;
 }
 
+Reporter::report_t
+Terminal_std::collect_report(const size_t r, bool final)
+{
+    if (this->snapshots.size() != this->reporters.size()) this->snapshots.resize(this->reporters.size());
+
+    Reporter::report_t report;
+    if (this->reporters[r]->snapshot(this->snapshots[r], final))
+        Reporter::format(this->snapshots[r], report);
+    else
+        report = this->reporters[r]->report(final);
+    return report;
+}
+
 void
 Terminal_std::legend(std::ostream& stream) const
 {
@@ -237,7 +251,7 @@ Terminal_std::report(std::ostream& stream, bool final)
     for (unsigned r = 0; r < this->reporters.size(); r++)
         if (this->reporters[r] != nullptr)
         {
-            auto report = this->reporters[r]->report(final);
+            auto report = this->collect_report(r, final);
             auto& groups = this->reporters[r]->get_groups();
 
             assert(report.size() == groups.size());
@@ -2,6 +2,7 @@
 #include <cstdlib>
 
 #include "Tools/Display/Terminal/Terminal.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
 
 using namespace aff3ct;
 using namespace aff3ct::tools;
@@ -61,6 +62,7 @@ Terminal::stop_temp_report()
 void
 Terminal::start_thread_terminal(Terminal* terminal, const std::chrono::milliseconds freq)
 {
+    Thread_pinning::pin_auxiliary();
     const auto sleep_time = freq - std::chrono::milliseconds(0);
     while (!terminal->stop_terminal)
     {
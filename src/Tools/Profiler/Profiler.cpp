@@ -0,0 +1,218 @@
+#include <sstream>
+
+#include "Runtime/Pipeline/Pipeline.hpp"
+#include "Runtime/Sequence/Sequence.hpp"
+#include "Tools/Exception/exception.hpp"
+#include "Tools/Profiler/Profiler.hpp"
+#include "Tools/Thread_pinning/Thread_pinning.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+Profiler::Profiler(runtime::Sequence& sequence)
+  : stop_profiler(false)
+  , stages({ &sequence })
+  , n_rounds(0)
+  , duration(0)
+{
+    this->init();
+}
+
+Profiler::Profiler(runtime::Pipeline& pipeline)
+  : stop_profiler(false)
+  , stages(pipeline.get_stages())
+  , n_rounds(0)
+  , duration(0)
+{
+    this->init();
+}
+
+Profiler::~Profiler()
+{
+    this->stop(); // try to join the thread if this is not been done by the user
+}
+
+void
+Profiler::init()
+{
+    this->tasks.resize(this->stages.size());
+    this->tasks_id.resize(this->stages.size());
+    for (size_t s = 0; s < this->stages.size(); s++)
+    {
+        this->tasks[s] = this->stages[s]->get_tasks_per_threads();
+        this->tasks_id[s].resize(this->tasks[s].size());
+        for (size_t r = 0; r < this->tasks[s].size(); r++)
+            for (size_t t = 0; t < this->tasks[s][r].size(); t++)
+                this->tasks_id[s][r][this->tasks[s][r][t]] = t;
+    }
+    this->reset();
+}
+
+void
+Profiler::reset()
+{
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    this->samples.resize(this->tasks.size());
+    this->idle.resize(this->tasks.size());
+    for (size_t s = 0; s < this->tasks.size(); s++)
+    {
+        this->samples[s].resize(this->tasks[s].size());
+        this->idle[s].assign(this->tasks[s].size(), 0);
+        for (size_t r = 0; r < this->tasks[s].size(); r++)
+            this->samples[s][r].assign(this->tasks[s][r].size(), 0);
+    }
+    this->n_rounds = 0;
+    this->duration = std::chrono::nanoseconds(0);
+}
+
+void
+Profiler::start(const std::chrono::microseconds period)
+{
+    if (period.count() <= 0)
+    {
+        std::stringstream message;
+        message << "'period' has to be strictly positive ('period' = " << period.count() << " us).";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    this->stop();
+
+    // launch a thread dedicated to the sampling
+    prof_thread = std::thread(Profiler::start_thread_profiler, this, period);
+}
+
+void
+Profiler::stop()
+{
+    if (prof_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_profiler);
+            stop_profiler = true;
+        }
+        cond_profiler.notify_all();
+        // wait the sampling thread to finish
+        prof_thread.join();
+        stop_profiler = false;
+    }
+}
+
+void
+Profiler::start_thread_profiler(Profiler* profiler, const std::chrono::microseconds period)
+{
+    Thread_pinning::pin_auxiliary();
+    std::unique_lock<std::mutex> lock(profiler->mutex_profiler);
+    while (!profiler->stop_profiler)
+        if (!profiler->cond_profiler.wait_for(lock, period, [profiler]() { return profiler->stop_profiler; }))
+            profiler->sample();
+}
+
+void
+Profiler::sample()
+{
+    const auto t_round = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    for (size_t s = 0; s < this->stages.size(); s++)
+    {
+        const auto n_active_threads = this->stages[s]->get_n_active_threads();
+        for (size_t r = 0; r < n_active_threads; r++)
+        {
+            const auto* task = this->stages[s]->get_current_task(r);
+            auto it = task != nullptr ? this->tasks_id[s][r].find(task) : this->tasks_id[s][r].end();
+            if (it != this->tasks_id[s][r].end())
+                this->samples[s][r][it->second]++;
+            else
+                this->idle[s][r]++;
+        }
+    }
+
+    if (this->n_rounds == 0) this->t_first_round = t_round;
+    this->duration = std::chrono::duration_cast<std::chrono::nanoseconds>(t_round - this->t_first_round);
+    this->n_rounds++;
+}
+
+size_t
+Profiler::get_n_stages() const
+{
+    return this->stages.size();
+}
+
+size_t
+Profiler::get_n_replicas(const size_t stage_id) const
+{
+    if (stage_id >= this->tasks.size())
+    {
+        std::stringstream message;
+        message << "'stage_id' has to be smaller than the number of stages ('stage_id' = " << stage_id
+                << ", 'tasks.size()' = " << this->tasks.size() << ").";
+        throw tools::out_of_range(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->tasks[stage_id].size();
+}
+
+const std::vector<runtime::Task*>&
+Profiler::get_tasks(const size_t stage_id, const size_t replica_id) const
+{
+    if (replica_id >= this->get_n_replicas(stage_id))
+    {
+        std::stringstream message;
+        message << "'replica_id' has to be smaller than the number of replicas ('replica_id' = " << replica_id
+                << ", 'get_n_replicas(stage_id)' = " << this->get_n_replicas(stage_id) << ").";
+        throw tools::out_of_range(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->tasks[stage_id][replica_id];
+}
+
+uint64_t
+Profiler::get_n_samples(const size_t stage_id, const size_t replica_id, const size_t task_id) const
+{
+    if (task_id >= this->get_tasks(stage_id, replica_id).size())
+    {
+        std::stringstream message;
+        message << "'task_id' has to be smaller than the number of tasks of the replica ('task_id' = " << task_id
+                << ", 'get_tasks(stage_id, replica_id).size()' = " << this->get_tasks(stage_id, replica_id).size()
+                << ").";
+        throw tools::out_of_range(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    return this->samples[stage_id][replica_id][task_id];
+}
+
+uint64_t
+Profiler::get_n_idle_samples(const size_t stage_id, const size_t replica_id) const
+{
+    this->get_tasks(stage_id, replica_id); // check the ids
+
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    return this->idle[stage_id][replica_id];
+}
+
+uint64_t
+Profiler::get_n_rounds() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    return this->n_rounds;
+}
+
+std::chrono::nanoseconds
+Profiler::get_duration() const
+{
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    return this->duration;
+}
+
+std::chrono::nanoseconds
+Profiler::get_estimated_time(const size_t stage_id, const size_t replica_id, const size_t task_id) const
+{
+    const auto n_samples = this->get_n_samples(stage_id, replica_id, task_id);
+
+    std::lock_guard<std::mutex> lock(this->mutex_samples);
+    // 'duration' covers the 'n_rounds - 1' intervals between the rounds, each sample stands for one interval
+    if (this->n_rounds < 2) return std::chrono::nanoseconds(0);
+    return std::chrono::nanoseconds(
+      (int64_t)((double)this->duration.count() * (double)n_samples / (double)(this->n_rounds - 1)));
+}
@@ -1,4 +1,3 @@
-#include <iomanip>
 #include <sstream>
 #include <utility>
 
@@ -73,24 +72,43 @@ Reporter_probe::reset()
         this->probes[p]->reset();
 }
 
-template<typename T>
+size_t
+B_from_datatype(const std::type_index& type)
+{
+    if (type == typeid(double)) return 8;
+    if (type == typeid(float)) return 4;
+    if (type == typeid(int64_t)) return 8;
+    if (type == typeid(uint64_t)) return 8;
+    if (type == typeid(int32_t)) return 4;
+    if (type == typeid(uint32_t)) return 4;
+    if (type == typeid(int16_t)) return 2;
+    if (type == typeid(uint16_t)) return 2;
+    if (type == typeid(int8_t)) return 1;
+    if (type == typeid(uint8_t)) return 1;
+
+    std::stringstream message;
+    message << "Unsupported type.";
+    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+}
+
 bool
-Reporter_probe::format_values(const int col, std::stringstream& temp_stream)
+Reporter_probe::pull(const int col, column_t& column, const size_t row)
 {
-    std::vector<T> buff(this->data_sizes[col]);
-    const auto can_pull = this->pull<T>(col, buff.data());
-    if (this->data_sizes[col] > 1 && can_pull) temp_stream << "[";
-    for (size_t v = 0; v < this->data_sizes[col] && can_pull; v++)
-    {
-        const std::string s = std::string((v != 0) ? ", " : "") + std::string((buff[v] >= 0) ? " " : "");
-        temp_stream << std::setprecision(this->precisions[col]) << s << +buff[v];
-    }
-    if (this->data_sizes[col] > 1 && can_pull) temp_stream << "]";
-    return can_pull;
+    const size_t row_bytes = this->data_sizes[col] * B_from_datatype(this->datatypes[col]);
+    if (column.valid.size() < row + 1) column.valid.resize(row + 1);
+    if (column.data.size() < (row + 1) * row_bytes) column.data.resize((row + 1) * row_bytes);
+
+    std::unique_lock<std::mutex> lck(this->mtx[col]);
+    column.valid[row] = this->col_size<int8_t>(col) != 0;
+    if (!column.valid[row]) return false;
+    const auto& buff = this->buffer[col][this->tail[col]];
+    std::copy(buff.begin(), buff.end(), column.data.begin() + row * row_bytes);
+    this->tail[col] = (this->tail[col] + 1) % this->buffer[col].size();
+    return true;
 }
 
-Reporter::report_t
-Reporter_probe::report(bool final)
+bool
+Reporter_probe::snapshot(snapshot_t& snap, bool final)
 {
     if (this->cols_groups[0].second.size() == 0)
     {
@@ -100,120 +118,52 @@ Reporter_probe::report(bool final)
         throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
     }
 
-    Reporter::report_t the_report(this->cols_groups.size());
-    auto& probe_report = the_report[0];
+    snap.resize(this->cols_groups.size());
+    auto& columns = snap[0];
+    columns.resize(this->buffer.size());
+    for (size_t col = 0; col < this->buffer.size(); col++)
+    {
+        columns[col].datatype = this->datatypes[col];
+        columns[col].data_size = this->data_sizes[col];
+        columns[col].fmtflags = this->format_flags[col];
+        columns[col].precision = this->precisions[col];
+    }
+
+    size_t n_rows = 0;
     if (final)
     {
+        // pull the values row by row until all the columns are empty
         bool can_pull;
         do
         {
             can_pull = false;
-            std::vector<std::stringstream> streams(this->buffer.size());
             for (size_t col = 0; col < this->buffer.size(); col++)
-            {
-                std::stringstream temp_stream;
-                temp_stream.flags(this->format_flags[col]);
-                bool c_pull = false;
-                if (this->datatypes[col] == typeid(double))
-                    c_pull = format_values<double>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(float))
-                    c_pull = format_values<float>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int64_t))
-                    c_pull = format_values<int64_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint64_t))
-                    c_pull = format_values<uint64_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int32_t))
-                    c_pull = format_values<int32_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint32_t))
-                    c_pull = format_values<uint32_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int16_t))
-                    c_pull = format_values<int16_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint16_t))
-                    c_pull = format_values<uint16_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int8_t))
-                    c_pull = format_values<int8_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint8_t))
-                    c_pull = format_values<uint8_t>(col, temp_stream);
-                else
-                {
-                    std::stringstream message;
-                    message << "Unsupported type.";
-                    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
-                }
-
-                streams[col] << std::setprecision(this->precisions[col] + 1) << temp_stream.str();
-
-                can_pull = can_pull || c_pull;
-            }
-
-            if (can_pull)
-                for (auto& s : streams)
-                    probe_report.push_back(s.str());
+                can_pull = this->pull((int)col, columns[col], n_rows) || can_pull;
+            if (can_pull) n_rows++;
         } while (can_pull);
-
-        return the_report;
     }
     else
     {
-        for (size_t f = 0; f < this->get_n_frames(); f++)
-        {
+        for (; n_rows < this->get_n_frames(); n_rows++)
             for (size_t col = 0; col < this->buffer.size(); col++)
-            {
-                std::stringstream stream, temp_stream;
-                temp_stream.flags(this->format_flags[col]);
-                if (this->datatypes[col] == typeid(double))
-                    format_values<double>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(float))
-                    format_values<float>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int64_t))
-                    format_values<int64_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint64_t))
-                    format_values<uint64_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int32_t))
-                    format_values<int32_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint32_t))
-                    format_values<uint32_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int16_t))
-                    format_values<int16_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint16_t))
-                    format_values<uint16_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(int8_t))
-                    format_values<int8_t>(col, temp_stream);
-                else if (this->datatypes[col] == typeid(uint8_t))
-                    format_values<uint8_t>(col, temp_stream);
-                else
-                {
-                    std::stringstream message;
-                    message << "Unsupported type.";
-                    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
-                }
-
-                stream << std::setprecision(this->precisions[col] + 1) << temp_stream.str();
-                probe_report.push_back(stream.str());
-            }
-        }
-
-        return the_report;
+                this->pull((int)col, columns[col], n_rows);
     }
+
+    for (auto& column : columns)
+        column.n_rows = n_rows;
+
+    return true;
 }
 
-size_t
-B_from_datatype(const std::type_index& type)
+Reporter::report_t
+Reporter_probe::report(bool final)
 {
-    if (type == typeid(double)) return 8;
-    if (type == typeid(float)) return 4;
-    if (type == typeid(int64_t)) return 8;
-    if (type == typeid(uint64_t)) return 8;
-    if (type == typeid(int32_t)) return 4;
-    if (type == typeid(uint32_t)) return 4;
-    if (type == typeid(int16_t)) return 2;
-    if (type == typeid(uint16_t)) return 2;
-    if (type == typeid(int8_t)) return 1;
-    if (type == typeid(uint8_t)) return 1;
+    Reporter::snapshot_t snap;
+    this->snapshot(snap, final);
 
-    std::stringstream message;
-    message << "Unsupported type.";
-    throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+    Reporter::report_t the_report;
+    Reporter::format(snap, the_report);
+    return the_report;
 }
 
 void
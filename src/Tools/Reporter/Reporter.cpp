@@ -1,3 +1,7 @@
+#include <iomanip>
+#include <sstream>
+
+#include "Tools/Exception/exception.hpp"
 #include "Tools/Reporter/Reporter.hpp"
 
 using namespace aff3ct;
@@ -14,6 +18,73 @@ Reporter::get_groups() const
     return this->cols_groups;
 }
 
+bool
+Reporter::snapshot(snapshot_t& /*snap*/, bool /*final*/)
+{
+    return false;
+}
+
+template<typename T>
+static void
+format_values(const Reporter::column_t& column, const size_t row, std::stringstream& stream)
+{
+    const T* values = column.get_data<T>(row);
+    if (column.data_size > 1) stream << "[";
+    for (size_t v = 0; v < column.data_size; v++)
+    {
+        const std::string s = std::string((v != 0) ? ", " : "") + std::string((values[v] >= 0) ? " " : "");
+        stream << std::setprecision(column.precision) << s << +values[v];
+    }
+    if (column.data_size > 1) stream << "]";
+}
+
+void
+Reporter::format(const snapshot_t& snap, report_t& report)
+{
+    report.resize(snap.size());
+    for (size_t g = 0; g < snap.size(); g++)
+    {
+        report[g].clear();
+        const size_t n_rows = snap[g].size() ? snap[g][0].n_rows : 0;
+        for (size_t r = 0; r < n_rows; r++)
+            for (auto& column : snap[g])
+            {
+                std::stringstream stream;
+                stream.flags(column.fmtflags);
+                if (column.valid[r])
+                {
+                    if (column.datatype == typeid(double))
+                        format_values<double>(column, r, stream);
+                    else if (column.datatype == typeid(float))
+                        format_values<float>(column, r, stream);
+                    else if (column.datatype == typeid(int64_t))
+                        format_values<int64_t>(column, r, stream);
+                    else if (column.datatype == typeid(uint64_t))
+                        format_values<uint64_t>(column, r, stream);
+                    else if (column.datatype == typeid(int32_t))
+                        format_values<int32_t>(column, r, stream);
+                    else if (column.datatype == typeid(uint32_t))
+                        format_values<uint32_t>(column, r, stream);
+                    else if (column.datatype == typeid(int16_t))
+                        format_values<int16_t>(column, r, stream);
+                    else if (column.datatype == typeid(uint16_t))
+                        format_values<uint16_t>(column, r, stream);
+                    else if (column.datatype == typeid(int8_t))
+                        format_values<int8_t>(column, r, stream);
+                    else if (column.datatype == typeid(uint8_t))
+                        format_values<uint8_t>(column, r, stream);
+                    else
+                    {
+                        std::stringstream message;
+                        message << "Unsupported type.";
+                        throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
+                    }
+                }
+                report[g].push_back(stream.str());
+            }
+    }
+}
+
 void
 Reporter::reset()
 {
@@ -3,8 +3,10 @@
  * - see: https://github.com/jeremy-rifkin/cpptrace/blob/main/docs/signal-safe-tracing.md
  */
 
+#include <atomic>
 #include <chrono>
 #include <csignal>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <iostream>
@@ -20,6 +22,10 @@ using namespace aff3ct::tools;
 bool g_sigsegv = false;
 bool g_sigint = false;
 
+// flags set by the SIGINT handler, the slots are taken and released without lock (async-signal-safe)
+constexpr size_t g_n_sigint_flags = 256;
+std::atomic<std::atomic<bool>*> g_sigint_flags[g_n_sigint_flags];
+
 #ifdef AFF3CT_CORE_STACKTRACE_SEGFAULT
 
 #include <cstring>
@@ -167,6 +173,11 @@ signal_sigint_handler(int signo, siginfo_t* info, void* context)
         std::clog << rang::tag::info << "Stopping Sequence::exec() and/or Pipeline::exec()..." << std::endl;
 
         g_sigint = true;
+        for (size_t f = 0; f < g_n_sigint_flags; f++)
+        {
+            auto flag = g_sigint_flags[f].load();
+            if (flag != nullptr) flag->store(true, std::memory_order_relaxed);
+        }
 
         g_is_interrupt = false;
     }
@@ -227,3 +238,24 @@ Signal_handler::reset_sigsegv()
 {
     g_sigsegv = false;
 }
+
+bool
+Signal_handler::register_sigint_flag(std::atomic<bool>* flag)
+{
+    for (size_t f = 0; f < g_n_sigint_flags; f++)
+    {
+        std::atomic<bool>* expected = nullptr;
+        if (g_sigint_flags[f].compare_exchange_strong(expected, flag)) return true;
+    }
+    return false;
+}
+
+void
+Signal_handler::unregister_sigint_flag(std::atomic<bool>* flag)
+{
+    for (size_t f = 0; f < g_n_sigint_flags; f++)
+    {
+        std::atomic<bool>* expected = flag;
+        if (g_sigint_flags[f].compare_exchange_strong(expected, nullptr)) return;
+    }
+}
@@ -0,0 +1,90 @@
+#include "Tools/System/clock.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+#if defined(AFF3CT_CORE_CLOCK_TSC_X86) && !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+
+namespace aff3ct
+{
+namespace tools
+{
+
+static std::atomic<double> clock_tsc_ns_per_tick(0.);
+static std::once_flag clock_tsc_calibration_flag;
+
+bool
+clock_tsc_is_available()
+{
+#if defined(AFF3CT_CORE_CLOCK_TSC_X86)
+#if defined(_MSC_VER)
+    int regs[4];
+    __cpuid(regs, 0x80000000);
+    if ((unsigned)regs[0] < 0x80000007u) return false;
+    __cpuid(regs, 0x80000007);
+    return (regs[3] >> 8) & 1; // invariant TSC
+#else
+    unsigned eax, ebx, ecx, edx;
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007u) return false;
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    return (edx >> 8) & 1; // invariant TSC
+#endif
+#elif defined(AFF3CT_CORE_CLOCK_TSC_ARM64)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void
+clock_tsc_calibrate()
+{
+    std::call_once(clock_tsc_calibration_flag,
+                   []()
+                   {
+#if defined(AFF3CT_CORE_CLOCK_TSC_ARM64)
+                       // the frequency of the generic timer is given by the system
+                       uint64_t freq;
+                       asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+                       if (freq)
+                       {
+                           clock_tsc_ns_per_tick = 1e9 / (double)freq;
+                           return;
+                       }
+#elif !defined(AFF3CT_CORE_CLOCK_TSC_X86)
+                       // 'clock_tsc_now' already returns nanoseconds
+                       clock_tsc_ns_per_tick = 1.;
+                       return;
+#endif
+                       // measure the number of ticks during a fixed steady clock duration
+                       const auto t_start = std::chrono::steady_clock::now();
+                       const uint64_t c_start = clock_tsc_now();
+                       std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                       uint64_t c_stop;
+                       std::chrono::steady_clock::time_point t_stop;
+                       do
+                       {
+                           t_stop = std::chrono::steady_clock::now();
+                           c_stop = clock_tsc_now();
+                       } while (t_stop - t_start < std::chrono::milliseconds(10));
+                       const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t_stop - t_start).count();
+                       clock_tsc_ns_per_tick = (double)ns / (double)(c_stop - c_start);
+                   });
+}
+
+std::chrono::nanoseconds
+clock_tsc_to_ns(const uint64_t ticks)
+{
+    double ns_per_tick = clock_tsc_ns_per_tick.load(std::memory_order_relaxed);
+    if (ns_per_tick == 0.)
+    {
+        clock_tsc_calibrate();
+        ns_per_tick = clock_tsc_ns_per_tick.load();
+    }
+    return std::chrono::nanoseconds((int64_t)((double)ticks * ns_per_tick));
+}
+
+}
+}
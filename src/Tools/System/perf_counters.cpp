@@ -0,0 +1,137 @@
+#include "Tools/System/perf_counters.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace aff3ct
+{
+namespace tools
+{
+
+static std::atomic<uint32_t> perf_available_mask(0);
+
+#if defined(__linux__)
+class perf_thread_counters
+{
+  public:
+    int leader_fd;
+    std::vector<int> fds;
+    std::vector<size_t> events; // event of each member of the group, in the order of the read values
+    std::vector<uint64_t> buffer;
+
+    perf_thread_counters()
+      : leader_fd(-1)
+    {
+        static const uint32_t types[perf_n_events] = { PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                                       PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE, PERF_TYPE_SOFTWARE };
+        static const uint64_t configs[perf_n_events] = { PERF_COUNT_HW_CPU_CYCLES,     PERF_COUNT_HW_INSTRUCTIONS,
+                                                         PERF_COUNT_HW_CACHE_MISSES,   PERF_COUNT_HW_BRANCH_MISSES,
+                                                         PERF_COUNT_SW_CONTEXT_SWITCHES, PERF_COUNT_SW_TASK_CLOCK };
+
+        for (size_t e = 0; e < perf_n_events; e++)
+        {
+            // the kernel events are excluded when the 'perf_event_paranoid' level does not allow to count them
+            int fd = -1;
+            for (int exclude_kernel = 0; exclude_kernel < 2 && fd == -1; exclude_kernel++)
+            {
+                struct perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.size = sizeof(attr);
+                attr.type = types[e];
+                attr.config = configs[e];
+                attr.disabled = this->leader_fd == -1 ? 1 : 0;
+                attr.exclude_kernel = exclude_kernel;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+                fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, this->leader_fd, 0);
+            }
+
+            if (fd != -1)
+            {
+                if (this->leader_fd == -1) this->leader_fd = fd;
+                this->fds.push_back(fd);
+                this->events.push_back(e);
+                perf_available_mask |= (1u << e);
+            }
+        }
+
+        if (this->leader_fd != -1)
+        {
+            this->buffer.resize(1 + this->fds.size());
+            ioctl(this->leader_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(this->leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    ~perf_thread_counters()
+    {
+        for (auto fd : this->fds)
+            close(fd);
+    }
+
+    bool read_values(uint64_t* values)
+    {
+        std::fill(values, values + perf_n_events, 0);
+        if (this->leader_fd == -1) return false;
+
+        const auto n_bytes = this->buffer.size() * sizeof(uint64_t);
+        if (::read(this->leader_fd, this->buffer.data(), n_bytes) != (ssize_t)n_bytes) return false;
+
+        // the first value is the number of events in the group
+        for (size_t i = 0; i < this->events.size() && i < this->buffer[0]; i++)
+            values[this->events[i]] = this->buffer[1 + i];
+        return true;
+    }
+};
+#endif
+
+bool
+perf_counters_read(uint64_t* values)
+{
+#if defined(__linux__)
+    thread_local perf_thread_counters counters;
+    return counters.read_values(values);
+#else
+    std::fill(values, values + perf_n_events, 0);
+    return false;
+#endif
+}
+
+bool
+perf_counters_is_available(const perf_event_t event)
+{
+    return (perf_available_mask.load() >> (uint32_t)event) & 1u;
+}
+
+std::string
+perf_event_to_string(const perf_event_t event)
+{
+    switch (event)
+    {
+        case perf_event_t::CYCLES:
+            return "CYCLES";
+        case perf_event_t::INSTRUCTIONS:
+            return "INSTRUCTIONS";
+        case perf_event_t::CACHE_MISSES:
+            return "CACHE_MISSES";
+        case perf_event_t::BRANCH_MISSES:
+            return "BRANCH_MISSES";
+        case perf_event_t::CONTEXT_SWITCHES:
+            return "CONTEXT_SWITCHES";
+        case perf_event_t::TASK_CLOCK:
+            return "TASK_CLOCK";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+}
+}
@@ -1,17 +1,31 @@
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
 #include <functional>
+#include <iomanip>
 #include <iostream>
+#include <memory>
 #include <mutex>
 #include <sstream>
 #include <vector>
 #ifdef AFF3CT_CORE_HWLOC
 #include <hwloc.h>
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if (defined(__linux__) || defined(__linux) || defined(__APPLE__)) && !defined(__ANDROID__)
+#define AFF3CT_CORE_REALTIME_SCHED
+#include <pthread.h>
+#include <sched.h>
 #endif
 
 #include "Tools/Exception/exception.hpp"
 #include "Tools/Thread_pinning/Thread_pinning.hpp"
+#include "Tools/Thread_pinning/Thread_pinning_topology.hpp"
 #include "Tools/Thread_pinning/Thread_pinning_utils.hpp"
 
 using namespace aff3ct;
@@ -20,10 +34,89 @@ using namespace aff3ct::tools;
 #ifdef AFF3CT_CORE_HWLOC
 static hwloc_topology_t g_topology;
 static int g_topodepth = 0;
+
+static Thread_pinning::cpuset_t
+make_cpuset(hwloc_bitmap_t bitmap, const std::string& info)
+{
+    Thread_pinning::cpuset_t cpuset;
+    char* str;
+    hwloc_bitmap_asprintf(&str, bitmap);
+    cpuset.str = str;
+    free(str);
+    cpuset.info = info;
+    cpuset.set = std::shared_ptr<void>(bitmap, [](void* b) { hwloc_bitmap_free((hwloc_bitmap_t)b); });
+    return cpuset;
+}
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+static std::unique_ptr<Thread_pinning_topology> g_topology;
+
+// same format as the hwloc bitmaps: 32-bit words from the most significant one (ex: "0x00000001,0x00000003")
+static std::string
+native_cpuset_str(const cpu_set_t& cpuset)
+{
+    int last_word = 0;
+    for (int c = 0; c < CPU_SETSIZE; c++)
+        if (CPU_ISSET(c, &cpuset)) last_word = c / 32;
+
+    std::stringstream ss;
+    for (int w = last_word; w >= 0; w--)
+    {
+        uint32_t word = 0;
+        for (int b = 0; b < 32; b++)
+            if (CPU_ISSET(w * 32 + b, &cpuset)) word |= (uint32_t)1 << b;
+        ss << "0x" << std::hex << std::setw(8) << std::setfill('0') << word << (w ? "," : "");
+    }
+    return ss.str();
+}
+
+static Thread_pinning::cpuset_t
+make_cpuset(const std::vector<size_t>& cpus, const std::string& info)
+{
+    cpu_set_t* set = new cpu_set_t;
+    CPU_ZERO(set);
+    for (auto c : cpus)
+        if (c < (size_t)CPU_SETSIZE) CPU_SET(c, set);
+
+    Thread_pinning::cpuset_t cpuset;
+    cpuset.str = native_cpuset_str(*set);
+    cpuset.info = info;
+    cpuset.set = std::shared_ptr<void>(set, [](void* s) { delete (cpu_set_t*)s; });
+    return cpuset;
+}
 #endif
-static bool g_is_init = false;
+// 'g_is_init' is also read without the lock by the 'pin(cpuset)' and 'unpin' methods
+static std::atomic<bool> g_is_init(false);
 static std::mutex g_mtx;
 static bool g_enable_logs = false;
+// cpuset restored by the 'unpin' method, resolved by the 'init' method
+static Thread_pinning::cpuset_t g_unpin_cpuset;
+// pinning of the auxiliary threads, the cpuset is resolved at the first 'pin_auxiliary' call after the 'init' method
+static std::string g_aux_policy;
+static Thread_pinning::cpuset_t g_aux_cpuset;
+static std::atomic<bool> g_realtime_warned(false);
+#ifdef AFF3CT_CORE_REALTIME_SCHED
+// scheduling policy of the calling thread before the 'set_realtime' call, restored by the 'unset_realtime' method
+struct sched_state_t
+{
+    bool saved = false;
+    int policy = SCHED_OTHER;
+    sched_param param;
+};
+static thread_local sched_state_t g_prev_sched;
+#endif
+
+#if defined(AFF3CT_CORE_HWLOC) || defined(AFF3CT_CORE_NATIVE_PINNING)
+// binds the calling thread, returns 0 on success and the error number otherwise
+static int
+set_cpubind(const Thread_pinning::cpuset_t& cpuset)
+{
+#ifdef AFF3CT_CORE_HWLOC
+    return hwloc_set_cpubind(g_topology, (hwloc_const_bitmap_t)cpuset.set.get(), HWLOC_CPUBIND_THREAD) ? errno : 0;
+#else
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), (const cpu_set_t*)cpuset.set.get());
+#endif
+}
+#endif
 
 void
 Thread_pinning::init()
@@ -33,8 +126,6 @@ Thread_pinning::init()
         g_mtx.lock();
         if (!g_is_init)
         {
-            g_is_init = true;
-
 #ifdef AFF3CT_CORE_HWLOC
             /* Allocate and initialize topology object. */
             hwloc_topology_init(&g_topology);
@@ -51,7 +142,17 @@ Thread_pinning::init()
             /* Optionally, get some additional topology information
              in case we need the topology depth later. */
             g_topodepth = hwloc_topology_get_depth(g_topology);
+
+            /* The threads are unpinned on the cpuset of the root object. */
+            g_unpin_cpuset = make_cpuset(hwloc_bitmap_dup(hwloc_get_obj_by_depth(g_topology, 0, 0)->cpuset), "root");
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+            /* Read the topology from the sysfs, the allowed PUs are the ones of the calling thread. */
+            g_topology.reset(new Thread_pinning_topology());
+
+            /* The threads are unpinned on the PUs allowed for the process when the topology has been read. */
+            g_unpin_cpuset = make_cpuset(g_topology->get_allowed_cpus(), "allowed PUs");
 #endif
+            g_is_init = true;
         }
         g_mtx.unlock();
     }
@@ -65,12 +166,16 @@ Thread_pinning::destroy()
         g_mtx.lock();
         if (g_is_init)
         {
+            g_is_init = false;
+            g_unpin_cpuset = Thread_pinning::cpuset_t();
+            g_aux_cpuset = Thread_pinning::cpuset_t();
 #ifdef AFF3CT_CORE_HWLOC
             /* Destroy topology object. */
             hwloc_topology_destroy(g_topology);
             g_topodepth = 0;
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+            g_topology.reset();
 #endif
-            g_is_init = false;
         }
         g_mtx.unlock();
     }
@@ -93,7 +198,85 @@ Thread_pinning::is_logs()
 void
 Thread_pinning::pin(const size_t puid)
 {
-    g_mtx.lock();
+    Thread_pinning::pin(Thread_pinning::get_cpuset(puid));
+}
+
+// Thread pinning second function using hwloc objects
+void
+Thread_pinning::pin(const std::string hwloc_objects)
+{
+    Thread_pinning::pin(Thread_pinning::get_cpuset(hwloc_objects));
+}
+
+void
+Thread_pinning::pin(const cpuset_t& cpuset)
+{
+#if defined(AFF3CT_CORE_HWLOC) || defined(AFF3CT_CORE_NATIVE_PINNING)
+    if (g_is_init && cpuset.set != nullptr)
+    {
+        if (g_enable_logs)
+            std::clog << "Thread pinning info -- " << cpuset.info << " -- "
+                      << "bitmap: " << cpuset.str << std::endl;
+
+        /* And try to bind ourself there. */
+        const int error = set_cpubind(cpuset);
+        if (error) std::clog << "Couldn't bind to cpuset " << cpuset.str << ": " << strerror(error) << std::endl;
+    }
+    else if (g_is_init)
+    {
+        if (g_enable_logs)
+        {
+            std::clog << "The cpuset has been resolved before the call to the 'init' method, nothing will be done."
+                      << std::endl;
+        }
+    }
+    else
+    {
+        if (g_enable_logs)
+        {
+            std::clog << "You can't call the 'pin' method if you have not call the 'init' method before, nothing will "
+                      << "be done." << std::endl;
+        }
+    }
+#else
+    if (g_enable_logs)
+    {
+        std::clog << "'pin' method do nothing as AFF3CT has not been linked with the 'hwloc' library." << std::endl;
+    }
+#endif
+}
+
+void
+Thread_pinning::unpin()
+{
+#if defined(AFF3CT_CORE_HWLOC) || defined(AFF3CT_CORE_NATIVE_PINNING)
+    if (!g_is_init)
+    {
+        if (g_enable_logs)
+        {
+            std::clog << "You can't call the 'unpin' method if you have not call the 'init' method before, nothing "
+                      << "will be done." << std::endl;
+        }
+    }
+    else
+    {
+        const int error = set_cpubind(g_unpin_cpuset);
+        if (error)
+            std::clog << "'unpin' method failed ('bitmap_str' = " << g_unpin_cpuset.str
+                      << ", 'error' = " << strerror(error) << ")" << std::endl;
+    }
+#else
+    if (g_enable_logs)
+    {
+        std::clog << "'unpin' method do nothing as AFF3CT has not been linked with the 'hwloc' library." << std::endl;
+    }
+#endif
+}
+
+Thread_pinning::cpuset_t
+Thread_pinning::get_cpuset(const size_t puid)
+{
+    std::lock_guard<std::mutex> lock(g_mtx);
 #ifdef AFF3CT_CORE_HWLOC
     if (g_is_init)
     {
@@ -114,53 +297,31 @@ Thread_pinning::pin(const size_t puid)
         SMT/hyper-threaded). */
         hwloc_bitmap_singlify(cpuset);
 
-        if (g_enable_logs)
-        {
-            char c[128];
-            hwloc_bitmap_snprintf(c, 128, cpuset);
-
-            std::cerr << "Thread pinning info -- "
-                      << "PU logical index (hwloc): " << pu_obj->logical_index << " -- "
-                      << "P OS index: " << pu_obj->os_index << " -- "
-                      << "bitmap: " << c << std::endl;
-        }
-
-        /* And try to bind ourself there. */
-        if (hwloc_set_cpubind(g_topology, cpuset, HWLOC_CPUBIND_THREAD))
-        {
-            char* str;
-            int error = errno;
-            hwloc_bitmap_asprintf(&str, pu_obj->cpuset);
-            std::clog << "Couldn't bind to cpuset " << str << ": " << strerror(error) << std::endl;
-            free(str);
-        }
-
-        /* Free our cpuset copy */
-        hwloc_bitmap_free(cpuset);
+        std::stringstream info;
+        info << "PU logical index (hwloc): " << pu_obj->logical_index << " -- "
+             << "P OS index: " << pu_obj->os_index;
+        return make_cpuset(cpuset, info.str());
     }
-    else
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+    if (g_is_init)
     {
-        if (g_enable_logs)
-        {
-            std::clog << "You can't call the 'pin' method if you have not call the 'init' method before, nothing will "
-                      << "be done." << std::endl;
-        }
+        const auto& cpus = g_topology->get_cpus("PU", puid);
+
+        std::stringstream info;
+        info << "PU logical index (native): " << puid << " -- "
+             << "P OS index: " << cpus[0];
+        return make_cpuset(cpus, info.str());
     }
 #else
-    if (g_enable_logs)
-    {
-        std::clog << "'pin' method do nothing as AFF3CT has not been linked with the 'hwloc' library." << std::endl;
-    }
+    (void)puid;
 #endif
-    g_mtx.unlock();
+    return cpuset_t();
 }
 
-// Thread pinning second function using hwloc objects
-void
-Thread_pinning::pin(const std::string hwloc_objects)
+Thread_pinning::cpuset_t
+Thread_pinning::get_cpuset(const std::string hwloc_objects)
 {
-    g_mtx.lock();
-
+    std::lock_guard<std::mutex> lock(g_mtx);
 #ifdef AFF3CT_CORE_HWLOC
     if (g_is_init)
     {
@@ -186,6 +347,7 @@ Thread_pinning::pin(const std::string hwloc_objects)
             hwloc_obj_t obj = hwloc_get_obj_by_depth(g_topology, object_depth[i], object_numbers[i].second);
             if (obj == nullptr)
             {
+                hwloc_bitmap_free(all_pus);
                 std::stringstream message;
                 message << "obj is nullptr ('Type' = " << hwloc_objects_vector[i] << ").";
                 throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
@@ -193,85 +355,111 @@ Thread_pinning::pin(const std::string hwloc_objects)
             hwloc_bitmap_or(all_pus, all_pus, obj->cpuset);
         }
 
-        if (g_enable_logs)
-        {
-            char c[128];
-            hwloc_bitmap_snprintf(c, 128, all_pus);
-
-            std::clog << "Thread pinning info -- ";
-            for (size_t i = 0; i < hwloc_objects_vector.size(); ++i)
-            {
-                std::clog << "Object = " << hwloc_objects_vector[i] << " | number = " << object_numbers[i].second
-                          << std::endl;
-            }
-            std::clog << "bitmap: " << all_pus << std::endl;
-        }
-
-        /* And try to bind ourself there. */
-        if (hwloc_set_cpubind(g_topology, all_pus, HWLOC_CPUBIND_THREAD))
-        {
-            char* str;
-            int error = errno;
-            hwloc_bitmap_asprintf(&str, all_pus);
-            std::clog << "Couldn't bind to cpuset " << str << ": " << strerror(error) << std::endl;
-            free(str);
-        }
-
-        /* Free our cpuset copy */
-        hwloc_bitmap_free(all_pus);
+        std::stringstream info;
+        info << "Objects = " << hwloc_objects;
+        return make_cpuset(all_pus, info.str());
     }
-    else
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+    if (g_is_init)
     {
-        if (g_enable_logs)
-        {
-            std::clog << "You can't call the 'pin' method if you have not call the 'init' method before, nothing will "
-                      << "be done." << std::endl;
-        }
+        // union of the PUs of the objects (logical or)
+        std::vector<std::string> objects = Thread_pinning_utils::thread_parser(hwloc_objects);
+        std::vector<size_t> all_pus;
+        for (auto& obj : objects)
+            for (auto c : g_topology->get_cpus(obj))
+                if (std::find(all_pus.begin(), all_pus.end(), c) == all_pus.end()) all_pus.push_back(c);
+
+        std::stringstream info;
+        info << "Objects = " << hwloc_objects;
+        return make_cpuset(all_pus, info.str());
     }
 #else
-    if (g_enable_logs)
-    {
-        std::clog << "'pin' method do nothing as AFF3CT has not been linked with the 'hwloc' library." << std::endl;
-    }
+    (void)hwloc_objects;
 #endif
-    g_mtx.unlock();
+    return cpuset_t();
 }
 
 void
-Thread_pinning::unpin()
+Thread_pinning::set_auxiliary_policy(const std::string hwloc_objects)
 {
-    g_mtx.lock();
-#ifdef AFF3CT_CORE_HWLOC
-    if (!g_is_init)
+    std::lock_guard<std::mutex> lock(g_mtx);
+    g_aux_policy = hwloc_objects;
+    g_aux_cpuset = Thread_pinning::cpuset_t();
+}
+
+std::string
+Thread_pinning::get_auxiliary_policy()
+{
+    std::lock_guard<std::mutex> lock(g_mtx);
+    return g_aux_policy;
+}
+
+void
+Thread_pinning::pin_auxiliary()
+{
+    std::string policy;
+    Thread_pinning::cpuset_t cpuset;
     {
-        if (g_enable_logs)
-        {
-            std::clog << "You can't call the 'unpin' method if you have not call the 'init' method before, nothing "
-                      << "will be done." << std::endl;
-        }
+        std::lock_guard<std::mutex> lock(g_mtx);
+        policy = g_aux_policy;
+        cpuset = g_aux_cpuset;
     }
-    else
+    if (policy.empty()) return;
+
+    if (cpuset.set == nullptr)
     {
-        // get cpuset of root object
-        hwloc_cpuset_t unpin_set = hwloc_bitmap_dup(hwloc_get_obj_by_depth(g_topology, 0, 0)->cpuset);
-        if (hwloc_set_cpubind(g_topology, unpin_set, HWLOC_CPUBIND_THREAD))
-        {
-            char* bitmap_str;
-            int error = errno;
-            hwloc_bitmap_asprintf(&bitmap_str, unpin_set);
-            std::clog << "'unpin' method failed ('bitmap_str' = " << bitmap_str << ", 'error' = " << strerror(error)
-                      << ")" << std::endl;
-            free(bitmap_str);
-        }
-        hwloc_bitmap_free(unpin_set);
+        cpuset = Thread_pinning::get_cpuset(policy);
+        std::lock_guard<std::mutex> lock(g_mtx);
+        if (g_aux_policy == policy) g_aux_cpuset = cpuset;
     }
-#else
-    if (g_enable_logs)
+
+    Thread_pinning::pin(cpuset);
+}
+
+bool
+Thread_pinning::set_realtime(const int priority)
+{
+#ifdef AFF3CT_CORE_REALTIME_SCHED
+    // the policy is saved once: a second call must not save the real-time policy set by the first one
+    sched_state_t prev;
+    if (!g_prev_sched.saved)
+        prev.saved = !pthread_getschedparam(pthread_self(), &prev.policy, &prev.param);
+
+    sched_param param;
+    param.sched_priority =
+      std::min(std::max(priority, sched_get_priority_min(SCHED_FIFO)), sched_get_priority_max(SCHED_FIFO));
+    const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error)
     {
-        std::clog << "'unpin' method do nothing as AFF3CT has not been linked with the 'hwloc' library." << std::endl;
+        // warn only once, the other threads of the run would fail for the same reason
+        if (!g_realtime_warned.exchange(true))
+            std::clog << "Real-time scheduling is not available ('SCHED_FIFO', 'priority' = " << param.sched_priority
+                      << ", 'error' = " << strerror(error) << "), the threads keep their scheduling policy."
+                      << std::endl;
+        return false;
     }
+    if (prev.saved) g_prev_sched = prev;
+    if (g_enable_logs)
+        std::clog << "Thread scheduling info -- SCHED_FIFO -- priority: " << param.sched_priority << std::endl;
+    return true;
+#else
+    if (!g_realtime_warned.exchange(true))
+        std::clog << "Real-time scheduling is not available on this system ('priority' = " << priority
+                  << "), the threads keep their scheduling policy." << std::endl;
+    return false;
+#endif
+}
+
+void
+Thread_pinning::unset_realtime()
+{
+#ifdef AFF3CT_CORE_REALTIME_SCHED
+    if (!g_prev_sched.saved) return;
+    g_prev_sched.saved = false;
+    const int error = pthread_setschedparam(pthread_self(), g_prev_sched.policy, &g_prev_sched.param);
+    if (error)
+        std::clog << "'unset_realtime' method failed ('error' = " << strerror(error) << ")." << std::endl;
 #endif
-    g_mtx.unlock();
 }
 
 std::string
@@ -289,9 +477,15 @@ Thread_pinning::get_cur_cpuset_str()
     hwloc_bitmap_free(cur_cpuset);
 
     return std::string(c);
+#elif defined(AFF3CT_CORE_NATIVE_PINNING)
+    cpu_set_t cur_cpuset;
+    CPU_ZERO(&cur_cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cur_cpuset), &cur_cpuset);
+    return native_cpuset_str(cur_cpuset);
 #else
     std::stringstream message;
-    message << "'get_cur_cpuset_str' method can be called only if AFF3CT is linked with the 'hwloc' library.";
+    message << "'get_cur_cpuset_str' method can be called only if AFF3CT is linked with the 'hwloc' library or on "
+            << "Linux.";
     throw tools::runtime_error(__FILE__, __LINE__, __func__, message.str());
 #endif
 }
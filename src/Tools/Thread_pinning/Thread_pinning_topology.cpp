@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "Tools/Exception/exception.hpp"
+#include "Tools/Thread_pinning/Thread_pinning_topology.hpp"
+
+using namespace aff3ct;
+using namespace aff3ct::tools;
+
+static bool
+read_line(const std::string& path, std::string& line)
+{
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+    std::getline(file, line); // the file can be empty (ex: NUMA node without CPU)
+    return !file.bad();
+}
+
+static bool
+read_int(const std::string& path, int& value)
+{
+    std::string line;
+    if (!read_line(path, line)) return false;
+    try
+    {
+        value = std::stoi(line);
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+    return true;
+}
+
+std::vector<size_t>
+Thread_pinning_topology::parse_cpulist(const std::string& cpulist)
+{
+    std::vector<size_t> cpus;
+    std::stringstream ss(cpulist);
+    std::string range;
+    while (std::getline(ss, range, ','))
+    {
+        range.erase(std::remove_if(range.begin(), range.end(), ::isspace), range.end());
+        if (range.empty()) continue;
+        try
+        {
+            const auto dash = range.find('-');
+            const size_t first = (size_t)std::stoul(range.substr(0, dash));
+            const size_t last = dash == std::string::npos ? first : (size_t)std::stoul(range.substr(dash + 1));
+            for (size_t c = first; c <= last; c++)
+                cpus.push_back(c);
+        }
+        catch (std::exception const&)
+        {
+            std::stringstream message;
+            message << "'cpulist' is not a valid list of CPUs ('cpulist' = \"" << cpulist << "\").";
+            throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+        }
+    }
+    return cpus;
+}
+
+Thread_pinning_topology::Thread_pinning_topology(const std::string& sysfs_path,
+                                                 const std::vector<size_t>& allowed_cpus)
+  : allowed_cpus(allowed_cpus)
+{
+    // PUs allowed for the process (the cgroup cpuset of the containers is taken into account)
+#ifdef __linux__
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (this->allowed_cpus.empty() && sched_getaffinity(0, sizeof(allowed), &allowed) == 0)
+    {
+        for (size_t c = 0; c < (size_t)CPU_SETSIZE; c++)
+            if (CPU_ISSET(c, &allowed)) this->allowed_cpus.push_back(c);
+    }
+#endif
+    if (this->allowed_cpus.empty())
+        for (size_t c = 0; c < (size_t)std::max(1u, std::thread::hardware_concurrency()); c++)
+            this->allowed_cpus.push_back(c);
+
+    std::vector<size_t> cpus = this->allowed_cpus;
+    std::string online;
+    if (read_line(sysfs_path + "/cpu/online", online))
+    {
+        const auto online_cpus = Thread_pinning_topology::parse_cpulist(online);
+        cpus.erase(std::remove_if(cpus.begin(),
+                                  cpus.end(),
+                                  [&online_cpus](const size_t c) {
+                                      return std::find(online_cpus.begin(), online_cpus.end(), c) == online_cpus.end();
+                                  }),
+                   cpus.end());
+    }
+
+    // PUs sorted by package, die, core and OS index
+    std::vector<std::tuple<int, int, int, size_t>> pus;
+    for (auto c : cpus)
+    {
+        const std::string topo = sysfs_path + "/cpu/cpu" + std::to_string(c) + "/topology/";
+        int package = 0, die = 0, core = (int)c;
+        read_int(topo + "physical_package_id", package);
+        read_int(topo + "die_id", die);
+        read_int(topo + "core_id", core);
+        pus.push_back(std::make_tuple(package, die, core, c));
+    }
+    std::sort(pus.begin(), pus.end());
+    for (size_t p = 0; p < pus.size(); p++)
+    {
+        this->objects["PU"].push_back({ std::get<3>(pus[p]) });
+        this->pu_logical_indexes[std::get<3>(pus[p])] = p;
+    }
+
+    // the other objects are the groups of PUs sharing the same key, sorted by their first PU
+    std::map<std::string, std::map<std::string, std::vector<size_t>>> groups;
+    for (auto& pu : pus)
+    {
+        const auto c = std::get<3>(pu);
+        groups["PACKAGE"][std::to_string(std::get<0>(pu))].push_back(c);
+        groups["CORE"][std::to_string(std::get<0>(pu)) + ":" + std::to_string(std::get<1>(pu)) + ":" +
+                       std::to_string(std::get<2>(pu))]
+          .push_back(c);
+
+        const std::string cache = sysfs_path + "/cpu/cpu" + std::to_string(c) + "/cache/index";
+        for (size_t i = 0;; i++)
+        {
+            int level = 0;
+            std::string type, shared;
+            if (!read_int(cache + std::to_string(i) + "/level", level)) break;
+            if (!read_line(cache + std::to_string(i) + "/type", type)) break;
+            if (!read_line(cache + std::to_string(i) + "/shared_cpu_list", shared)) shared = std::to_string(c);
+            if (type == "Data" || type == "Unified")
+                groups["L" + std::to_string(level) + "D"][shared].push_back(c);
+            else if (type == "Instruction")
+                groups["L" + std::to_string(level) + "I"][shared].push_back(c);
+        }
+    }
+
+    for (size_t n = 0;; n++)
+    {
+        std::string cpulist;
+        if (!read_line(sysfs_path + "/node/node" + std::to_string(n) + "/cpulist", cpulist)) break;
+        for (auto c : Thread_pinning_topology::parse_cpulist(cpulist))
+            if (this->pu_logical_indexes.count(c)) groups["NUMA"][std::to_string(n)].push_back(c);
+    }
+    if (groups["NUMA"].empty()) // no NUMA information: all the PUs are in one node
+        for (auto& pu : pus)
+            groups["NUMA"]["0"].push_back(std::get<3>(pu));
+
+    for (auto& type : groups)
+    {
+        auto& objs = this->objects[type.first];
+        for (auto& group : type.second)
+            objs.push_back(group.second);
+        std::sort(objs.begin(),
+                  objs.end(),
+                  [this](const std::vector<size_t>& o1, const std::vector<size_t>& o2)
+                  { return this->pu_logical_indexes.at(o1[0]) < this->pu_logical_indexes.at(o2[0]); });
+    }
+}
+
+std::vector<std::string>
+Thread_pinning_topology::get_types() const
+{
+    std::vector<std::string> types;
+    for (auto& type : this->objects)
+        types.push_back(type.first);
+    return types;
+}
+
+size_t
+Thread_pinning_topology::get_n_objects(const std::string& type) const
+{
+    auto it = this->objects.find(type);
+    return it != this->objects.end() ? it->second.size() : 0;
+}
+
+const std::vector<size_t>&
+Thread_pinning_topology::get_cpus(const std::string& type, const size_t logical_index) const
+{
+    if (logical_index >= this->get_n_objects(type))
+    {
+        std::stringstream message;
+        message << "The object does not exist in the topology ('type' = " << type
+                << ", 'logical_index' = " << logical_index << ", 'get_n_objects(type)' = " << this->get_n_objects(type)
+                << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->objects.find(type)->second[logical_index];
+}
+
+std::vector<size_t>
+Thread_pinning_topology::get_cpus(const std::string& object) const
+{
+    const auto underscore = object.rfind('_');
+    size_t logical_index = 0;
+    try
+    {
+        if (underscore == std::string::npos) throw std::invalid_argument("");
+        logical_index = (size_t)std::stoul(object.substr(underscore + 1));
+    }
+    catch (std::exception const&)
+    {
+        std::stringstream message;
+        message << "'object' has to be of the form 'TYPE_INDEX' ('object' = " << object << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return this->get_cpus(object.substr(0, underscore), logical_index);
+}
+
+size_t
+Thread_pinning_topology::get_pu_logical_index(const size_t os_index) const
+{
+    auto it = this->pu_logical_indexes.find(os_index);
+    if (it == this->pu_logical_indexes.end())
+    {
+        std::stringstream message;
+        message << "The PU is not in the topology ('os_index' = " << os_index << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    return it->second;
+}
+
+const std::vector<size_t>&
+Thread_pinning_topology::get_allowed_cpus() const
+{
+    return this->allowed_cpus;
+}
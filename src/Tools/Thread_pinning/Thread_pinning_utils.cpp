@@ -1,7 +1,9 @@
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 
 #include "Tools/Exception/exception.hpp"
+#include "Tools/Thread_pinning/Thread_pinning_topology.hpp"
 #include <Tools/Thread_pinning/Thread_pinning_utils.hpp>
 
 using namespace aff3ct;
@@ -118,6 +120,124 @@ Thread_pinning_utils::thread_parser(std::string const& hwloc_objects_thread)
     return vector_objets;
 }
 
+std::string
+Thread_pinning_utils::get_reserved_object(const Thread_pinning_topology& topology, const bool reserve_core)
+{
+    // no core is left free if there is only one core
+    const size_t n_cores = topology.get_n_objects("CORE");
+    if (!reserve_core || n_cores < 2) return "";
+    return "CORE_" + std::to_string(n_cores - 1);
+}
+
+std::string
+Thread_pinning_utils::generate_pipeline_policy(const Thread_pinning_topology& topology,
+                                               const std::vector<size_t>& n_threads,
+                                               const std::vector<bool>& synchro_active_waiting,
+                                               const bool reserve_core)
+{
+    if (n_threads.empty())
+    {
+        std::stringstream message;
+        message << "'n_threads' can't be empty.";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    if (!synchro_active_waiting.empty() && synchro_active_waiting.size() != n_threads.size() - 1)
+    {
+        std::stringstream message;
+        message << "'synchro_active_waiting.size()' has to be equal to 'n_threads.size()' - 1 or to 0 "
+                << "('synchro_active_waiting.size()' = " << synchro_active_waiting.size()
+                << ", 'n_threads.size()' = " << n_threads.size() << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
+    // cores sorted by L3 cache (or by NUMA node if the L3 caches are unknown), then by logical index
+    const size_t n_cores = topology.get_n_objects("CORE");
+    const std::string domain_type = topology.get_n_objects("L3D") ? "L3D" : "NUMA";
+    std::vector<size_t> cores;
+    std::vector<bool> is_sorted(n_cores, false);
+    for (size_t d = 0; d < topology.get_n_objects(domain_type); d++)
+    {
+        const auto& domain = topology.get_cpus(domain_type, d);
+        for (size_t c = 0; c < n_cores; c++)
+        {
+            const auto first_pu = topology.get_cpus("CORE", c)[0];
+            if (!is_sorted[c] && std::find(domain.begin(), domain.end(), first_pu) != domain.end())
+            {
+                cores.push_back(c);
+                is_sorted[c] = true;
+            }
+        }
+    }
+    for (size_t c = 0; c < n_cores; c++)
+        if (!is_sorted[c]) cores.push_back(c);
+    if (reserve_core && cores.size() > 1) cores.erase(std::find(cores.begin(), cores.end(), n_cores - 1));
+
+    // logical indexes of the PUs of each core (the SMT siblings)
+    std::vector<std::vector<size_t>> core_pus(cores.size());
+    size_t n_smt = 0;
+    for (size_t k = 0; k < cores.size(); k++)
+    {
+        for (auto os_index : topology.get_cpus("CORE", cores[k]))
+            core_pus[k].push_back(topology.get_pu_logical_index(os_index));
+        n_smt = std::max(n_smt, core_pus[k].size());
+    }
+
+    // a thread is busy-waiting if one of the synchronizations of its stage is in active waiting
+    std::vector<bool> is_active;
+    std::vector<size_t> stage_of;
+    for (size_t s = 0; s < n_threads.size(); s++)
+        for (size_t t = 0; t < std::max((size_t)1, n_threads[s]); t++)
+        {
+            const bool wait_prev = s > 0 && s - 1 < synchro_active_waiting.size() && synchro_active_waiting[s - 1];
+            const bool wait_next = s < synchro_active_waiting.size() && synchro_active_waiting[s];
+            is_active.push_back(wait_prev || wait_next);
+            stage_of.push_back(s);
+        }
+
+    // the first PU of each core is taken stage after stage, then the SMT siblings (one level after the other): a
+    // busy-waiting thread goes next to a passive thread when possible (and vice versa), when all the PUs are taken
+    // the threads share the PUs in the same order
+    std::vector<size_t> pus_order, thread_pu(is_active.size());
+    std::vector<int> core_active(cores.size(), -1); // -1: free, 0: passive thread(s), 1: busy-waiting thread(s)
+    size_t th = 0;
+    for (size_t level = 0; level < n_smt && th < is_active.size(); level++)
+    {
+        std::vector<bool> is_used(cores.size(), false);
+        for (size_t k = 0; k < cores.size(); k++)
+            is_used[k] = core_pus[k].size() <= level;
+        for (size_t n = 0; n < cores.size() && th < is_active.size(); n++)
+        {
+            size_t best = cores.size();
+            for (size_t k = 0; k < cores.size(); k++)
+                if (!is_used[k])
+                {
+                    if (best == cores.size()) best = k;
+                    if (level == 0 || core_active[k] != (int)is_active[th])
+                    {
+                        best = k;
+                        break;
+                    }
+                }
+            if (best == cores.size()) break;
+            is_used[best] = true;
+            core_active[best] = std::max(core_active[best], (int)is_active[th]);
+            pus_order.push_back(core_pus[best][level]);
+            thread_pu[th++] = core_pus[best][level];
+        }
+    }
+    for (size_t t = th; t < is_active.size(); t++)
+        thread_pu[t] = pus_order[(t - th) % pus_order.size()];
+
+    std::stringstream policy;
+    for (size_t t = 0; t < is_active.size(); t++)
+    {
+        if (t > 0) policy << (stage_of[t] != stage_of[t - 1] ? " | " : "; ");
+        policy << "PU_" << thread_pu[t];
+    }
+    return policy.str();
+}
+
 #ifdef AFF3CT_CORE_HWLOC
 std::pair<hwloc_obj_type_t, int>
 Thread_pinning_utils::str_to_hwloc_object(std::string& str_object)
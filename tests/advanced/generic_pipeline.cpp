@@ -127,6 +127,9 @@ main(int argc, char** argv)
                           { "sck-type-tsk", no_argument, NULL, 'r' },
                           { "sck-type-sta", no_argument, NULL, 'R' },
                           { "pinning-policy", no_argument, NULL, 'P' },
+                          { "auto-pinning", no_argument, NULL, 'A' },
+                          { "realtime-priority", required_argument, NULL, 'T' },
+                          { "merge", required_argument, NULL, 'M' },
                           { 0 } };
 
     std::string n_threads_param;
@@ -152,10 +155,13 @@ main(int argc, char** argv)
     std::string sck_type_sta_param;
     std::vector<std::string> sck_type_sta;
     std::string pinning_policy;
+    bool auto_pinning = false;
+    int realtime_priority = 0;
+    std::string merge = "RR";
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:n:r:R:P:cpbgqwh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:n:r:R:P:T:M:cpbgqwAh", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -220,6 +226,15 @@ main(int argc, char** argv)
             case 'P':
                 pinning_policy = std::string(optarg);
                 break;
+            case 'A':
+                auto_pinning = true;
+                break;
+            case 'T':
+                realtime_priority = std::atoi(optarg);
+                break;
+            case 'M':
+                merge = std::string(optarg);
+                break;
             case 'h':
                 std::cout << "usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << std::endl;
@@ -282,6 +297,15 @@ main(int argc, char** argv)
                           << "Pinning policy for pipeline execution                                 "
                           << "[" << (pinning_policy.empty() ? "empty" : "\"" + pinning_policy + "\"") << "]"
                           << std::endl;
+                std::cout << "  -A, --auto-pinning       "
+                          << "Generate the pinning policy from the topology (if no '-P' policy)     "
+                          << "[" << (auto_pinning ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -T, --realtime-priority  "
+                          << "Real-time priority of the stages (SCHED_FIFO, 0 to disable)           "
+                          << "[" << realtime_priority << "]" << std::endl;
+                std::cout << "  -M, --merge              "
+                          << "Replicas merge before a sequential stage (RR, ORDERED or UNORDERED)   "
+                          << "[\"" << merge << "\"]" << std::endl;
                 std::cout << "  -h, --help               "
                           << "This help                                                             "
                           << "[false]" << std::endl;
@@ -299,6 +323,12 @@ main(int argc, char** argv)
         throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
     }
 
+    if (merge != "RR" && merge != "ORDERED" && merge != "UNORDERED")
+    {
+        message << "The merge has to be 'RR', 'ORDERED' or 'UNORDERED' ('merge' = " << merge << ").";
+        throw tools::invalid_argument(__FILE__, __LINE__, __func__, message.str());
+    }
+
     // Constructing the socket type vector in case of stage socket
     for (size_t i = 0; i < sck_type_sta.size(); ++i)
     {
@@ -343,6 +373,9 @@ main(int argc, char** argv)
               << std::endl;
     std::cout << "#   - pinning_policy = " << (pinning_policy.empty() ? "[empty]" : pinning_policy.c_str())
               << std::endl;
+    std::cout << "#   - auto_pinning   = " << (auto_pinning ? "true" : "false") << std::endl;
+    std::cout << "#   - realtime_prio  = " << realtime_priority << std::endl;
+    std::cout << "#   - merge          = " << merge << std::endl;
     std::cout << "#   - n_inter_frames = " << n_inter_frames << std::endl;
     std::cout << "#   - sleep_time_us  = " << sleep_time_us << std::endl;
     std::cout << "#   - data_length    = " << data_length << std::endl;
@@ -506,7 +539,20 @@ main(int argc, char** argv)
         for (size_t i = 0; i < stages_number + 1; ++i)
             wait_vect.push_back(active_waiting);
 
-#ifdef AFF3CT_CORE_HWLOC
+        // generate the pinning policy from the topology of the machine, it can be copied in the '-P' option
+        if (auto_pinning && pinning_policy.empty())
+        {
+            const tools::Thread_pinning_topology topology;
+            pinning_policy = tools::Thread_pinning_utils::generate_pipeline_policy(topology, n_threads, wait_vect);
+            std::cout << "# Generated pinning policy: \"" << pinning_policy << "\"" << std::endl;
+
+            // the auxiliary threads (terminal, exporters, profiler) run on the reserved core
+            const auto aux_policy = tools::Thread_pinning_utils::get_reserved_object(topology);
+            tools::Thread_pinning::set_auxiliary_policy(aux_policy);
+            std::cout << "# Auxiliary pinning policy: \"" << aux_policy << "\"" << std::endl;
+        }
+
+#if defined(AFF3CT_CORE_HWLOC) || defined(AFF3CT_CORE_NATIVE_PINNING)
         // Stages to pin
         if (!pinning_policy.empty())
         {
@@ -525,6 +571,12 @@ main(int argc, char** argv)
               new runtime::Pipeline(source("generate"), stage_creat, n_threads, pool_buff, wait_vect));
         }
         pipeline_chain->set_n_frames(n_inter_frames);
+        for (size_t s = 0; s < pipeline_chain->get_stages().size(); s++)
+            pipeline_chain->set_realtime_priority(s, realtime_priority);
+        if (merge == "ORDERED")
+            pipeline_chain->set_synchro_merge(module::Adaptor_n_to_1::merge_t::ORDERED);
+        else if (merge == "UNORDERED")
+            pipeline_chain->set_synchro_merge(module::Adaptor_n_to_1::merge_t::UNORDERED);
 
         if (!dot_filepath.empty())
         {
@@ -1,13 +1,21 @@
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 #include <cstdlib>
 #include <fstream>
 #include <getopt.h>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
 #include <aff3ct-core.hpp>
 using namespace aff3ct;
 
@@ -36,6 +44,87 @@ compare_files(const std::string& filename1, const std::string& filename2)
     return std::equal(begin1, std::istreambuf_iterator<char>(), begin2); // Second argument is end-of-range iterator
 }
 
+// connect to the metrics server like a scraper would do and return the HTTP response
+std::string
+scrape_unix_socket(const std::string& path)
+{
+    std::string response;
+#if defined(__unix__) || defined(__APPLE__)
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    path.copy(addr.sun_path, sizeof(addr.sun_path) - 1);
+    if (fd >= 0 && connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0)
+    {
+        const std::string request = "GET /metrics HTTP/1.0\r\n\r\n";
+        if (send(fd, request.data(), request.size(), 0) == (ssize_t)request.size())
+        {
+            char buffer[4096];
+            ssize_t n;
+            while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0)
+                response.append(buffer, (size_t)n);
+        }
+    }
+    if (fd >= 0) close(fd);
+#endif
+    return response;
+}
+
+// reporter supporting the typed snapshots only for its 'n_snapshots' first calls
+class Reporter_limited : public tools::Reporter
+{
+  protected:
+    size_t n_snapshots;
+
+  public:
+    explicit Reporter_limited(const size_t n_snapshots)
+      : n_snapshots(n_snapshots)
+    {
+    }
+
+    virtual report_t report(bool /*final*/ = false) { return report_t(); }
+
+    virtual bool snapshot(snapshot_t& /*snap*/, bool /*final*/ = false)
+    {
+        if (this->n_snapshots == 0) return false;
+        this->n_snapshots--;
+        return true;
+    }
+};
+
+// the errors of the binary exporter are thrown by 'start' (caller thread) or rethrown by 'stop' (background thread)
+bool
+check_exporter_errors(const std::string& filepath)
+{
+    bool start_thrown = false, stop_thrown = false;
+
+    Reporter_limited rep_no_snapshot(0);
+    tools::Exporter_probe exp_no_snapshot(filepath, { &rep_no_snapshot });
+    try
+    {
+        exp_no_snapshot.start();
+    }
+    catch (tools::runtime_error const&)
+    {
+        start_thrown = true;
+    }
+
+    Reporter_limited rep_one_snapshot(1);
+    tools::Exporter_probe exp_one_snapshot(filepath, { &rep_one_snapshot });
+    exp_one_snapshot.start(std::chrono::milliseconds(1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    try
+    {
+        exp_one_snapshot.stop();
+    }
+    catch (tools::runtime_error const&)
+    {
+        stop_thrown = true;
+    }
+
+    return start_thrown && stop_thrown;
+}
+
 int
 main(int argc, char** argv)
 {
@@ -50,6 +139,8 @@ main(int argc, char** argv)
                           { "in-filepath", required_argument, NULL, 'i' },
                           { "out-filepath", required_argument, NULL, 'j' },
                           { "probes-filepath", required_argument, NULL, 'a' },
+                          { "export-filepath", required_argument, NULL, 'x' },
+                          { "metrics-socket", required_argument, NULL, 'm' },
                           { "copy-mode", no_argument, NULL, 'c' },
                           { "print-stats", no_argument, NULL, 'p' },
                           { "step-by-step", no_argument, NULL, 'b' },
@@ -68,6 +159,8 @@ main(int argc, char** argv)
     std::string in_filepath;
     std::string out_filepath = "file.out";
     std::string probes_filepath = "probes.out";
+    std::string export_filepath;
+    std::string metrics_socket;
     bool no_copy_mode = true;
     bool print_stats = false;
     bool step_by_step = false;
@@ -77,7 +170,7 @@ main(int argc, char** argv)
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:a:cpbgqwh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:a:x:m:cpbgqwh", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -108,6 +201,12 @@ main(int argc, char** argv)
             case 'a':
                 probes_filepath = std::string(optarg);
                 break;
+            case 'x':
+                export_filepath = std::string(optarg);
+                break;
+            case 'm':
+                metrics_socket = std::string(optarg);
+                break;
             case 'c':
                 no_copy_mode = false;
                 break;
@@ -156,6 +255,14 @@ main(int argc, char** argv)
                 std::cout << "  -a, --probes-filepath "
                           << "Path to the output probe file (written during the execution)          "
                           << "[" << (out_filepath.empty() ? "empty" : "\"" + out_filepath + "\"") << "]" << std::endl;
+                std::cout << "  -x, --export-filepath "
+                          << "Path to the binary probe file (replaces the probe file when set)      "
+                          << "[" << (export_filepath.empty() ? "empty" : "\"" + export_filepath + "\"") << "]"
+                          << std::endl;
+                std::cout << "  -m, --metrics-socket  "
+                          << "Path to the Unix socket of the metrics server (replaces the probe file)"
+                          << "[" << (metrics_socket.empty() ? "empty" : "\"" + metrics_socket + "\"") << "]"
+                          << std::endl;
                 std::cout << "  -c, --copy-mode       "
                           << "Enable to copy data in sequence (performance will be reduced)         "
                           << "[" << (no_copy_mode ? "false" : "true") << "]" << std::endl;
@@ -200,6 +307,10 @@ main(int argc, char** argv)
     std::cout << "#   - out_filepath    = " << (out_filepath.empty() ? "[empty]" : out_filepath.c_str()) << std::endl;
     std::cout << "#   - probes_filepath = " << (probes_filepath.empty() ? "[empty]" : probes_filepath.c_str())
               << std::endl;
+    std::cout << "#   - export_filepath = " << (export_filepath.empty() ? "[empty]" : export_filepath.c_str())
+              << std::endl;
+    std::cout << "#   - metrics_socket  = " << (metrics_socket.empty() ? "[empty]" : metrics_socket.c_str())
+              << std::endl;
     std::cout << "#   - no_copy_mode    = " << (no_copy_mode ? "true" : "false") << std::endl;
     std::cout << "#   - print_stats     = " << (print_stats ? "true" : "false") << std::endl;
     std::cout << "#   - step_by_step    = " << (step_by_step ? "true" : "false") << std::endl;
@@ -263,7 +374,26 @@ main(int argc, char** argv)
     tools::Terminal_dump terminal_probes({ &rep_fra_stats, &rep_thr_stats, &rep_timestamp_stats, &rep_bitvals });
 
     std::ofstream probes_file;
-    if (!probes_filepath.empty())
+    std::unique_ptr<tools::Exporter_probe> exporter_probes;
+    std::unique_ptr<tools::Exporter_metrics> exporter_metrics;
+    bool exporter_errors = true;
+    if (!metrics_socket.empty())
+    {
+        // the metrics server drains the reporters at each scrape, the probe file is not written
+        exporter_metrics.reset(new tools::Exporter_metrics(
+          "unix:" + metrics_socket, { &rep_fra_stats, &rep_thr_stats, &rep_timestamp_stats, &rep_bitvals }));
+        exporter_metrics->start();
+    }
+    else if (!export_filepath.empty())
+    {
+        exporter_errors = check_exporter_errors(export_filepath);
+
+        // the binary exporter drains the reporters in a background thread, the probe file is not written
+        exporter_probes.reset(new tools::Exporter_probe(
+          export_filepath, { &rep_fra_stats, &rep_thr_stats, &rep_timestamp_stats, &rep_bitvals }));
+        exporter_probes->start();
+    }
+    else if (!probes_filepath.empty())
     {
         probes_file.open(probes_filepath);
         terminal_probes.legend(probes_file);
@@ -334,10 +464,15 @@ main(int argc, char** argv)
     prb_ts_s3e      (     "probe"          ) = prb_ts_s2e            (     "probe"           );
     // clang-format on
 
-    // stop condition that write the probes data into a file
-    std::function<bool()> stop_condition = [&terminal_probes, &probes_file]()
+    // stop condition that write the probes data into a file, the metrics server is scraped once during the execution
+    // (the other replicas and stages keep running while the first one waits for the response)
+    std::string live_response;
+    std::atomic<bool> live_scraped(false);
+    std::function<bool()> stop_condition =
+      [&terminal_probes, &probes_file, &metrics_socket, &live_response, &live_scraped]()
     {
         if (probes_file.is_open()) terminal_probes.temp_report(probes_file);
+        if (!metrics_socket.empty() && !live_scraped.exchange(true)) live_response = scrape_unix_socket(metrics_socket);
         return false;
     };
 
@@ -348,6 +483,7 @@ main(int argc, char** argv)
         sequence_chain.reset(new runtime::Sequence(prb_ts_s1b("probe"), n_threads));
         sequence_chain->set_n_frames(n_inter_frames);
         sequence_chain->set_no_copy_mode(no_copy_mode);
+        if (exporter_metrics) exporter_metrics->register_sequence(*sequence_chain, "probe");
 
         if (!dot_filepath.empty())
         {
@@ -360,10 +496,10 @@ main(int argc, char** argv)
             for (auto& tsk : mod->tasks)
             {
                 tsk->reset();
-                tsk->set_debug(debug);       // disable the debug mode
-                tsk->set_debug_limit(16);    // display only the 16 first bits if the debug mode is enabled
-                tsk->set_stats(print_stats); // enable the statistics
-                tsk->set_fast(true);         // enable the fast mode (= disable the useless verifs in the tasks)
+                tsk->set_debug(debug);    // disable the debug mode
+                tsk->set_debug_limit(16); // display only the 16 first bits if the debug mode is enabled
+                tsk->set_stats(print_stats || exporter_metrics != nullptr); // enable the statistics
+                tsk->set_fast(true); // enable the fast mode (= disable the useless verifs in the tasks)
             }
 
         // reset the probes (to initialize the timers)
@@ -439,6 +575,8 @@ main(int argc, char** argv)
             active_waiting, // type of waiting between stages 1 and 2 (true = active, false = passive)
           }));
         pipeline_chain->set_n_frames(n_inter_frames);
+        pipeline_chain->set_synchro_telemetry(!metrics_socket.empty());
+        if (exporter_metrics) exporter_metrics->register_pipeline(*pipeline_chain, "probe");
 
         if (!dot_filepath.empty())
         {
@@ -451,10 +589,10 @@ main(int argc, char** argv)
             for (auto& tsk : mod->tasks)
             {
                 tsk->reset();
-                tsk->set_debug(debug);       // disable the debug mode
-                tsk->set_debug_limit(16);    // display only the 16 first bits if the debug mode is enabled
-                tsk->set_stats(print_stats); // enable the statistics
-                tsk->set_fast(true);         // enable the fast mode (= disable the useless verifs in the tasks)
+                tsk->set_debug(debug);    // disable the debug mode
+                tsk->set_debug_limit(16); // display only the 16 first bits if the debug mode is enabled
+                tsk->set_stats(print_stats || exporter_metrics != nullptr); // enable the statistics
+                tsk->set_fast(true); // enable the fast mode (= disable the useless verifs in the tasks)
             }
 
         // reset the probes (to initialize the timers)
@@ -470,6 +608,7 @@ main(int argc, char** argv)
     }
 
     if (probes_file.is_open()) terminal_probes.final_report(probes_file);
+    if (exporter_probes) exporter_probes->stop();
 
     size_t in_filesize = filesize(in_filepath.c_str());
     size_t n_frames = ((int)std::ceil((float)(in_filesize * 8) / (float)(data_length * n_inter_frames)));
@@ -479,6 +618,53 @@ main(int argc, char** argv)
 
     // verification of the sequence execution
     bool tests_passed = compare_files(in_filepath, out_filepath);
+
+    // verification of the exported probes: one frame id per frame and all the bits of the input file
+    if (exporter_probes)
+    {
+        tools::Exporter_probe_reader reader(export_filepath);
+        const auto fids = reader.read_column<int64_t>("FRAME_ID");
+        const auto counts = reader.read_column<uint32_t>("Count");
+        const auto bits = reader.read_column<uint8_t>("Bits");
+        size_t n_bits = 0;
+        for (auto c : counts)
+            n_bits += c;
+        bool exp_passed = fids.size() == counts.size() && bits.size() == counts.size() * data_length &&
+                          n_bits == in_filesize * 8;
+        for (size_t f = 0; f < fids.size(); f++)
+            exp_passed = exp_passed && fids[f] == (int64_t)f;
+        if (!exporter_errors) std::cout << "# The errors of the exporter are not thrown to the caller." << std::endl;
+        exp_passed = exp_passed && exporter_errors;
+        std::cout << "# Exported probes: " << exporter_probes->get_n_values() << " values in "
+                  << reader.get_n_blocks() << " blocks (" << fids.size() << " frames)" << std::endl;
+        if (!exp_passed)
+            std::cout << "# " << rang::style::bold << rang::fg::red << "Exported probes check failed :-("
+                      << rang::style::reset << std::endl;
+        tests_passed = tests_passed && exp_passed;
+    }
+
+    // verification of the metrics server: the tasks, the probes (and the adaptors with a pipeline) are served
+    if (exporter_metrics)
+    {
+        const std::string response = scrape_unix_socket(metrics_socket);
+        bool met_passed = live_response.find("HTTP/1.0 200 OK") == 0 &&
+                          live_response.find("aff3ct_task_calls_total{") != std::string::npos &&
+                          response.find("HTTP/1.0 200 OK") == 0 &&
+                          response.find("# TYPE aff3ct_task_calls_total counter") != std::string::npos &&
+                          response.find("aff3ct_task_duration_seconds_total{") != std::string::npos &&
+                          response.find("aff3ct_probe_value{group=\"Counters\",column=\"FRAME_ID\"") !=
+                            std::string::npos;
+        if (!force_sequence)
+            met_passed = met_passed && response.find("aff3ct_adaptor_calls_total{") != std::string::npos;
+        exporter_metrics->stop();
+        std::cout << "# Metrics server: " << exporter_metrics->get_n_scrapes() << " scrape(s), " << response.size()
+                  << " bytes" << std::endl;
+        if (!met_passed)
+            std::cout << "# " << rang::style::bold << rang::fg::red << "Metrics server check failed :-("
+                      << rang::style::reset << std::endl;
+        tests_passed = tests_passed && met_passed;
+    }
+
     if (tests_passed)
         std::cout << "# " << rang::style::bold << rang::fg::green << "Tests passed!" << rang::style::reset << std::endl;
     else
@@ -3,17 +3,166 @@
 #include <cstdlib>
 #include <fstream>
 #include <getopt.h>
+#ifdef AFF3CT_CORE_HWLOC
 #include <hwloc.h>
+#endif
 #include <iostream>
 #include <memory>
 #include <pthread.h>
 #include <string>
+#include <sys/stat.h>
 #include <vector>
 
 #include <aff3ct-core.hpp>
 using namespace aff3ct;
 using namespace aff3ct::runtime;
 
+// creates the parent directories of 'path' (like 'mkdir -p') and writes 'content' in the file 'path'
+static void
+write_file(const std::string& path, const std::string& content)
+{
+    for (size_t pos = path.find('/', 1); pos != std::string::npos; pos = path.find('/', pos + 1))
+        mkdir(path.substr(0, pos).c_str(), 0755);
+    std::ofstream file(path);
+    file << content << std::endl;
+}
+
+// fake sysfs of a package with 'n_l3' L3 caches of 'n_cores_per_l3' cores and 'n_smt' PUs per core, the SMT
+// siblings of the core 'c' are the PUs 'c', 'c + n_cores', 'c + 2 * n_cores', ... (like on the Intel CPUs)
+static void
+gen_fake_sysfs(const std::string& path, const size_t n_l3, const size_t n_cores_per_l3, const size_t n_smt)
+{
+    const size_t n_cores = n_l3 * n_cores_per_l3;
+    const size_t n_cpus = n_cores * n_smt;
+    write_file(path + "/cpu/online", "0-" + std::to_string(n_cpus - 1));
+    write_file(path + "/node/node0/cpulist", "0-" + std::to_string(n_cpus - 1));
+    for (size_t c = 0; c < n_cpus; c++)
+    {
+        const size_t core = c % n_cores;
+        const size_t l3 = core / n_cores_per_l3;
+        std::string l3_cpus;
+        for (size_t s = 0; s < n_smt; s++)
+            l3_cpus += (s ? "," : "") + std::to_string(s * n_cores + l3 * n_cores_per_l3) + "-" +
+                       std::to_string(s * n_cores + (l3 + 1) * n_cores_per_l3 - 1);
+
+        const std::string cpu = path + "/cpu/cpu" + std::to_string(c);
+        write_file(cpu + "/topology/physical_package_id", "0");
+        write_file(cpu + "/topology/die_id", "0");
+        write_file(cpu + "/topology/core_id", std::to_string(core));
+        write_file(cpu + "/cache/index0/level", "3");
+        write_file(cpu + "/cache/index0/type", "Unified");
+        write_file(cpu + "/cache/index0/shared_cpu_list", l3_cpus);
+    }
+}
+
+// checks the policy generated by 'Thread_pinning_utils::generate_pipeline_policy': one PU per thread, different PUs
+// while there are enough PUs, no PU of the reserved core and no busy-waiting threads on the SMT siblings of the same
+// core while there are enough cores
+static bool
+check_generated_policy(const tools::Thread_pinning_topology& topology,
+                       const std::vector<size_t>& n_threads,
+                       const std::vector<bool>& synchro_active_waiting,
+                       const bool reserve_core)
+{
+    const auto policy =
+      tools::Thread_pinning_utils::generate_pipeline_policy(topology, n_threads, synchro_active_waiting, reserve_core);
+    const auto reserved = tools::Thread_pinning_utils::get_reserved_object(topology, reserve_core);
+    std::cout << "#   - policy = \"" << policy << "\", reserved = \"" << reserved << "\"" << std::endl;
+
+    const size_t n_cores = topology.get_n_objects("CORE");
+    const size_t n_pus = topology.get_n_objects("PU");
+    const std::string expected_reserved = reserve_core && n_cores > 1 ? "CORE_" + std::to_string(n_cores - 1) : "";
+    if (reserved != expected_reserved)
+    {
+        std::cout << "# The reserved object is \"" << reserved << "\" instead of \"" << expected_reserved << "\"."
+                  << std::endl;
+        return false;
+    }
+
+    // core of each PU (logical indexes)
+    std::vector<size_t> core_of(n_pus);
+    for (size_t c = 0; c < n_cores; c++)
+        for (auto os_index : topology.get_cpus("CORE", c))
+            core_of[topology.get_pu_logical_index(os_index)] = c;
+
+    std::vector<size_t> pus;
+    std::vector<bool> is_active;
+    const auto stages = tools::Thread_pinning_utils::pipeline_parser_unpacker(policy, n_threads.size());
+    for (size_t s = 0; s < n_threads.size(); s++)
+    {
+        const bool wait_prev = s > 0 && synchro_active_waiting[s - 1];
+        const bool wait_next = s < synchro_active_waiting.size() && synchro_active_waiting[s];
+        for (auto& thread : tools::Thread_pinning_utils::stage_parser_unpacker(stages[s], n_threads[s]))
+        {
+            const auto objects = tools::Thread_pinning_utils::thread_parser(thread);
+            if (objects.size() != 1 || objects[0].compare(0, 3, "PU_") || std::stoul(objects[0].substr(3)) >= n_pus)
+            {
+                std::cout << "# The thread is not pinned on one PU (\"" << thread << "\")." << std::endl;
+                return false;
+            }
+            pus.push_back(std::stoul(objects[0].substr(3)));
+            is_active.push_back(wait_prev || wait_next);
+        }
+    }
+
+    const size_t n_free_cores = n_cores - (reserved.empty() ? 0 : 1);
+    const size_t n_free_pus = n_pus - (reserved.empty() ? 0 : topology.get_cpus(reserved).size());
+    const size_t n_active = std::count(is_active.begin(), is_active.end(), true);
+    for (size_t t = 0; t < pus.size(); t++)
+    {
+        if (!reserved.empty() && "CORE_" + std::to_string(core_of[pus[t]]) == reserved)
+        {
+            std::cout << "# The thread " << t << " is pinned on the reserved core (PU_" << pus[t] << ")." << std::endl;
+            return false;
+        }
+
+        for (size_t u = 0; u < t; u++)
+        {
+            if (pus.size() <= n_free_pus && pus[u] == pus[t])
+            {
+                std::cout << "# The threads " << u << " and " << t << " share the PU_" << pus[t] << "." << std::endl;
+                return false;
+            }
+            if (pus.size() <= n_free_pus && n_active <= n_free_cores && is_active[u] && is_active[t] &&
+                core_of[pus[u]] == core_of[pus[t]])
+            {
+                std::cout << "# The busy-waiting threads " << u << " and " << t << " are on the SMT siblings of the "
+                          << "CORE_" << core_of[pus[t]] << "." << std::endl;
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// deterministic check of the generated policies on fake topologies (the machine is not used)
+static bool
+check_fake_topologies(const std::string& path)
+{
+    // 2 L3 caches of 4 cores, 2 SMT PUs per core
+    gen_fake_sysfs(path + "/smt", 2, 4, 2);
+    const tools::Thread_pinning_topology smt(path + "/smt", { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+    // a single core with 2 SMT PUs
+    gen_fake_sysfs(path + "/single", 1, 1, 2);
+    const tools::Thread_pinning_topology single(path + "/single", { 0, 1 });
+
+    if (smt.get_n_objects("CORE") != 8 || smt.get_n_objects("PU") != 16 || smt.get_n_objects("L3D") != 2 ||
+        single.get_n_objects("CORE") != 1 || single.get_n_objects("PU") != 2)
+    {
+        std::cout << "# The fake topologies are not read correctly." << std::endl;
+        return false;
+    }
+
+    bool passed = true;
+    passed &= check_generated_policy(smt, { 1, 4, 1 }, { true, false }, true);  // one core per thread
+    passed &= check_generated_policy(smt, { 1, 4, 6 }, { true, false }, true);  // SMT siblings used
+    passed &= check_generated_policy(smt, { 6, 2, 5 }, { false, true }, true);  // busy-waiting next to passive
+    passed &= check_generated_policy(smt, { 4, 4, 4, 4 }, { false, false, false }, false); // all the PUs
+    passed &= check_generated_policy(single, { 1, 1 }, { true }, true);                     // nothing to reserve
+    passed &= check_generated_policy(single, { 1, 1 }, { false }, false);
+    return passed;
+}
+
 int
 main(int argc, char** argv)
 {
@@ -25,6 +174,8 @@ main(int argc, char** argv)
                           { "print-stats", no_argument, NULL, 'p' },
                           { "debug", no_argument, NULL, 'g' },
                           { "active-waiting", no_argument, NULL, 'w' },
+                          { "single-pu", no_argument, NULL, '1' },
+                          { "fake-topology", required_argument, NULL, 't' },
                           { "help", no_argument, NULL, 'h' },
                           { 0 } };
 
@@ -36,10 +187,12 @@ main(int argc, char** argv)
     bool print_stats = false;
     bool debug = false;
     bool active_waiting = false;
+    bool single_pu = false;
+    std::string fake_topology;
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "f:e:o:pgwh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "f:e:o:pgw1t:h", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -61,6 +214,12 @@ main(int argc, char** argv)
             case 'w':
                 active_waiting = true;
                 break;
+            case '1':
+                single_pu = true;
+                break;
+            case 't':
+                fake_topology = std::string(optarg);
+                break;
             case 'h':
                 std::cout << "usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << std::endl;
@@ -82,6 +241,13 @@ main(int argc, char** argv)
                 std::cout << "  -w, --active-waiting  "
                           << "Enable active waiting in the pipeline synchronizations                "
                           << "[" << (active_waiting ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -1, --single-pu       "
+                          << "Pin all the threads on the first PU (instead of 4 PUs)                "
+                          << "[" << (single_pu ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -t, --fake-topology   "
+                          << "Only check the generated policies on fake sysfs trees created here   "
+                          << "[" << (fake_topology.empty() ? "empty" : "\"" + fake_topology + "\"") << "]"
+                          << std::endl;
                 std::cout << "  -h, --help            "
                           << "This help                                                             "
                           << "[false]" << std::endl;
@@ -106,18 +272,44 @@ main(int argc, char** argv)
     std::cout << "#   - print_stats    = " << (print_stats ? "true" : "false") << std::endl;
     std::cout << "#   - debug          = " << (debug ? "true" : "false") << std::endl;
     std::cout << "#   - active_waiting = " << (active_waiting ? "true" : "false") << std::endl;
+    std::cout << "#   - single_pu      = " << (single_pu ? "true" : "false") << std::endl;
+    std::cout << "#   - fake_topology  = " << (fake_topology.empty() ? "[empty]" : fake_topology.c_str()) << std::endl;
     std::cout << "#" << std::endl;
 
+    if (!fake_topology.empty())
+    {
+        const bool tests_passed = check_fake_topologies(fake_topology);
+        if (tests_passed)
+            std::cout << "# " << rang::style::bold << rang::fg::green << "Tests passed!" << rang::style::reset
+                      << std::endl;
+        else
+            std::cout << "# " << rang::style::bold << rang::fg::red << "Tests failed :-(" << rang::style::reset
+                      << std::endl;
+        return !tests_passed;
+    }
+
     tools::Thread_pinning::init();
 
     std::vector<std::shared_ptr<module::Finalizer<uint32_t>>> finalizers(3);
     for (size_t s = 0; s < finalizers.size(); s++)
         finalizers[s].reset(new module::Finalizer<uint32_t>(data_length, n_exec));
 
+#ifdef AFF3CT_CORE_HWLOC
     // Getting hwloc topology
     hwloc_topology_t g_topology;
     hwloc_topology_init(&g_topology);
     hwloc_topology_load(g_topology);
+    const size_t n_pus = (size_t)hwloc_get_nbobjs_by_type(g_topology, HWLOC_OBJ_PU);
+#else
+    // Getting the topology of the native pinning backend (same logical indexes as hwloc)
+    std::shared_ptr<tools::Thread_pinning_topology> g_topology(new tools::Thread_pinning_topology());
+    const size_t n_pus = g_topology->get_n_objects("PU");
+#endif
+    if (!single_pu && n_pus < 4)
+    {
+        std::cout << "# This test requires at least 4 PUs (" << n_pus << " available), skipped." << std::endl;
+        return 77;
+    }
 
     // Stateless module, with a task which forwards the current hardware core of the running thread
     module::Stateless pin_mod;
@@ -129,8 +321,12 @@ main(int argc, char** argv)
                            [sck_val, g_topology](module::Module& m, runtime::Task& t, const size_t frame_id) -> int
                            {
                                auto core = sched_getcpu();
+#ifdef AFF3CT_CORE_HWLOC
                                auto pu_obj = hwloc_get_pu_obj_by_os_index(g_topology, core);
                                *t[sck_val].get_dataptr<uint32_t>() = pu_obj->logical_index;
+#else
+                               *t[sck_val].get_dataptr<uint32_t>() = g_topology->get_pu_logical_index(core);
+#endif
 
                                return runtime::status_t::SUCCESS;
                            });
@@ -178,7 +374,7 @@ main(int argc, char** argv)
         true, // Pinning activation for stage 1
         true, // Pinning activation for stage 2
       },
-      " PU_0 | PU_0; PU_1; PU_2 | PU_3") // explicit thread pinning
+      single_pu ? "PU_0 | PU_0; PU_0; PU_0 | PU_0" : " PU_0 | PU_0; PU_1; PU_2 | PU_3") // explicit thread pinning
     );
     pipeline_chain->set_n_frames(n_inter_frames);
 
@@ -219,34 +415,36 @@ main(int argc, char** argv)
                           << std::endl
                           << "Stage: " << 0 << ", Thread number: " << 0 << std::endl
                           << "Expected: 0, Real: " << finalizers[0]->get_histo_data()[i][f][0] << std::endl;
-#ifndef AFF3CT_CORE_HWLOC
+#if !defined(AFF3CT_CORE_HWLOC) && !defined(AFF3CT_CORE_NATIVE_PINNING)
                 std::cout << "You need to compile with the '-DAFF3CT_CORE_LINK_HWLOC=ON' CMake option!" << std::endl;
 #endif
                 break;
             }
 
-            if (finalizers[1]->get_histo_data()[i][f][0] != (i % 3))
+            if (finalizers[1]->get_histo_data()[i][f][0] != (single_pu ? 0 : (i % 3)))
             {
                 tests_passed = false;
                 std::cout << "# Thread is not pin to expected value for the stream n°" << i << " and fra n°" << f
                           << std::endl
                           << "Stage: " << 1 << ", Thread number: " << (i % 3) << std::endl
-                          << "Expected: " << (i % 3) << ", Real: " << finalizers[1]->get_histo_data()[i][f][0]
+                          << "Expected: " << (single_pu ? 0 : (i % 3))
+                          << ", Real: " << finalizers[1]->get_histo_data()[i][f][0]
                           << std::endl;
-#ifndef AFF3CT_CORE_HWLOC
+#if !defined(AFF3CT_CORE_HWLOC) && !defined(AFF3CT_CORE_NATIVE_PINNING)
                 std::cout << "You need to compile with the '-DAFF3CT_CORE_LINK_HWLOC=ON' CMake option!" << std::endl;
 #endif
                 break;
             }
 
-            if (finalizers[2]->get_histo_data()[i][f][0] != 3)
+            if (finalizers[2]->get_histo_data()[i][f][0] != (single_pu ? 0 : 3))
             {
                 tests_passed = false;
                 std::cout << "# Thread is not pin to expected value for the stream n°" << i << " and fra n°" << f
                           << std::endl
                           << "Stage: " << 2 << ", Thread number: " << 0 << std::endl
-                          << "Expected: 3, Real: " << finalizers[2]->get_histo_data()[i][f][0] << std::endl;
-#ifndef AFF3CT_CORE_HWLOC
+                          << "Expected: " << (single_pu ? 0 : 3)
+                          << ", Real: " << finalizers[2]->get_histo_data()[i][f][0] << std::endl;
+#if !defined(AFF3CT_CORE_HWLOC) && !defined(AFF3CT_CORE_NATIVE_PINNING)
                 std::cout << "You need to compile with the '-DAFF3CT_CORE_LINK_HWLOC=ON' CMake option!" << std::endl;
 #endif
                 break;
@@ -26,6 +26,7 @@ main(int argc, char** argv)
                           { "step-by-step", no_argument, NULL, 'b' },
                           { "debug", no_argument, NULL, 'g' },
                           { "cyclic-path", no_argument, NULL, 'y' },
+                          { "fwd-paths", no_argument, NULL, 'r' },
                           { "help", no_argument, NULL, 'h' },
                           { 0 } };
 
@@ -41,10 +42,11 @@ main(int argc, char** argv)
     bool step_by_step = false;
     bool debug = false;
     bool cyclic_path = false;
+    bool fwd_paths = false;
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "t:f:s:d:e:a:o:cpbgyh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "t:f:s:d:e:a:o:cpbgyrh", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -84,6 +86,9 @@ main(int argc, char** argv)
             case 'y':
                 cyclic_path = true;
                 break;
+            case 'r':
+                fwd_paths = true;
+                break;
             case 'h':
                 std::cout << "usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << std::endl;
@@ -123,6 +128,9 @@ main(int argc, char** argv)
                 std::cout << "  -y, --cyclic-path     "
                           << "Enable cyclic selection of the path (with this `--path` is ignored)   "
                           << "[" << (cyclic_path ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -r, --fwd-paths       "
+                          << "Use forward sockets (SFWD) in the paths of the switch                 "
+                          << "[" << (fwd_paths ? "true" : "false") << "]" << std::endl;
                 std::cout << "  -h, --help            "
                           << "This help                                                             "
                           << "[false]" << std::endl;
@@ -151,6 +159,7 @@ main(int argc, char** argv)
     std::cout << "#   - step_by_step   = " << (step_by_step ? "true" : "false") << std::endl;
     std::cout << "#   - debug          = " << (debug ? "true" : "false") << std::endl;
     std::cout << "#   - cyclic_path    = " << (cyclic_path ? "true" : "false") << std::endl;
+    std::cout << "#   - fwd_paths      = " << (fwd_paths ? "true" : "false") << std::endl;
     std::cout << "#" << std::endl;
 
     if (path >= 3)
@@ -189,18 +198,37 @@ main(int argc, char** argv)
     controller(  "control"          ) = initializer["initialize::out"      ];
     switchex  [  "commute::in_data" ] = initializer["initialize::out"      ];
     switchex  [  "commute::in_ctrl" ] = controller [   "control::out"      ];
-    // path 0
-    (*incs[0])["increment::in"      ] = switchex   [   "commute::out_data0"];
-    (*incs[1])["increment::in"      ] = (*incs[0]) [ "increment::out"      ];
-    (*incs[2])["increment::in"      ] = (*incs[1]) [ "increment::out"      ];
-    switchex  [   "select::in_data0"] = (*incs[2]) [ "increment::out"      ];
-    // path 1
-    (*incs[3])["increment::in"      ] = switchex   [   "commute::out_data1"];
-    (*incs[4])["increment::in"      ] = (*incs[3]) [ "increment::out"      ];
-    switchex  [   "select::in_data1"] = (*incs[4]) [ "increment::out"      ];
-    // path 2
-    (*incs[5])["increment::in"      ] = switchex   [   "commute::out_data2"];
-    switchex  [   "select::in_data2"] = (*incs[5]) [ "increment::out"      ];
+    if (!fwd_paths)
+    {
+        // path 0
+        (*incs[0])["increment::in"      ] = switchex   [   "commute::out_data0"];
+        (*incs[1])["increment::in"      ] = (*incs[0]) [ "increment::out"      ];
+        (*incs[2])["increment::in"      ] = (*incs[1]) [ "increment::out"      ];
+        switchex  [   "select::in_data0"] = (*incs[2]) [ "increment::out"      ];
+        // path 1
+        (*incs[3])["increment::in"      ] = switchex   [   "commute::out_data1"];
+        (*incs[4])["increment::in"      ] = (*incs[3]) [ "increment::out"      ];
+        switchex  [   "select::in_data1"] = (*incs[4]) [ "increment::out"      ];
+        // path 2
+        (*incs[5])["increment::in"      ] = switchex   [   "commute::out_data2"];
+        switchex  [   "select::in_data2"] = (*incs[5]) [ "increment::out"      ];
+    }
+    else
+    {
+        // the data are incremented in place along the paths
+        // path 0
+        (*incs[0])["incrementf::fwd"    ] = switchex   [   "commute::out_data0"];
+        (*incs[1])["incrementf::fwd"    ] = (*incs[0]) [ "incrementf::fwd"     ];
+        (*incs[2])["incrementf::fwd"    ] = (*incs[1]) [ "incrementf::fwd"     ];
+        switchex  [   "select::in_data0"] = (*incs[2]) [ "incrementf::fwd"     ];
+        // path 1
+        (*incs[3])["incrementf::fwd"    ] = switchex   [   "commute::out_data1"];
+        (*incs[4])["incrementf::fwd"    ] = (*incs[3]) [ "incrementf::fwd"     ];
+        switchex  [   "select::in_data1"] = (*incs[4]) [ "incrementf::fwd"     ];
+        // path 2
+        (*incs[5])["incrementf::fwd"    ] = switchex   [   "commute::out_data2"];
+        switchex  [   "select::in_data2"] = (*incs[5]) [ "incrementf::fwd"     ];
+    }
     // end
     finalizer [ "finalize::in"      ] = switchex   [    "select::out_data" ];
     // clang-format on
@@ -312,15 +340,30 @@ main(int argc, char** argv)
     controller[module::ctr::tsk::control      ].unbind(initializer[module::ini::sck::initialize::out]);
     switchex  [module::swi::tsk::commute   ][0].unbind(initializer[module::ini::sck::initialize::out]);
     switchex  [module::swi::tsk::commute   ][1].unbind(controller [module::ctr::sck::control   ::out]);
-    (*incs[0])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][2]);
-    (*incs[1])[module::inc::sck::increment::in].unbind((*incs[0]) [module::inc::sck::increment ::out]);
-    (*incs[2])[module::inc::sck::increment::in].unbind((*incs[1]) [module::inc::sck::increment ::out]);
-    switchex  [module::swi::tsk::select    ][0].unbind((*incs[2]) [module::inc::sck::increment ::out]);
-    (*incs[3])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][3]);
-    (*incs[4])[module::inc::sck::increment::in].unbind((*incs[3]) [module::inc::sck::increment ::out]);
-    switchex  [module::swi::tsk::select    ][1].unbind((*incs[4]) [module::inc::sck::increment ::out]);
-    (*incs[5])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][4]);
-    switchex  [module::swi::tsk::select    ][2].unbind((*incs[5]) [module::inc::sck::increment ::out]);
+    if (!fwd_paths)
+    {
+        (*incs[0])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][2]);
+        (*incs[1])[module::inc::sck::increment::in].unbind((*incs[0]) [module::inc::sck::increment ::out]);
+        (*incs[2])[module::inc::sck::increment::in].unbind((*incs[1]) [module::inc::sck::increment ::out]);
+        switchex  [module::swi::tsk::select    ][0].unbind((*incs[2]) [module::inc::sck::increment ::out]);
+        (*incs[3])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][3]);
+        (*incs[4])[module::inc::sck::increment::in].unbind((*incs[3]) [module::inc::sck::increment ::out]);
+        switchex  [module::swi::tsk::select    ][1].unbind((*incs[4]) [module::inc::sck::increment ::out]);
+        (*incs[5])[module::inc::sck::increment::in].unbind(switchex   [module::swi::tsk::commute     ][4]);
+        switchex  [module::swi::tsk::select    ][2].unbind((*incs[5]) [module::inc::sck::increment ::out]);
+    }
+    else
+    {
+        (*incs[0])[module::inc::sck::incrementf::fwd].unbind(switchex   [module::swi::tsk::commute     ][2]);
+        (*incs[1])[module::inc::sck::incrementf::fwd].unbind((*incs[0]) [module::inc::sck::incrementf::fwd]);
+        (*incs[2])[module::inc::sck::incrementf::fwd].unbind((*incs[1]) [module::inc::sck::incrementf::fwd]);
+        switchex  [module::swi::tsk::select      ][0].unbind((*incs[2]) [module::inc::sck::incrementf::fwd]);
+        (*incs[3])[module::inc::sck::incrementf::fwd].unbind(switchex   [module::swi::tsk::commute     ][3]);
+        (*incs[4])[module::inc::sck::incrementf::fwd].unbind((*incs[3]) [module::inc::sck::incrementf::fwd]);
+        switchex  [module::swi::tsk::select      ][1].unbind((*incs[4]) [module::inc::sck::incrementf::fwd]);
+        (*incs[5])[module::inc::sck::incrementf::fwd].unbind(switchex   [module::swi::tsk::commute     ][4]);
+        switchex  [module::swi::tsk::select      ][2].unbind((*incs[5]) [module::inc::sck::incrementf::fwd]);
+    }
     finalizer [module::fin::sck::finalize ::in].unbind(switchex   [module::swi::tsk::select      ][3]);
     // clang-format on
 
@@ -1,14 +1,47 @@
+#include <algorithm>
 #include <atomic>
 #include <cstdlib>
 #include <getopt.h>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <aff3ct-core.hpp>
 using namespace aff3ct;
 
+// incrementer that overrides the hook of the regular codelet: the sequence must not fuse it with the element-wise
+// codelet of its base class
+class Incrementer_hooked : public module::Incrementer<uint8_t>
+{
+  protected:
+    std::shared_ptr<std::atomic<size_t>> n_hook_calls; // shared by the clones
+
+  public:
+    explicit Incrementer_hooked(const size_t n_elmts)
+      : module::Incrementer<uint8_t>(n_elmts)
+      , n_hook_calls(new std::atomic<size_t>(0))
+    {
+    }
+
+    virtual Incrementer_hooked* clone() const
+    {
+        auto m = new Incrementer_hooked(*this);
+        m->deep_copy(*this);
+        return m;
+    }
+
+    size_t get_n_hook_calls() const { return *this->n_hook_calls; }
+
+  protected:
+    virtual void _increment(const uint8_t* in, uint8_t* out, const size_t frame_id)
+    {
+        (*this->n_hook_calls)++;
+        module::Incrementer<uint8_t>::_increment(in, out, frame_id);
+    }
+};
+
 int
 main(int argc, char** argv)
 {
@@ -25,7 +58,11 @@ main(int argc, char** argv)
                           { "step-by-step", no_argument, NULL, 'b' },
                           { "debug", no_argument, NULL, 'g' },
                           { "set", no_argument, NULL, 'u' },
+                          { "sub-waves", required_argument, NULL, 'w' },
+                          { "fusion", required_argument, NULL, 'z' },
                           { "verbose", no_argument, NULL, 'v' },
+                          { "async", no_argument, NULL, 'a' },
+                          { "executor", no_argument, NULL, 'x' },
                           { "help", no_argument, NULL, 'h' },
                           { 0 } };
 
@@ -40,11 +77,17 @@ main(int argc, char** argv)
     bool step_by_step = false;
     bool debug = false;
     bool set = false;
+    bool sub_waves = false;
+    size_t n_frames_per_sub_wave = 0;
+    bool fusion = false;
+    size_t fusion_chunk_size = 1024;
     bool verbose = false;
+    bool async = false;
+    bool executor = false;
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "t:f:s:d:e:o:cpbguvh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "t:f:s:d:e:o:cpbguw:z:vaxh", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -81,9 +124,23 @@ main(int argc, char** argv)
             case 'u':
                 set = true;
                 break;
+            case 'w':
+                sub_waves = true;
+                n_frames_per_sub_wave = atoi(optarg);
+                break;
+            case 'z':
+                fusion = true;
+                fusion_chunk_size = atoi(optarg);
+                break;
             case 'v':
                 verbose = true;
                 break;
+            case 'a':
+                async = true;
+                break;
+            case 'x':
+                executor = true;
+                break;
             case 'h':
                 std::cout << "usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << std::endl;
@@ -120,9 +177,22 @@ main(int argc, char** argv)
                 std::cout << "  -u, --set          "
                           << "Enable set in the executed sequence                                   "
                           << "[" << (set ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -w, --sub-waves       "
+                          << "Enable sub-waves interleaving with the given size (0 = auto)          "
+                          << "[" << (sub_waves ? std::to_string(n_frames_per_sub_wave) : "disabled") << "]"
+                          << std::endl;
+                std::cout << "  -z, --fusion          "
+                          << "Enable tasks fusion with chunks of the given number of elements       "
+                          << "[" << (fusion ? std::to_string(fusion_chunk_size) : "disabled") << "]" << std::endl;
                 std::cout << "  -v, --verbose         "
                           << "Enable verbose mode                                                   "
                           << "[" << (verbose ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -a, --async           "
+                          << "Execute the sequence asynchronously (the main thread requests the stop)"
+                          << "[" << (async ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -x, --executor        "
+                          << "Execute the sequence on a shared executor with a background sequence "
+                          << "[" << (executor ? "true" : "false") << "]" << std::endl;
                 std::cout << "  -h, --help            "
                           << "This help                                                             "
                           << "[false]" << std::endl;
@@ -150,7 +220,12 @@ main(int argc, char** argv)
     std::cout << "#   - step_by_step   = " << (step_by_step ? "true" : "false") << std::endl;
     std::cout << "#   - debug          = " << (debug ? "true" : "false") << std::endl;
     std::cout << "#   - set            = " << (set ? "true" : "false") << std::endl;
+    std::cout << "#   - sub_waves      = " << (sub_waves ? std::to_string(n_frames_per_sub_wave) : "disabled")
+              << std::endl;
+    std::cout << "#   - fusion         = " << (fusion ? std::to_string(fusion_chunk_size) : "disabled") << std::endl;
     std::cout << "#   - verbose        = " << (verbose ? "true" : "false") << std::endl;
+    std::cout << "#   - async          = " << (async ? "true" : "false") << std::endl;
+    std::cout << "#   - executor       = " << (executor ? "true" : "false") << std::endl;
     std::cout << "#" << std::endl;
 
     // modules creation
@@ -160,11 +235,25 @@ main(int argc, char** argv)
     std::vector<std::shared_ptr<module::Incrementer<uint8_t>>> incs(6);
     for (size_t s = 0; s < incs.size(); s++)
     {
-        incs[s].reset(new module::Incrementer<uint8_t>(data_length));
+        // with the fusion, the second incrementer overrides the hook of its regular codelet
+        if (fusion && s == 1)
+            incs[s].reset(new Incrementer_hooked(data_length));
+        else
+            incs[s].reset(new module::Incrementer<uint8_t>(data_length));
         incs[s]->set_ns(sleep_time_us * 1000);
         incs[s]->set_custom_name("Inc" + std::to_string(s));
     }
 
+    // with the sub-waves, this task stops at its first wave: its next waves are skipped but the call is still counted
+    module::Stateless stopper;
+    stopper.set_name("Stopper");
+    stopper.set_short_name("Stopper");
+    auto& stp_task = stopper.create_task("stop");
+    stopper.create_socket_fwd<uint8_t>(stp_task, "fwd", data_length);
+    stopper.create_codelet(stp_task,
+                           [](module::Module& /*m*/, runtime::Task& /*t*/, const size_t /*frame_id*/) -> int
+                           { return runtime::status_t::FAILURE_STOP; });
+
     std::shared_ptr<runtime::Sequence> partial_sequence;
     std::shared_ptr<module::Set> aset;
 
@@ -174,7 +263,13 @@ main(int argc, char** argv)
         (*incs[0])["increment::in"] = initializer["initialize::out"];
         for (size_t s = 0; s < incs.size() - 1; s++)
             (*incs[s + 1])["increment::in"] = (*incs[s])["increment::out"];
-        finalizer["finalize::in"] = (*incs[incs.size() - 1])["increment::out"];
+        if (sub_waves)
+        {
+            stopper["stop::fwd"] = (*incs[incs.size() - 1])["increment::out"];
+            finalizer["finalize::in"] = stopper["stop::fwd"];
+        }
+        else
+            finalizer["finalize::in"] = (*incs[incs.size() - 1])["increment::out"];
     }
     else
     {
@@ -189,6 +284,8 @@ main(int argc, char** argv)
     runtime::Sequence sequence_chain(initializer("initialize"), n_threads);
     sequence_chain.set_n_frames(n_inter_frames);
     sequence_chain.set_no_copy_mode(no_copy_mode);
+    if (sub_waves) sequence_chain.set_sub_waves(true, n_frames_per_sub_wave);
+    if (fusion) sequence_chain.set_fusion(true, fusion_chunk_size);
 
     auto tid = 0;
     for (auto cur_initializer : sequence_chain.get_cloned_modules<module::Initializer<uint8_t>>(initializer))
@@ -228,12 +325,100 @@ main(int argc, char** argv)
         aff3ct::tools::help(finalizer);
     }
 
+    // background sequence sharing the workers of the executor with a lower priority
+    module::Initializer<uint8_t> bg_initializer(data_length);
+    module::Incrementer<uint8_t> bg_incrementer(data_length);
+    module::Finalizer<uint8_t> bg_finalizer(data_length);
+    bg_incrementer.set_ns(sleep_time_us * 1000);
+    bg_incrementer["increment::in"] = bg_initializer["initialize::out"];
+    bg_finalizer["finalize::in"] = bg_incrementer["increment::out"];
+    runtime::Sequence bg_sequence(bg_initializer("initialize"), n_threads);
+    bg_sequence.set_n_frames(n_inter_frames);
+    std::atomic<unsigned int> bg_counter(0);
+    std::atomic<unsigned int> bg_before_end(0);
+
+    // same chain as the background sequence, executed with a three times bigger share after the high priority sequence
+    module::Initializer<uint8_t> sh_initializer(data_length);
+    module::Incrementer<uint8_t> sh_incrementer(data_length);
+    module::Finalizer<uint8_t> sh_finalizer(data_length);
+    sh_incrementer.set_ns(sleep_time_us * 1000);
+    sh_incrementer["increment::in"] = sh_initializer["initialize::out"];
+    sh_finalizer["finalize::in"] = sh_incrementer["increment::out"];
+    runtime::Sequence sh_sequence(sh_initializer("initialize"), n_threads);
+    sh_sequence.set_n_frames(n_inter_frames);
+    const unsigned int sh_share = 3;
+    const unsigned int sh_n_exec = 40 * sh_share * n_threads;
+    std::atomic<unsigned int> sh_counter(0);
+    unsigned int bg_sh_start = 0, bg_sh_end = 0;
+
     std::atomic<unsigned int> counter(0);
+    bool async_done = false;
     auto t_start = std::chrono::steady_clock::now();
     if (!step_by_step)
     {
         // execute the sequence (multi-threaded)
-        sequence_chain.exec([&counter, n_exec]() { return ++counter >= n_exec; });
+        if (executor)
+        {
+            // the handle of the background sequence outlives the executor: its destructor stops the sequence
+            runtime::Exec_handle bg_handle;
+            {
+                // as many workers as the replicas of the sequence: the background sequence can only be executed when
+                // a replica of the high priority sequence is over (the stop condition of the sequence returned true)
+                runtime::Executor pool(n_threads);
+                auto handle = pool.submit(sequence_chain, 1, 1, [&counter, n_exec]() { return ++counter >= n_exec; });
+                bg_handle = pool.submit(bg_sequence,
+                                        0,
+                                        1,
+                                        [&bg_counter, &bg_before_end, &counter, n_exec]()
+                                        {
+                                            if (counter < n_exec) bg_before_end++;
+                                            bg_counter++;
+                                            return false;
+                                        });
+                handle.wait();
+
+                // the same chain with the same priority and a three times bigger share is executed three times more
+                bg_sh_start = bg_counter;
+                auto sh_handle = pool.submit(sh_sequence,
+                                             0,
+                                             sh_share,
+                                             [&sh_counter, &bg_counter, &bg_sh_end, sh_n_exec]()
+                                             {
+                                                 if (++sh_counter == sh_n_exec) bg_sh_end = bg_counter;
+                                                 return sh_counter >= sh_n_exec;
+                                             });
+                sh_handle.wait();
+            }
+            bg_handle.wait();
+            std::cout << "# Number of executions of the background sequence: " << bg_counter << std::endl;
+        }
+        else if (!async)
+            sequence_chain.exec([&counter, n_exec]() { return ++counter >= n_exec; });
+        else
+        {
+            // the main thread is not blocked during the execution, it requests the stop after 'n_exec' executions:
+            // from the 'n_exec'-th execution, each replica waits in its stop condition, the stop is requested when
+            // all the replicas wait, so each replica ends with exactly one execution after the 'n_exec - 1' first ones
+            std::atomic<size_t> n_waiting(0);
+            std::atomic<bool> stopped(false);
+            auto handle = sequence_chain.exec_async(
+              [&counter, &n_waiting, &stopped, n_exec]()
+              {
+                  if (++counter < n_exec) return false;
+                  n_waiting++;
+                  while (!stopped)
+                      std::this_thread::yield();
+                  return false;
+              });
+            while (!handle.wait_for(std::chrono::microseconds(100)))
+                if (n_waiting == n_threads && !stopped)
+                {
+                    handle.request_stop();
+                    stopped = true;
+                }
+            handle.wait();
+            async_done = handle.is_done() && !handle.valid();
+        }
     }
     else
     {
@@ -278,6 +463,69 @@ main(int argc, char** argv)
         }
         tid++;
     }
+    // the executions are exactly the calls of the stop condition (see above)
+    if (async && !executor && !step_by_step)
+    {
+        size_t n_calls = 0;
+        for (auto cur_finalizer : sequence_chain.get_cloned_modules<module::Finalizer<uint8_t>>(finalizer))
+            n_calls += (*cur_finalizer)("finalize").get_n_calls();
+        if (counter != n_exec + n_threads - 1 || n_calls != counter || !async_done)
+        {
+            std::cout << "# The asynchronous execution is wrong (expected executions = " << n_exec + n_threads - 1
+                      << ", stop condition calls = " << counter << ", finalizer calls = " << n_calls
+                      << ", done after wait = " << (async_done ? "true" : "false") << ")." << std::endl;
+            tests_passed = false;
+        }
+    }
+    // the overridden hook is called for each wave of each call: the incrementer has not been fused
+    if (fusion && !set)
+    {
+        size_t n_waves = 0;
+        for (auto cur_inc : sequence_chain.get_cloned_modules<module::Incrementer<uint8_t>>(*incs[1]))
+            n_waves += (*cur_inc)("increment").get_n_calls() * cur_inc->get_n_waves();
+        const auto n_hook_calls = static_cast<Incrementer_hooked&>(*incs[1]).get_n_hook_calls();
+        if (n_hook_calls != n_waves || n_waves == 0)
+        {
+            std::cout << "# The hook of the derived incrementer has been bypassed (hook calls = " << n_hook_calls
+                      << ", expected = " << n_waves << ")." << std::endl;
+            tests_passed = false;
+        }
+    }
+    // the stopped task is called once per execution of the sequence, like the finalizer
+    if (sub_waves && !set)
+    {
+        size_t n_calls_stp = 0, n_calls_fin = 0;
+        for (auto cur_stopper : sequence_chain.get_cloned_modules<module::Stateless>(stopper))
+            n_calls_stp += (*cur_stopper)("stop").get_n_calls();
+        for (auto cur_finalizer : sequence_chain.get_cloned_modules<module::Finalizer<uint8_t>>(finalizer))
+            n_calls_fin += (*cur_finalizer)("finalize").get_n_calls();
+        if (n_calls_stp != n_calls_fin || n_calls_fin == 0)
+        {
+            std::cout << "# The stopped task is not counted once per execution (stopper calls = " << n_calls_stp
+                      << ", finalizer calls = " << n_calls_fin << ")." << std::endl;
+            tests_passed = false;
+        }
+    }
+    // the background sequence has been executed after the high priority sequence, and three times less than the
+    // sequence with a three times bigger share
+    if (executor && !step_by_step)
+    {
+        const double ratio = (double)sh_n_exec / (double)std::max(1u, bg_sh_end - bg_sh_start);
+        std::cout << "# Executions of the background sequence during the shared execution: " << bg_sh_end - bg_sh_start
+                  << " (ratio = " << ratio << ", expected = " << sh_share << ")" << std::endl;
+        if (bg_counter == 0 || bg_before_end != 0)
+        {
+            std::cout << "# The background sequence has been executed before the end of the high priority sequence ("
+                      << bg_before_end << " executions over " << bg_counter << ")." << std::endl;
+            tests_passed = false;
+        }
+        // the time of an iteration is the time of the chain only if each worker has its own core
+        if (std::thread::hardware_concurrency() >= n_threads && (ratio < sh_share * 0.5 || ratio > sh_share * 2.0))
+        {
+            std::cout << "# The workers are not shared in proportion of the shares." << std::endl;
+            tests_passed = false;
+        }
+    }
 
     if (tests_passed)
         std::cout << "# " << rang::style::bold << rang::fg::green << "Tests passed!" << rang::style::reset << std::endl;
@@ -301,7 +549,14 @@ main(int argc, char** argv)
         (*incs[0])[module::inc::sck::increment::in].unbind(initializer[module::ini::sck::initialize::out]);
         for (size_t s = 0; s < incs.size() - 1; s++)
             (*incs[s + 1])[module::inc::sck::increment::in].unbind((*incs[s])[module::inc::sck::increment::out]);
-        finalizer[module::fin::sck::finalize::in].unbind((*incs[incs.size() - 1])[module::inc::sck::increment::out]);
+        if (sub_waves)
+        {
+            finalizer[module::fin::sck::finalize::in].unbind(stopper["stop::fwd"]);
+            stopper["stop::fwd"].unbind((*incs[incs.size() - 1])[module::inc::sck::increment::out]);
+        }
+        else
+            finalizer[module::fin::sck::finalize::in].unbind(
+              (*incs[incs.size() - 1])[module::inc::sck::increment::out]);
     }
     else
     {
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <atomic>
+#include <climits>
 #include <cstdlib>
 #include <fstream>
 #include <getopt.h>
@@ -36,6 +37,26 @@ compare_files(const std::string& filename1, const std::string& filename2)
     return std::equal(begin1, std::istreambuf_iterator<char>(), begin2); // Second argument is end-of-range iterator
 }
 
+// true if the output file is made of frames of the input file in the same order (some frames can be missing), the
+// frames are 'frame_size' bytes long (except the last frame of the input file)
+bool
+is_frames_subsequence(const std::string& in_filename, const std::string& out_filename, const size_t frame_size)
+{
+    std::ifstream in_file(in_filename, std::ifstream::binary);
+    std::ifstream out_file(out_filename, std::ifstream::binary);
+    const std::string in_data((std::istreambuf_iterator<char>(in_file)), std::istreambuf_iterator<char>());
+    const std::string out_data((std::istreambuf_iterator<char>(out_file)), std::istreambuf_iterator<char>());
+
+    size_t out_pos = 0;
+    for (size_t in_pos = 0; in_pos < in_data.size() && out_pos < out_data.size(); in_pos += frame_size)
+    {
+        const size_t size = std::min(frame_size, in_data.size() - in_pos);
+        if (out_pos + size <= out_data.size() && !out_data.compare(out_pos, size, in_data, in_pos, size))
+            out_pos += size;
+    }
+    return out_pos == out_data.size();
+}
+
 int
 main(int argc, char** argv)
 {
@@ -55,6 +76,16 @@ main(int argc, char** argv)
                           { "debug", no_argument, NULL, 'g' },
                           { "force-sequence", no_argument, NULL, 'q' },
                           { "active-waiting", no_argument, NULL, 'w' },
+                          { "n-replicas", required_argument, NULL, 'r' },
+                          { "batch-size", required_argument, NULL, 'k' },
+                          { "batch-latency", required_argument, NULL, 'l' },
+                          { "track-latency", no_argument, NULL, 'e' },
+                          { "synchro-telemetry", no_argument, NULL, 'y' },
+                          { "analysis", no_argument, NULL, 'a' },
+                          { "profile", no_argument, NULL, 'z' },
+                          { "async", no_argument, NULL, 'x' },
+                          { "deadline", required_argument, NULL, 'm' },
+                          { "sub-waves", no_argument, NULL, 'v' },
                           { "help", no_argument, NULL, 'h' },
                           { 0 } };
 
@@ -72,10 +103,20 @@ main(int argc, char** argv)
     bool debug = false;
     bool force_sequence = false;
     bool active_waiting = false;
+    size_t n_replicas = 0;
+    size_t batch_size = 1;
+    size_t batch_latency_us = 0;
+    bool latency_tracking = false;
+    bool synchro_telemetry = false;
+    bool analysis = false;
+    bool profile = false;
+    bool async = false;
+    size_t deadline_us = 0;
+    bool sub_waves = false;
 
     while (1)
     {
-        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:cpbgqwh", longopts, 0);
+        const int opt = getopt_long(argc, argv, "t:f:s:d:u:o:i:j:r:k:l:m:cpbgqweyazxvh", longopts, 0);
         if (opt == -1) break;
         switch (opt)
         {
@@ -121,6 +162,36 @@ main(int argc, char** argv)
             case 'q':
                 force_sequence = true;
                 break;
+            case 'r':
+                n_replicas = atoi(optarg);
+                break;
+            case 'k':
+                batch_size = atoi(optarg);
+                break;
+            case 'l':
+                batch_latency_us = atoi(optarg);
+                break;
+            case 'e':
+                latency_tracking = true;
+                break;
+            case 'y':
+                synchro_telemetry = true;
+                break;
+            case 'a':
+                analysis = true;
+                break;
+            case 'z':
+                profile = true;
+                break;
+            case 'x':
+                async = true;
+                break;
+            case 'm':
+                deadline_us = atoi(optarg);
+                break;
+            case 'v':
+                sub_waves = true;
+                break;
             case 'h':
                 std::cout << "usage: " << argv[0] << " [options]" << std::endl;
                 std::cout << std::endl;
@@ -166,6 +237,36 @@ main(int argc, char** argv)
                 std::cout << "  -w, --active-waiting  "
                           << "Enable active waiting in the pipeline synchronizations                "
                           << "[" << (active_waiting ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -r, --n-replicas      "
+                          << "Number of active replicas in stage 1 for the first half of the frames "
+                          << "[" << (n_replicas ? std::to_string(n_replicas) : "disabled") << "]" << std::endl;
+                std::cout << "  -k, --batch-size      "
+                          << "Number of frames pushed/pulled at once between the stages             "
+                          << "[" << batch_size << "]" << std::endl;
+                std::cout << "  -l, --batch-latency   "
+                          << "Max time before to publish an uncompleted batch (us, 0 = no bound)    "
+                          << "[" << batch_latency_us << "]" << std::endl;
+                std::cout << "  -e, --track-latency   "
+                          << "Enable to track the end-to-end latency of the frames in the pipeline  "
+                          << "[" << (latency_tracking ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -y, --synchro-telemetry "
+                          << "Enable the occupancy and stall telemetry of the synchronizations    "
+                          << "[" << (synchro_telemetry ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -a, --analysis        "
+                          << "Enable the end-of-run analysis of the pipeline (throughput, bottleneck)"
+                          << "[" << (analysis ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -z, --profile         "
+                          << "Enable the sampling profiler of the tasks executed by the threads     "
+                          << "[" << (profile ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -x, --async           "
+                          << "Execute the pipeline asynchronously (the main thread polls its end)   "
+                          << "[" << (async ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -m, --deadline        "
+                          << "Deadline of the frames in us, the late frames are dropped (0 = none) "
+                          << "[" << deadline_us << "]" << std::endl;
+                std::cout << "  -v, --sub-waves       "
+                          << "Enable the sub-waves in stage 1 between the two executions of '-r'    "
+                          << "[" << (sub_waves ? "true" : "false") << "]" << std::endl;
                 std::cout << "  -h, --help            "
                           << "This help                                                             "
                           << "[false]" << std::endl;
@@ -196,6 +297,17 @@ main(int argc, char** argv)
     std::cout << "#   - debug          = " << (debug ? "true" : "false") << std::endl;
     std::cout << "#   - force_sequence = " << (force_sequence ? "true" : "false") << std::endl;
     std::cout << "#   - active_waiting = " << (active_waiting ? "true" : "false") << std::endl;
+    std::cout << "#   - n_replicas     = " << (n_replicas ? std::to_string(n_replicas) : "disabled") << std::endl;
+    std::cout << "#   - batch_size     = " << batch_size << std::endl;
+    std::cout << "#   - batch_latency  = " << batch_latency_us << " us" << std::endl;
+    std::cout << "#   - latency_track. = " << (latency_tracking ? "true" : "false") << std::endl;
+    std::cout << "#   - synchro_tlm.   = " << (synchro_telemetry ? "true" : "false") << std::endl;
+    std::cout << "#   - analysis       = " << (analysis ? "true" : "false") << std::endl;
+    std::cout << "#   - profile        = " << (profile ? "true" : "false") << std::endl;
+    std::cout << "#   - async          = " << (async ? "true" : "false") << std::endl;
+    std::cout << "#   - deadline       = " << (deadline_us ? std::to_string(deadline_us) + " us" : "disabled")
+              << std::endl;
+    std::cout << "#   - sub_waves      = " << (sub_waves ? "true" : "false") << std::endl;
     std::cout << "#" << std::endl;
 
     if (!force_sequence && !no_copy_mode)
@@ -229,6 +341,7 @@ main(int argc, char** argv)
 
     std::unique_ptr<runtime::Sequence> sequence_chain;
     std::unique_ptr<runtime::Pipeline> pipeline_chain;
+    std::unique_ptr<tools::Profiler> profiler;
     if (force_sequence)
     {
         sequence_chain.reset(new runtime::Sequence(source("generate"), n_threads));
@@ -252,6 +365,12 @@ main(int argc, char** argv)
                 tsk->set_fast(true);         // enable the fast mode (= disable the useless verifs in the tasks)
             }
 
+        if (profile)
+        {
+            profiler.reset(new tools::Profiler(*sequence_chain));
+            profiler->start(std::chrono::microseconds(100));
+        }
+
         auto t_start = std::chrono::steady_clock::now();
         if (!step_by_step)
             sequence_chain->exec();
@@ -271,6 +390,7 @@ main(int argc, char** argv)
             } while (!source.is_done());
         }
         std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+        if (profile) profiler->stop();
 
         auto elapsed_time = duration.count() / 1000.f / 1000.f;
         std::cout << "Sequence elapsed time: " << elapsed_time << " ms" << std::endl;
@@ -301,6 +421,10 @@ main(int argc, char** argv)
             active_waiting, // type of waiting between stages 1 and 2 (true = active, false = passive)
           }));
         pipeline_chain->set_n_frames(n_inter_frames);
+        pipeline_chain->set_synchro_batch(batch_size, std::chrono::microseconds(batch_latency_us));
+        pipeline_chain->set_latency_tracking(latency_tracking);
+        pipeline_chain->set_synchro_telemetry(synchro_telemetry);
+        pipeline_chain->set_deadline(std::chrono::microseconds(deadline_us));
 
         if (!dot_filepath.empty())
         {
@@ -313,15 +437,48 @@ main(int argc, char** argv)
             for (auto& tsk : mod->tasks)
             {
                 tsk->reset();
-                tsk->set_debug(debug);       // disable the debug mode
-                tsk->set_debug_limit(16);    // display only the 16 first bits if the debug mode is enabled
-                tsk->set_stats(print_stats); // enable the statistics
-                tsk->set_fast(true);         // enable the fast mode (= disable the useless verifs in the tasks)
+                tsk->set_debug(debug);                   // disable the debug mode
+                tsk->set_debug_limit(16);                // display only the 16 first bits if the debug mode is enabled
+                tsk->set_stats(print_stats || analysis); // enable the statistics
+                tsk->set_fast(true); // enable the fast mode (= disable the useless verifs in the tasks)
             }
 
+        if (profile)
+        {
+            profiler.reset(new tools::Profiler(*pipeline_chain));
+            profiler->start(std::chrono::microseconds(100));
+        }
+
         auto t_start = std::chrono::steady_clock::now();
-        pipeline_chain->exec();
+        if (n_replicas)
+        {
+            // process the first half of the frames with a reduced number of replicas in the stage 1, then grow back
+            // to all the replicas to process the remaining frames
+            const size_t n_frames = ((int)std::ceil((float)(filesize(in_filepath.c_str()) * 8) /
+                                                    (float)(data_length * n_inter_frames)));
+            size_t n_generated = 0;
+            pipeline_chain->set_n_active_threads(1, n_replicas);
+            pipeline_chain->exec({ [&n_generated, n_frames]() { return ++n_generated >= n_frames / 2; },
+                                   []() { return false; },
+                                   []() { return false; } });
+            pipeline_chain->set_n_active_threads(1, n_threads ? n_threads : 1);
+            // the processes of the stage are generated again while the sockets borrow the buffers of the adaptors
+            if (sub_waves) (*pipeline_chain)[1].set_sub_waves(true, 1);
+        }
+        if (!async)
+            pipeline_chain->exec();
+        else
+        {
+            // the main thread is not blocked during the execution, it only polls the end of the pipeline
+            auto handle = pipeline_chain->exec_async();
+            size_t n_polls = 0;
+            while (!handle.wait_for(std::chrono::milliseconds(1)))
+                n_polls++;
+            handle.wait();
+            std::cout << "# Number of polls during the asynchronous execution: " << n_polls << std::endl;
+        }
         std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+        if (profile) profiler->stop();
 
         auto elapsed_time = duration.count() / 1000.f / 1000.f;
         std::cout << "Sequence elapsed time: " << elapsed_time << " ms" << std::endl;
@@ -333,8 +490,90 @@ main(int argc, char** argv)
       (n_frames * (rlys.size() * sleep_time_us * 1000) * n_inter_frames) / 1000.f / 1000.f / n_threads;
     std::cout << "Sequence theoretical time: " << theoretical_time << " ms" << std::endl;
 
+    // the late frames are dropped by the stages, the output file is incomplete
+    const uint64_t n_dropped = force_sequence ? 0 : pipeline_chain->get_n_dropped();
+    if (deadline_us) std::cout << "# Number of dropped frames: " << n_dropped << std::endl;
+
     // verification of the sequence execution
-    bool tests_passed = compare_files(in_filepath, out_filepath);
+    bool tests_passed = true;
+    if (!n_dropped)
+        tests_passed = compare_files(in_filepath, out_filepath);
+    else
+    {
+        // the frames that are not dropped are written in order and each produced frame is either written or dropped
+        uint64_t n_written = 0;
+        for (auto snk : pipeline_chain->get_modules<module::Sink_user_binary<uint8_t>>(false))
+            n_written += (uint64_t)(*snk)("send_count").get_n_calls() * n_inter_frames;
+        const bool in_order =
+          data_length % CHAR_BIT == 0 && is_frames_subsequence(in_filepath, out_filepath, data_length / CHAR_BIT);
+        tests_passed = in_order && n_written + n_dropped == n_frames * n_inter_frames;
+        if (!tests_passed)
+            std::cout << "# The output file is wrong (in order = " << (in_order ? "true" : "false")
+                      << ", written frames = " << n_written << ", dropped frames = " << n_dropped
+                      << ", produced frames = " << n_frames * n_inter_frames << ")." << std::endl;
+    }
+    // each slot that is not dropped crosses the two synchronizations and leaves the pipeline once
+    if (!force_sequence && latency_tracking)
+    {
+        const auto& latency = pipeline_chain->get_latency();
+        size_t n_slots = n_frames;
+        bool latency_passed = true;
+        for (size_t s = 0; s < 2; s++)
+        {
+            n_slots -= pipeline_chain->get_n_dropped(s) / n_inter_frames;
+            latency_passed = latency_passed && pipeline_chain->get_residence(s).get_n_values() == n_slots;
+        }
+        latency_passed = latency_passed && latency.get_n_values() == n_slots && latency.get_min() <= latency.get_max();
+        if (!latency_passed)
+            std::cout << "# The number of tracked slots is wrong (expected = " << n_slots
+                      << ", end-to-end = " << latency.get_n_values() << ")." << std::endl;
+        tests_passed = tests_passed && latency_passed;
+    }
+    // each slot is pushed once in the first synchronization and pulled once from the last one
+    if (!force_sequence && synchro_telemetry)
+    {
+        uint64_t n_pushes = 0, n_pulls = 0;
+        for (auto& tlm : pipeline_chain->get_synchro_telemetry(0, true))
+            n_pushes += tlm.n_calls;
+        for (auto& tlm : pipeline_chain->get_synchro_telemetry(1, false))
+            n_pulls += tlm.n_calls;
+        const bool telemetry_passed = n_pushes == n_frames && n_pulls >= n_frames;
+        if (!telemetry_passed)
+            std::cout << "# The synchronizations telemetry is wrong (expected = " << n_frames
+                      << ", pushes = " << n_pushes << ", pulls = " << n_pulls << ")." << std::endl;
+        tests_passed = tests_passed && telemetry_passed;
+    }
+    // all the frames go through all the stages, the bottleneck has to be a valid stage
+    if (!force_sequence && analysis)
+    {
+        const auto res = pipeline_chain->analyze();
+        bool analysis_passed = res.stages.size() == 3 && res.bottleneck < 3 && res.bottleneck_what_if < 3 &&
+                               res.throughput_what_if >= res.throughput;
+        for (auto& sta : res.stages)
+            analysis_passed = analysis_passed && sta.n_frames == n_frames * n_inter_frames;
+        if (!analysis_passed)
+            std::cout << "# The analysis of the pipeline is wrong (expected frames per stage = "
+                      << n_frames * n_inter_frames << ")." << std::endl;
+        tests_passed = tests_passed && analysis_passed;
+    }
+    // each sampling round takes one sample (in a task or idle) of each replica
+    if (profile)
+    {
+        bool profile_passed = profiler->get_n_rounds() > 0;
+        for (size_t s = 0; s < profiler->get_n_stages(); s++)
+            for (size_t r = 0; r < profiler->get_n_replicas(s); r++)
+            {
+                uint64_t n_samples = profiler->get_n_idle_samples(s, r);
+                for (size_t t = 0; t < profiler->get_tasks(s, r).size(); t++)
+                    n_samples += profiler->get_n_samples(s, r, t);
+                profile_passed = profile_passed && n_samples == profiler->get_n_rounds();
+            }
+        if (!profile_passed)
+            std::cout << "# The samples of the profiler are wrong (rounds = " << profiler->get_n_rounds() << ")."
+                      << std::endl;
+        tests_passed = tests_passed && profile_passed;
+    }
+
     if (tests_passed)
         std::cout << "# " << rang::style::bold << rang::fg::green << "Tests passed!" << rang::style::reset << std::endl;
     else
@@ -358,9 +597,33 @@ main(int argc, char** argv)
                           << "# Pipeline stage " << s << " (" << n_threads << " thread(s)): " << std::endl;
                 tools::Stats::show(stages[s]->get_tasks_per_types(), true, false);
             }
+            if (latency_tracking)
+            {
+                std::cout << "#" << std::endl;
+                tools::Stats::show_latency(*pipeline_chain);
+            }
+            if (synchro_telemetry)
+            {
+                std::cout << "#" << std::endl;
+                tools::Stats::show_synchro(*pipeline_chain);
+            }
         }
     }
 
+    // display the end-of-run analysis of the pipeline (if enabled)
+    if (!force_sequence && analysis)
+    {
+        std::cout << "#" << std::endl;
+        tools::Stats::show_analysis(*pipeline_chain);
+    }
+
+    // display the sampling profile of the threads (if enabled)
+    if (profile)
+    {
+        std::cout << "#" << std::endl;
+        tools::Stats::show_profile(*profiler);
+    }
+
     // sockets unbinding
     if (force_sequence)
         sequence_chain->set_n_frames(1);
@@ -0,0 +1,223 @@
+#include <chrono>
+#include <cstdlib>
+#include <getopt.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <aff3ct-core.hpp>
+using namespace aff3ct;
+
+int
+main(int argc, char** argv)
+{
+    option longopts[] = { { "n-inter-frames", required_argument, NULL, 'f' },
+                          { "n-frames-per-wave", required_argument, NULL, 'w' },
+                          { "data-length", required_argument, NULL, 'd' },
+                          { "n-exec", required_argument, NULL, 'e' },
+                          { "print-stats", no_argument, NULL, 'p' },
+                          { "perf-counters", no_argument, NULL, 'k' },
+                          { "tsc-clock", no_argument, NULL, 'c' },
+                          { "stats-sampling", required_argument, NULL, 'n' },
+                          { "help", no_argument, NULL, 'h' },
+                          { 0 } };
+
+    size_t n_inter_frames = 1;
+    size_t n_frames_per_wave = 1;
+    size_t data_length = 1;
+    size_t n_exec = 1000000;
+    bool print_stats = false;
+    bool perf_counters = false;
+    bool tsc_clock = false;
+    uint32_t stats_sampling = 1;
+
+    while (1)
+    {
+        const int opt = getopt_long(argc, argv, "f:w:d:e:pkcn:h", longopts, 0);
+        if (opt == -1) break;
+        switch (opt)
+        {
+            case 'f':
+                n_inter_frames = atoi(optarg);
+                break;
+            case 'w':
+                n_frames_per_wave = atoi(optarg);
+                break;
+            case 'd':
+                data_length = atoi(optarg);
+                break;
+            case 'e':
+                n_exec = atoi(optarg);
+                break;
+            case 'p':
+                print_stats = true;
+                break;
+            case 'k':
+                perf_counters = true;
+                break;
+            case 'c':
+                tsc_clock = true;
+                break;
+            case 'n':
+                stats_sampling = atoi(optarg);
+                break;
+            case 'h':
+                std::cout << "usage: " << argv[0] << " [options]" << std::endl;
+                std::cout << std::endl;
+                std::cout << "  -f, --n-inter-frames     "
+                          << "Number of frames to process in one task                               "
+                          << "[" << n_inter_frames << "]" << std::endl;
+                std::cout << "  -w, --n-frames-per-wave  "
+                          << "Number of frames processed by one codelet call                        "
+                          << "[" << n_frames_per_wave << "]" << std::endl;
+                std::cout << "  -d, --data-length        "
+                          << "Size of data to process in one task (in bytes)                        "
+                          << "[" << data_length << "]" << std::endl;
+                std::cout << "  -e, --n-exec             "
+                          << "Number of task executions                                             "
+                          << "[" << n_exec << "]" << std::endl;
+                std::cout << "  -p, --print-stats        "
+                          << "Enable to print per task statistics (performance will be reduced)     "
+                          << "[" << (print_stats ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -k, --perf-counters      "
+                          << "Enable to collect the performance counters (requires '-p')            "
+                          << "[" << (perf_counters ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -c, --tsc-clock          "
+                          << "Enable to measure the statistics with the time stamp counter          "
+                          << "[" << (tsc_clock ? "true" : "false") << "]" << std::endl;
+                std::cout << "  -n, --stats-sampling     "
+                          << "Measure only one call every N calls (the totals are extrapolated)     "
+                          << "[" << stats_sampling << "]" << std::endl;
+                std::cout << "  -h, --help               "
+                          << "This help                                                             "
+                          << "[false]" << std::endl;
+                exit(0);
+                break;
+            default:
+                break;
+        }
+    }
+
+    std::cout << "##################################" << std::endl;
+    std::cout << "# Micro-benchmark: Task overhead #" << std::endl;
+    std::cout << "##################################" << std::endl;
+    std::cout << "#" << std::endl;
+
+    std::cout << "# Command line arguments:" << std::endl;
+    std::cout << "#   - n_inter_frames    = " << n_inter_frames << std::endl;
+    std::cout << "#   - n_frames_per_wave = " << n_frames_per_wave << std::endl;
+    std::cout << "#   - data_length       = " << data_length << std::endl;
+    std::cout << "#   - n_exec            = " << n_exec << std::endl;
+    std::cout << "#   - print_stats       = " << (print_stats ? "true" : "false") << std::endl;
+    std::cout << "#   - perf_counters     = " << (perf_counters ? "true" : "false") << std::endl;
+    std::cout << "#" << std::endl;
+
+    // module creation: the codelet adds 1 to each byte of the frames of the current wave
+    module::Stateless adder;
+    adder.set_name("Adder");
+    auto& task = adder.create_task("add");
+    const auto s_in = adder.create_socket_in<uint8_t>(task, "in", data_length);
+    const auto s_out = adder.create_socket_out<uint8_t>(task, "out", data_length);
+    adder.create_codelet(task,
+                         [s_in, s_out, data_length](module::Module& m, runtime::Task& t, const size_t frame_id) -> int
+                         {
+                             const uint8_t* in = t[s_in].get_dataptr<const uint8_t>();
+                             uint8_t* out = t[s_out].get_dataptr<uint8_t>();
+                             for (size_t i = 0; i < m.get_n_frames_per_wave() * data_length; i++)
+                                 out[i] = in[i] + 1;
+                             return runtime::status_t::SUCCESS;
+                         });
+    adder.set_n_frames(n_inter_frames);
+    adder.set_n_frames_per_wave(n_frames_per_wave);
+
+    std::vector<uint8_t> in_data(n_inter_frames * data_length);
+    for (size_t f = 0; f < n_inter_frames; f++)
+        std::fill(in_data.begin() + f * data_length, in_data.begin() + (f + 1) * data_length, (uint8_t)(f * 3));
+    task[s_in] = in_data;
+
+    task.set_fast(true);
+    task.set_stats(print_stats);
+    task.set_perf(perf_counters);
+    task.set_stats_clock(tsc_clock ? tools::clock_source_t::TSC : tools::clock_source_t::STEADY);
+    task.set_stats_sampling(stats_sampling);
+
+    auto t_start = std::chrono::steady_clock::now();
+    for (size_t e = 0; e < n_exec; e++)
+        task.exec();
+    std::chrono::nanoseconds duration = std::chrono::steady_clock::now() - t_start;
+
+    std::cout << "Task elapsed time: " << duration.count() / 1000.f / 1000.f << " ms" << std::endl;
+    std::cout << "Task average time per call: " << (float)duration.count() / (float)n_exec << " ns" << std::endl;
+
+    // verification of the task execution: first on all the waves, then frame by frame
+    bool tests_passed = true;
+    auto check = [&](const std::string& mode)
+    {
+        const uint8_t* out = task[s_out].get_dataptr<const uint8_t>();
+        for (size_t f = 0; f < n_inter_frames; f++)
+            for (size_t d = 0; d < data_length; d++)
+            {
+                const uint8_t expected = (uint8_t)(f * 3 + 1);
+                if (out[f * data_length + d] != expected)
+                {
+                    std::cout << "# expected = " << +expected << " - obtained = " << +out[f * data_length + d]
+                              << " (mode = " << mode << ", f = " << f << ", d = " << d << ")" << std::endl;
+                    tests_passed = false;
+                }
+            }
+        for (auto s : task.get_status())
+            if (s != runtime::status_t::SUCCESS && s != runtime::status_t::UNKNOWN) tests_passed = false;
+    };
+    check("all frames");
+
+    uint8_t* out = task[s_out].get_dataptr<uint8_t>();
+    std::fill(out, out + n_inter_frames * data_length, 0);
+    for (size_t f = 0; f < n_inter_frames; f++)
+        task.exec((int)f);
+    check("frame by frame");
+
+    // with the sampling, only a part of the calls is measured but the total duration is extrapolated to all the calls
+    if (print_stats)
+    {
+        const uint32_t n_calls = (uint32_t)(n_exec + n_inter_frames);
+        const uint32_t n_sampled_calls = (n_calls + stats_sampling - 1) / stats_sampling;
+        if (task.get_n_calls() != n_calls || task.get_n_sampled_calls() != n_sampled_calls ||
+            task.get_duration_total().count() <= 0)
+        {
+            std::cout << "# wrong statistics (n_calls = " << task.get_n_calls()
+                      << ", n_sampled_calls = " << task.get_n_sampled_calls()
+                      << ", duration_total = " << task.get_duration_total().count() << " ns)" << std::endl;
+            tests_passed = false;
+        }
+    }
+
+    // the counters are accumulated when at least one event (hardware or software) can be opened on this system
+    if (print_stats && perf_counters)
+    {
+        uint64_t perf_total = 0;
+        for (size_t e = 0; e < tools::perf_n_events; e++)
+            perf_total += task.get_perf_total()[e];
+        const bool available = tools::perf_counters_is_available(tools::perf_event_t::CYCLES) ||
+                               tools::perf_counters_is_available(tools::perf_event_t::TASK_CLOCK);
+        if (available && perf_total == 0)
+        {
+            std::cout << "# the performance counters have not been accumulated" << std::endl;
+            tests_passed = false;
+        }
+    }
+
+    if (tests_passed)
+        std::cout << "# " << rang::style::bold << rang::fg::green << "Tests passed!" << rang::style::reset << std::endl;
+    else
+        std::cout << "# " << rang::style::bold << rang::fg::red << "Tests failed :-(" << rang::style::reset
+                  << std::endl;
+
+    // display the statistics of the task (if enabled)
+    if (print_stats)
+    {
+        std::cout << "#" << std::endl;
+        tools::Stats::show(std::vector<module::Module*>{ &adder }, true, false);
+    }
+
+    return !tests_passed;
+}